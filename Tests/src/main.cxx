@@ -15,6 +15,7 @@
 #include "testsMemory.hpp" // Include the header for memory tests
 #include "testsBase.hpp" // Include the header for SGL tests
 #include "testsBitmap.hpp" // Include the header for bitmap tests
+#include "testsVDP1.hpp" // Include the header for VDP1 tests
 #include "testsMemoryHWRam.hpp" // Include the header for memory HWRam tests
 #include "testsMemoryLWRam.hpp" // Include the header for memory LWRam tests
 #include "testsMemoryCartRam.hpp" // Include the header for memory Cart Ram tests
@@ -93,6 +94,9 @@ int main()
     MU_RUN_SUITE(bitmap_test_suite); // Add the bitmap test suite
     MU_DISPLAY_SATURN(bitmap_test_suite);
 
+    MU_RUN_SUITE(vdp1_test_suite); // Add the VDP1 test suite
+    MU_DISPLAY_SATURN(vdp1_test_suite);
+
     MU_RUN_SUITE(memory_HWRam_test_suite); // Add the memory HWRam test suite
     MU_DISPLAY_SATURN(memory_HWRam_test_suite);
 
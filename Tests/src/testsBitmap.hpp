@@ -3,6 +3,11 @@
 #include "srl_bitmap.hpp"
 #include "srl_color.hpp"
 
+extern "C"
+{
+    #include <sega_tim.h>
+}
+
 // https://github.com/siu/minunit
 #include "minunit.h"
 
@@ -210,6 +215,328 @@ extern "C"
         mu_assert(returnedInfo.ColorMode == mockInfo.ColorMode, buffer);
     }
 
+    /**
+     * @brief Decode small TGA images with known pixels
+     *
+     * 24 bit image stored bottom to top and 32 bit image stored top to bottom are compared against fixed expected colors,
+     * fully transparent black pixel of 32 bit image must become transparent color.
+     */
+    MU_TEST(tga_test_decode_pixels)
+    {
+        // 4x2 uncompressed true color, 24 bits per pixel, origin at bottom left, pixels are stored as BGR
+        uint8_t bottomLeft[18 + (4 * 2 * 3)] = {
+            0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 2, 0, 24, 0x00,
+            0x00, 0x00, 0x00,   0x80, 0x80, 0x80,   0x00, 0xff, 0xff,   0x56, 0x34, 0x12,
+            0x00, 0x00, 0xff,   0x00, 0xff, 0x00,   0xff, 0x00, 0x00,   0xff, 0xff, 0xff
+        };
+
+        // Red, green, blue, white on top row, black, gray, yellow and 0x123456 on bottom row
+        const uint16_t bottomLeftPixels[4 * 2] = {
+            0x801f, 0x83e0, 0xfc00, 0xffff,
+            0x8000, 0xc210, 0x83ff, 0xa8c2
+        };
+
+        // 2x2 uncompressed true color, 32 bits per pixel, origin at top left, pixels are stored as BGRA
+        uint8_t topLeft[18 + (2 * 2 * 4)] = {
+            0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 32, 0x20,
+            0x00, 0x00, 0x00, 0x00,   0x00, 0x00, 0xff, 0xff,
+            0x00, 0x00, 0x00, 0xff,   0x56, 0x34, 0x12, 0x00
+        };
+
+        // Transparent, red, black and 0x123456 (only black pixel becomes transparent)
+        const uint16_t topLeftPixels[2 * 2] = { 0x0000, 0x801f, 0x8000, 0xa8c2 };
+
+        SRL::Bitmap::TGA bottomLeftImage(bottomLeft, sizeof(bottomLeft));
+        SRL::Bitmap::TGA topLeftImage(topLeft, sizeof(topLeft));
+
+        snprintf(buffer, buffer_size, "TGA decode failed");
+        mu_assert(bottomLeftImage.GetData() != nullptr && topLeftImage.GetData() != nullptr, buffer);
+
+        for (int32_t pixel = 0; pixel < 4 * 2; pixel++)
+        {
+            const uint16_t color = reinterpret_cast<uint16_t*>(bottomLeftImage.GetData())[pixel];
+            snprintf(buffer, buffer_size, "24 bit TGA pixel %d is %04x, expected %04x", pixel, color, bottomLeftPixels[pixel]);
+            mu_assert(color == bottomLeftPixels[pixel], buffer);
+        }
+
+        for (int32_t pixel = 0; pixel < 2 * 2; pixel++)
+        {
+            const uint16_t color = reinterpret_cast<uint16_t*>(topLeftImage.GetData())[pixel];
+            snprintf(buffer, buffer_size, "32 bit TGA pixel %d is %04x, expected %04x", pixel, color, topLeftPixels[pixel]);
+            mu_assert(color == topLeftPixels[pixel], buffer);
+        }
+    }
+
+    /**
+     * @brief Reference decoder of true color TGA
+     *
+     * Decodes pixel by pixel the way TGA loader did before it got row decoders,
+     * depth is checked and location is computed for every pixel.
+     * @param stream Whole TGA file
+     * @param output Decoded pixels, top row first
+     */
+    void bitmap_reference_decode(uint8_t* stream, SRL::Types::HighColor* output)
+    {
+        const uint16_t width = stream[12] | (stream[13] << 8);
+        const uint16_t height = stream[14] | (stream[15] << 8);
+        const uint8_t depth = stream[16] >> 3;
+        const bool rle = stream[2] == 10;
+        const bool topLeft = (stream[17] & 0x20) != 0;
+        uint8_t* data = stream + 18 + stream[0];
+        int32_t xLocation = 0;
+        int32_t yLocation = topLeft ? 0 : height - 1;
+        int32_t repeat = 0;
+        bool packed = false;
+
+        for (uint32_t index = 0; index < (uint32_t)(width * height); index++)
+        {
+            if (rle && repeat == 0)
+            {
+                packed = (*data & 0x80) != 0;
+                repeat = (*data++ & 0x7f) + 1;
+            }
+
+            SRL::Types::HighColor color;
+
+            switch (depth)
+            {
+            case 2:
+                color = SRL::Types::HighColor::FromARGB15(SRL::Endian::DeserializeUint16(data));
+                break;
+
+            case 3:
+                color = SRL::Types::HighColor::FromRGB24(SRL::Endian::DeserializeUint24(data));
+                break;
+
+            default:
+                color = SRL::Types::HighColor::FromARGB32(SRL::Endian::DeserializeUint32(data));
+                break;
+            }
+
+            // Color of run length packet is stored only once
+            if (!rle || !packed || repeat == 1)
+            {
+                data += depth;
+            }
+
+            repeat--;
+            output[(yLocation * width) + xLocation] = color;
+            xLocation++;
+
+            if (xLocation == width)
+            {
+                xLocation = 0;
+                yLocation += topLeft ? 1 : -1;
+            }
+        }
+    }
+
+    /**
+     * @brief Benchmark TGA row decoders against per-pixel reference decoder
+     *
+     * TGA_UT.TGA is decoded from memory by both decoders, which must produce the same pixels.
+     * Decode times are only logged, they are measured by free running timer at 1/32 of system clock, which wraps every ~78ms.
+     */
+    MU_TEST(tga_test_decode_benchmark)
+    {
+        SRL::Cd::File file("TGA_UT.TGA");
+
+        snprintf(buffer, buffer_size, "File 'TGA_UT.TGA' not found");
+        mu_assert(file.Exists(), buffer);
+
+        uint8_t* stream = new uint8_t[file.Size.Bytes];
+        int32_t read = file.LoadBytes(0, file.Size.Bytes, stream);
+
+        snprintf(buffer, buffer_size, "File 'TGA_UT.TGA' : read %d bytes of %d", read, file.Size.Bytes);
+        mu_assert(read == file.Size.Bytes, buffer);
+
+        SRL::Types::HighColor* expected = new SRL::Types::HighColor[64 * 48];
+
+        TIM_FRT_INIT(TIM_CKS_32);
+        uint16_t start = TIM_FRT_GET_16();
+        bitmap_reference_decode(stream, expected);
+        const uint16_t before = TIM_FRT_GET_16() - start;
+
+        start = TIM_FRT_GET_16();
+        SRL::Bitmap::TGA image(stream, read);
+        const uint16_t after = TIM_FRT_GET_16() - start;
+
+        LogDebug("TGA 64x48x24 RLE decode: %uus per pixel, %uus by rows", (uint32_t)TIM_FRT_CNT_TO_MCR(before), (uint32_t)TIM_FRT_CNT_TO_MCR(after));
+
+        snprintf(buffer, buffer_size, "TGA decode failed");
+        mu_assert(image.GetData() != nullptr && image.GetInfo().Width == 64 && image.GetInfo().Height == 48, buffer);
+
+        int32_t mismatch = 0;
+        uint16_t* pixels = reinterpret_cast<uint16_t*>(image.GetData());
+
+        while (mismatch < 64 * 48 && pixels[mismatch] == (uint16_t)expected[mismatch])
+        {
+            mismatch++;
+        }
+
+        snprintf(buffer, buffer_size, "TGA row decoder differs at pixel %d", mismatch);
+        mu_assert(mismatch == 64 * 48, buffer);
+
+        delete[] expected;
+        delete[] stream;
+    }
+
+    /**
+     * @brief Decode TGA while streaming it from CD
+     *
+     * TGA_UT.TGA is 64x48 run length encoded 24 bit image (5952 bytes), so its packets span several read chunks.
+     * Image streamed from the file must be the same as image decoded from the whole file loaded into memory.
+     */
+    MU_TEST(tga_test_stream_decode)
+    {
+        SRL::Cd::File file("TGA_UT.TGA");
+
+        snprintf(buffer, buffer_size, "File 'TGA_UT.TGA' not found");
+        mu_assert(file.Exists(), buffer);
+
+        uint8_t* stream = new uint8_t[file.Size.Bytes];
+        int32_t read = file.LoadBytes(0, file.Size.Bytes, stream);
+
+        snprintf(buffer, buffer_size, "File 'TGA_UT.TGA' : read %d bytes of %d", read, file.Size.Bytes);
+        mu_assert(read == file.Size.Bytes, buffer);
+
+        SRL::Bitmap::TGA expected(stream, read);
+        SRL::Bitmap::TGA image(&file);
+
+        snprintf(buffer, buffer_size, "TGA stream decode failed");
+        mu_assert(image.GetData() != nullptr && image.GetInfo().Width == 64 && image.GetInfo().Height == 48, buffer);
+
+        snprintf(buffer, buffer_size, "TGA stream decode left file open");
+        mu_assert(!file.IsOpen(), buffer);
+
+        int32_t mismatch = 0;
+        uint16_t* pixels = reinterpret_cast<uint16_t*>(image.GetData());
+        uint16_t* expectedPixels = reinterpret_cast<uint16_t*>(expected.GetData());
+
+        while (mismatch < 64 * 48 && pixels[mismatch] == expectedPixels[mismatch])
+        {
+            mismatch++;
+        }
+
+        snprintf(buffer, buffer_size, "TGA stream decode differs at pixel %d", mismatch);
+        mu_assert(mismatch == 64 * 48, buffer);
+
+        delete[] stream;
+    }
+
+    /**
+     * @brief Decode TGA straight into VDP1 texture and VDP2 style cells
+     *
+     * Texture in VRAM must hold the same pixels as image decoded into its own buffer,
+     * cells must hold 8x8 blocks of the image going left to right, top to bottom.
+     */
+    MU_TEST(tga_test_decode_target)
+    {
+        SRL::Bitmap::TGA expected("TGA_UT.TGA");
+        uint16_t* expectedPixels = reinterpret_cast<uint16_t*>(expected.GetData());
+
+        snprintf(buffer, buffer_size, "TGA decode failed");
+        mu_assert(expectedPixels != nullptr, buffer);
+
+        SRL::VDP1::TextureTarget texture;
+        SRL::Bitmap::TGA image("TGA_UT.TGA", &texture);
+
+        snprintf(buffer, buffer_size, "TGA decode into texture failed: id %d", texture.GetId());
+        mu_assert(texture.GetId() >= 0 && image.GetData() == nullptr, buffer);
+
+        int32_t mismatch = 0;
+        uint16_t* pixels = reinterpret_cast<uint16_t*>(SRL::VDP1::Textures[texture.GetId()].GetData());
+
+        while (mismatch < 64 * 48 && pixels[mismatch] == expectedPixels[mismatch])
+        {
+            mismatch++;
+        }
+
+        SRL::VDP1::FreeTexture(texture.GetId());
+
+        snprintf(buffer, buffer_size, "TGA texture differs at pixel %d", mismatch);
+        mu_assert(mismatch == 64 * 48, buffer);
+
+        uint16_t* cells = new uint16_t[64 * 48];
+        SRL::Tilemap::Interfaces::CellTarget cellTarget(cells, 64 * 48 * 2);
+        SRL::Bitmap::TGA tiles("TGA_UT.TGA", &cellTarget);
+
+        snprintf(buffer, buffer_size, "TGA decode into cells failed: %d cells", cellTarget.GetCellCount());
+        mu_assert(cellTarget.GetCellCount() == (64 / 8) * (48 / 8), buffer);
+
+        for (mismatch = 0; mismatch < 64 * 48; mismatch++)
+        {
+            // Cell index, line in the cell and pixel in the line
+            const int32_t cell = mismatch >> 6;
+            const int32_t x = ((cell % 8) << 3) + (mismatch & 7);
+            const int32_t y = ((cell / 8) << 3) + ((mismatch >> 3) & 7);
+
+            if (cells[mismatch] != expectedPixels[(y * 64) + x])
+            {
+                break;
+            }
+        }
+
+        delete[] cells;
+
+        snprintf(buffer, buffer_size, "TGA cells differ at pixel %d", mismatch);
+        mu_assert(mismatch == 64 * 48, buffer);
+    }
+
+    /**
+     * @brief Load native texture into memory and into VDP1 texture
+     *
+     * File was created by: srl_texture.py TGA_UT.TGA SRT_UT.SRT --compress
+     * Texture must hold the same pixels as TGA_UT.TGA decoded by TGA loader.
+     */
+    MU_TEST(srt_test_load)
+    {
+        SRL::Bitmap::TGA expected("TGA_UT.TGA");
+        uint16_t* expectedPixels = reinterpret_cast<uint16_t*>(expected.GetData());
+
+        snprintf(buffer, buffer_size, "TGA decode failed");
+        mu_assert(expectedPixels != nullptr, buffer);
+
+        SRL::Bitmap::SRT image("SRT_UT.SRT");
+
+        snprintf(buffer, buffer_size, "SRT load failed");
+        mu_assert(image.GetData() != nullptr &&
+            image.GetInfo().Width == 64 &&
+            image.GetInfo().Height == 48 &&
+            image.GetInfo().ColorMode == SRL::CRAM::TextureColorMode::RGB555 &&
+            image.GetHeader().IsCompressed(), buffer);
+
+        int32_t mismatch = 0;
+        uint16_t* pixels = reinterpret_cast<uint16_t*>(image.GetData());
+
+        while (mismatch < 64 * 48 && pixels[mismatch] == expectedPixels[mismatch])
+        {
+            mismatch++;
+        }
+
+        snprintf(buffer, buffer_size, "SRT differs at pixel %d", mismatch);
+        mu_assert(mismatch == 64 * 48, buffer);
+
+        SRL::VDP1::TextureTarget texture;
+        SRL::Bitmap::SRT loaded("SRT_UT.SRT", &texture);
+
+        snprintf(buffer, buffer_size, "SRT load into texture failed: id %d", texture.GetId());
+        mu_assert(texture.GetId() >= 0 && loaded.GetData() == nullptr, buffer);
+
+        pixels = reinterpret_cast<uint16_t*>(SRL::VDP1::Textures[texture.GetId()].GetData());
+        mismatch = 0;
+
+        while (mismatch < 64 * 48 && pixels[mismatch] == expectedPixels[mismatch])
+        {
+            mismatch++;
+        }
+
+        SRL::VDP1::FreeTexture(texture.GetId());
+
+        snprintf(buffer, buffer_size, "SRT texture differs at pixel %d", mismatch);
+        mu_assert(mismatch == 64 * 48, buffer);
+    }
+
     /**
      * @brief bitmap test suite configuration and test case registration
      *
@@ -231,5 +558,10 @@ extern "C"
         MU_RUN_TEST(bitmap_info_test_initialization_with_palette);
         MU_RUN_TEST(ibitmap_test_get_data);
         MU_RUN_TEST(ibitmap_test_get_info);
+        MU_RUN_TEST(tga_test_decode_pixels);
+        MU_RUN_TEST(tga_test_decode_benchmark);
+        MU_RUN_TEST(tga_test_stream_decode);
+        MU_RUN_TEST(tga_test_decode_target);
+        MU_RUN_TEST(srt_test_load);
     }
 }
@@ -296,6 +296,509 @@ extern "C"
         mu_assert(!isopen, buffer);
     }
 
+    // Counts completion events raised by asynchronous reads
+    static int32_t cd_test_async_completed = 0;
+
+    // Completion handler for asynchronous read test
+    static void cd_test_async_handler(SRL::Cd::ReadRequest* request)
+    {
+        cd_test_async_completed++;
+    }
+
+    // Test: Verify that a file can be read asynchronously and completion event is raised.
+    MU_TEST(cd_test_read_file_async)
+    {
+        const char *filename = "CD_UT.TXT";
+
+        SRL::Cd::File file(filename);
+
+        // Destination must be able to hold whole sectors
+        uint8_t* sectorBuffer = new uint8_t[2048];
+        SRL::Memory::MemSet(sectorBuffer, '\0', 2048);
+
+        // Read must not start on closed file
+        SRL::Cd::ReadRequest* request = file.ReadAsync(file.Size.Bytes, sectorBuffer);
+        snprintf(buffer, buffer_size, "File '%s' : ReadAsync started on closed file", filename);
+        mu_assert(request == nullptr, buffer);
+
+        bool open = file.Open();
+        snprintf(buffer, buffer_size, "File '%s' does not open but should", filename);
+        mu_assert(open, buffer);
+
+        cd_test_async_completed = 0;
+        request = file.ReadAsync(file.Size.Bytes, sectorBuffer);
+        snprintf(buffer, buffer_size, "File '%s' : ReadAsync did not start", filename);
+        mu_assert(request != nullptr, buffer);
+
+        request->OnCompleted += cd_test_async_handler;
+
+        // Only one request per file is allowed
+        SRL::Cd::ReadRequest* second = file.ReadAsync(file.Size.Bytes, sectorBuffer);
+        snprintf(buffer, buffer_size, "File '%s' : second ReadAsync started while first is pending", filename);
+        mu_assert(second == nullptr, buffer);
+
+        bool completed = request->Wait();
+        snprintf(buffer, buffer_size, "File '%s' : ReadAsync failed", filename);
+        mu_assert(completed, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : completion event raised %d times", filename, cd_test_async_completed);
+        mu_assert(cd_test_async_completed == 1, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : ReadAsync returned %d bytes", filename, request->GetBytesRead());
+        mu_assert(request->GetBytesRead() == file.Size.Bytes, buffer);
+
+        int cmp = strncmp("UT1", reinterpret_cast<char*>(sectorBuffer), 3);
+        snprintf(buffer, buffer_size, "File '%s' : ReadAsync did not return expected data", filename);
+        mu_assert(cmp == 0, buffer);
+
+        request->Release();
+        snprintf(buffer, buffer_size, "File '%s' : request was not released", filename);
+        mu_assert(request->GetStatus() == SRL::Cd::ReadRequest::Status::Free, buffer);
+
+        delete[] sectorBuffer;
+    }
+
+    // Test: Verify read-ahead buffer returns correct data across sector bounds and seeks.
+    MU_TEST(cd_test_read_ahead)
+    {
+        const char *dirname = "ROOT";
+        const char *filename = "TESTFILE.UTS";
+
+        SRL::Cd::ChangeDir(dirname);
+        Cd::File file(filename);
+
+        // Invalid configurations are rejected
+        snprintf(buffer, buffer_size, "File '%s' : read-ahead of 0 sectors accepted", filename);
+        mu_assert(!file.SetReadAhead(0), buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : read-ahead in frame arena accepted", filename);
+        mu_assert(!file.SetReadAhead(4, Memory::Zone::Frame), buffer);
+
+        bool configured = file.SetReadAhead(3, Memory::Zone::LWRam);
+        snprintf(buffer, buffer_size, "File '%s' : read-ahead was not set", filename);
+        mu_assert(configured && file.GetReadAheadSectors() == 3, buffer);
+
+        bool open = file.Open();
+        snprintf(buffer, buffer_size, "File '%s' does not open but should", filename);
+        mu_assert(open, buffer);
+
+        // File contains repeating sequence of 0-255, offsets are picked to cross sector and ring bounds
+        static const int32_t steps[][2] = { {0, 700}, {700, 2000}, {600, 300}, {10000, 7000}, {9000, 100}, {300000, 5000} };
+        uint8_t* data = new uint8_t[7000];
+
+        for (auto step : steps)
+        {
+            int32_t position = file.Seek(step[0]);
+            snprintf(buffer, buffer_size, "File '%s' : seek to %d failed", filename, step[0]);
+            mu_assert(position == step[0], buffer);
+
+            int32_t read = file.Read(step[1], data);
+            snprintf(buffer, buffer_size, "File '%s' : read %d bytes at %d, expected %d", filename, read, step[0], step[1]);
+            mu_assert(read == step[1], buffer);
+
+            int32_t mismatch = 0;
+
+            while (mismatch < read && data[mismatch] == static_cast<uint8_t>(step[0] + mismatch))
+            {
+                mismatch++;
+            }
+
+            snprintf(buffer, buffer_size, "File '%s' : wrong byte at %d", filename, step[0] + mismatch);
+            mu_assert(mismatch == read, buffer);
+        }
+
+        delete[] data;
+    }
+
+    // Test: Verify reads of whole sectors into aligned and unaligned destinations return correct data.
+    MU_TEST(cd_test_read_direct)
+    {
+        const char *dirname = "ROOT";
+        const char *filename = "TESTFILE.UTS";
+
+        SRL::Cd::ChangeDir(dirname);
+        Cd::File file(filename);
+
+        bool open = file.Open();
+        snprintf(buffer, buffer_size, "File '%s' does not open but should", filename);
+        mu_assert(open, buffer);
+
+        // Aligned start goes straight to the destination, unaligned ones mix buffered head and tail with direct sectors
+        static const int32_t steps[][3] = { {2048, 8192, 0}, {4096, 6244, 1}, {700, 9000, 0}, {20480, 4096, 2}, {1000, 100, 0} };
+        uint8_t* data = new uint8_t[9004];
+
+        for (auto step : steps)
+        {
+            uint8_t* target = data + step[2];
+            file.Seek(step[0]);
+
+            int32_t read = file.Read(step[1], target);
+            snprintf(buffer, buffer_size, "File '%s' : read %d bytes at %d, expected %d", filename, read, step[0], step[1]);
+            mu_assert(read == step[1], buffer);
+
+            int32_t mismatch = 0;
+
+            while (mismatch < read && target[mismatch] == static_cast<uint8_t>(step[0] + mismatch))
+            {
+                mismatch++;
+            }
+
+            snprintf(buffer, buffer_size, "File '%s' : wrong byte at %d", filename, step[0] + mismatch);
+            mu_assert(mismatch == read, buffer);
+
+            snprintf(buffer, buffer_size, "File '%s' : position %d after read, expected %d", filename, file.GetCurrentPosition(), step[0] + step[1]);
+            mu_assert(file.GetCurrentPosition() == static_cast<size_t>(step[0] + step[1]), buffer);
+        }
+
+        delete[] data;
+    }
+
+    // Test: Verify assets can be found and read from packed archive.
+    MU_TEST(cd_test_archive)
+    {
+        const char *filename = "ARCH_UT.PAK";
+
+        // Archive was created by: srl_pack.py ARCH_UT.PAK ALPHA.TXT PATTERN.BIN OMEGA.TXT
+        SRL::Cd::Archive archive(filename);
+
+        snprintf(buffer, buffer_size, "Archive '%s' did not open", filename);
+        mu_assert(archive.IsOpen(), buffer);
+
+        snprintf(buffer, buffer_size, "Archive '%s' has %d assets, expected 3", filename, archive.GetEntryCount());
+        mu_assert(archive.GetEntryCount() == 3, buffer);
+
+        int32_t index = archive.Find("pattern.bin");
+        snprintf(buffer, buffer_size, "Archive '%s' : PATTERN.BIN found at %d", filename, index);
+        mu_assert(index == 1, buffer);
+
+        index = archive.Find("MISSING.BIN");
+        snprintf(buffer, buffer_size, "Archive '%s' : missing asset found at %d", filename, index);
+        mu_assert(index == -1, buffer);
+
+        char text[16];
+        SRL::Memory::MemSet(text, '\0', sizeof(text));
+
+        SRL::Cd::Archive::View view = archive.Open("ALPHA.TXT");
+        int32_t read = view.Read(sizeof(text), text);
+        snprintf(buffer, buffer_size, "Archive '%s' : ALPHA.TXT read %d bytes '%s'", filename, read, text);
+        mu_assert(read == 6 && strncmp(text, "ALPHA\n", 6) == 0 && view.IsEOF(), buffer);
+
+        // Views keep their own position
+        SRL::Cd::Archive::View pattern = archive.Open(1);
+        uint8_t tail[16];
+        pattern.Seek(2990);
+        read = pattern.Read(sizeof(tail), tail);
+        snprintf(buffer, buffer_size, "Archive '%s' : PATTERN.BIN tail read %d bytes", filename, read);
+        mu_assert(read == 10 && tail[0] == 2990 % 251 && tail[9] == 2999 % 251, buffer);
+
+        // Whole archive in one read
+        int32_t size = archive.GetRangeSize(0, 3);
+        uint8_t* data = new uint8_t[size];
+        read = archive.LoadRange(0, 3, data);
+        snprintf(buffer, buffer_size, "Archive '%s' : range read %d of %d bytes", filename, read, size);
+        mu_assert(read == size, buffer);
+
+        const char* omega = reinterpret_cast<const char*>(data + archive.GetEntry(2)->Offset);
+        snprintf(buffer, buffer_size, "Archive '%s' : OMEGA.TXT not found in range", filename);
+        mu_assert(strncmp(omega, "OMEGA\n", 6) == 0, buffer);
+
+        delete[] data;
+
+        SRL::Cd::Archive::View missing = archive.Open("MISSING.BIN");
+        snprintf(buffer, buffer_size, "Archive '%s' : view of missing asset is open", filename);
+        mu_assert(!missing.IsOpen() && missing.Read(1, text) < 0, buffer);
+    }
+
+    // Test: Verify compressed file is streamed from disc and decompressed correctly.
+    MU_TEST(cd_test_lz_load)
+    {
+        const char *filename = "LZ_UT.LZ";
+
+        // File was created by: srl_lz.py LZ_UT.BIN LZ_UT.LZ, where byte N of LZ_UT.BIN is ((N * N) >> 3) % 251
+        SRL::Cd::File file(filename);
+
+        int32_t size = SRL::Lz::GetSize(&file);
+        snprintf(buffer, buffer_size, "File '%s' : decompressed size is %d, expected 5000", filename, size);
+        mu_assert(size == 5000, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : GetSize left file open", filename);
+        mu_assert(!file.IsOpen(), buffer);
+
+        uint8_t* data = new uint8_t[size];
+        int32_t loaded = SRL::Lz::Load(&file, data, size);
+        snprintf(buffer, buffer_size, "File '%s' : decompressed %d bytes", filename, loaded);
+        mu_assert(loaded == size, buffer);
+
+        int32_t mismatch = 0;
+
+        while (mismatch < size && data[mismatch] == ((mismatch * mismatch) >> 3) % 251)
+        {
+            mismatch++;
+        }
+
+        snprintf(buffer, buffer_size, "File '%s' : wrong byte at %d", filename, mismatch);
+        mu_assert(mismatch == size, buffer);
+
+        // Too small destination is refused
+        loaded = SRL::Lz::Load(&file, data, size - 1);
+        snprintf(buffer, buffer_size, "File '%s' : decompressed %d bytes into too small buffer", filename, loaded);
+        mu_assert(loaded < 0, buffer);
+
+        // Uncompressed file is detected
+        SRL::Cd::File plain("CD_UT.TXT");
+        snprintf(buffer, buffer_size, "File 'CD_UT.TXT' : detected as compressed");
+        mu_assert(SRL::Lz::GetSize(&plain) < 0, buffer);
+
+        delete[] data;
+    }
+
+    // Files in order their queued reads completed
+    static SRL::Cd::File* cd_test_queue_order[3];
+    static int32_t cd_test_queue_completed = 0;
+
+    // Completion handler for read queue test
+    static void cd_test_queue_handler(SRL::Cd::ReadRequest* request)
+    {
+        if (cd_test_queue_completed < 3)
+        {
+            cd_test_queue_order[cd_test_queue_completed] = request->GetFile();
+        }
+
+        cd_test_queue_completed++;
+    }
+
+    // Test: Verify queued reads of closed files complete in priority order and report latency.
+    MU_TEST(cd_test_read_queue)
+    {
+        const char *names[] = {"LZ_UT.LZ", "ARCH_UT.PAK", "CD_UT.TXT"};
+        const char *magic[] = {"SRLZ", "SRLA", "UT1"};
+        const SRL::Cd::ReadRequest::Priority priorities[] = {
+            SRL::Cd::ReadRequest::Priority::Normal,
+            SRL::Cd::ReadRequest::Priority::Normal,
+            SRL::Cd::ReadRequest::Priority::High };
+
+        SRL::Cd::File* files[3];
+        SRL::Cd::ReadRequest* requests[3];
+        uint8_t* data[3];
+        cd_test_queue_completed = 0;
+
+        for (int32_t index = 0; index < 3; index++)
+        {
+            files[index] = new SRL::Cd::File(names[index]);
+            data[index] = new uint8_t[2048];
+            SRL::Memory::MemSet(data[index], '\0', 2048);
+
+            // Files stay closed, scheduler opens them only while reading
+            requests[index] = files[index]->QueueRead(16, data[index], priorities[index]);
+            snprintf(buffer, buffer_size, "File '%s' : read was not queued", names[index]);
+            mu_assert(requests[index] != nullptr && requests[index]->GetStatus() == SRL::Cd::ReadRequest::Status::Queued, buffer);
+
+            requests[index]->OnCompleted += cd_test_queue_handler;
+        }
+
+        snprintf(buffer, buffer_size, "File '%s' : second read queued while first is pending", names[0]);
+        mu_assert(files[0]->QueueRead(16, data[0]) == nullptr, buffer);
+
+        for (int32_t index = 0; index < 3; index++)
+        {
+            bool completed = requests[index]->Wait();
+            snprintf(buffer, buffer_size, "File '%s' : queued read failed", names[index]);
+            mu_assert(completed, buffer);
+
+            snprintf(buffer, buffer_size, "File '%s' : file left open after queued read", names[index]);
+            mu_assert(!files[index]->IsOpen(), buffer);
+
+            int cmp = strncmp(magic[index], reinterpret_cast<char*>(data[index]), strlen(magic[index]));
+            snprintf(buffer, buffer_size, "File '%s' : queued read did not return expected data", names[index]);
+            mu_assert(cmp == 0, buffer);
+
+            snprintf(buffer, buffer_size, "File '%s' : latency %d is shorter than queue time %d", names[index], requests[index]->GetLatency(), requests[index]->GetQueueTime());
+            mu_assert(requests[index]->GetLatency() >= requests[index]->GetQueueTime(), buffer);
+        }
+
+        snprintf(buffer, buffer_size, "File '%s' : high priority read did not complete first", names[2]);
+        mu_assert(cd_test_queue_completed == 3 && cd_test_queue_order[0] == files[2], buffer);
+
+        for (int32_t index = 0; index < 3; index++)
+        {
+            requests[index]->Release();
+            delete files[index];
+            delete[] data[index];
+        }
+    }
+
+    // Bytes delivered by the stream test
+    static int32_t cd_test_stream_received = 0;
+    static char cd_test_stream_start[4];
+
+    // Data handler for stream test
+    static void cd_test_stream_handler(uint8_t channel, const uint8_t* data, int32_t size)
+    {
+        if (cd_test_stream_received == 0 && size >= 3)
+        {
+            SRL::Memory::MemCopy(cd_test_stream_start, data, 3);
+        }
+
+        cd_test_stream_received += size;
+    }
+
+    // Test: Verify plain file can be played as a single channel stream.
+    MU_TEST(cd_test_stream)
+    {
+        const char *filename = "CD_UT.TXT";
+
+        SRL::Cd::Stream missing("NOFILE.BIN");
+        snprintf(buffer, buffer_size, "File 'NOFILE.BIN' : stream channel added");
+        mu_assert(missing.AddChannel(SRL::Cd::Stream::AnyChannel, 1) < 0, buffer);
+
+        SRL::Cd::Stream stream(filename);
+        snprintf(buffer, buffer_size, "File '%s' : stream without channels started", filename);
+        mu_assert(!stream.Start(), buffer);
+
+        int8_t channel = stream.AddChannel(SRL::Cd::Stream::AnyChannel, 2);
+        snprintf(buffer, buffer_size, "File '%s' : stream channel was not added", filename);
+        mu_assert(channel == 0, buffer);
+
+        cd_test_stream_received = 0;
+        SRL::Memory::MemSet(cd_test_stream_start, '\0', sizeof(cd_test_stream_start));
+        stream.OnData += cd_test_stream_handler;
+
+        snprintf(buffer, buffer_size, "File '%s' : stream did not start", filename);
+        mu_assert(stream.Start() && stream.IsPlaying(), buffer);
+
+        for (int32_t update = 0; update < 100000 && !stream.IsComplete(); update++)
+        {
+            stream.Update();
+        }
+
+        SRL::Cd::File file(filename);
+        snprintf(buffer, buffer_size, "File '%s' : stream delivered %d bytes", filename, cd_test_stream_received);
+        mu_assert(stream.IsComplete() && cd_test_stream_received >= file.Size.Bytes, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : stream did not deliver expected data", filename);
+        mu_assert(strncmp("UT1", cd_test_stream_start, 3) == 0, buffer);
+
+        stream.Close();
+        snprintf(buffer, buffer_size, "File '%s' : stream plays after close", filename);
+        mu_assert(!stream.IsPlaying(), buffer);
+    }
+
+    // Test: Verify loader pipeline loads raw and compressed data and textures, and reports missing files.
+    MU_TEST(cd_test_loader)
+    {
+        uint8_t* data = new uint8_t[5000];
+        SRL::Loader::Asset manifest[] = {
+            SRL::Loader::Asset::Data("CD_UT.TXT"),
+            SRL::Loader::Asset::Data("LZ_UT.LZ", data, 5000),
+            SRL::Loader::Asset::Data("NOFILE.BIN"),
+            SRL::Loader::Asset::Texture("TGA_UT.TGA"),
+            SRL::Loader::Asset::Texture("SRT_UT.SRT")
+        };
+
+        SRL::Loader loader(manifest, 5);
+        const bool loaded = loader.Load();
+
+        snprintf(buffer, buffer_size, "Loader : %d assets failed, expected 1", loader.GetFailedCount());
+        mu_assert(!loaded && loader.GetFailedCount() == 1, buffer);
+
+        snprintf(buffer, buffer_size, "Loader : finished %d assets, progress %d%%", loader.GetFinishedCount(), loader.GetProgress());
+        mu_assert(loader.IsDone() && loader.GetFinishedCount() == 5 && loader.GetProgress() == 100, buffer);
+
+        SRL::Cd::File file("CD_UT.TXT");
+        snprintf(buffer, buffer_size, "File 'CD_UT.TXT' : loaded %d bytes", manifest[0].Result);
+        mu_assert(manifest[0].Result == file.Size.Bytes && manifest[0].Destination != nullptr, buffer);
+        mu_assert(strncmp("UT1", (const char*)manifest[0].Destination, 3) == 0, "File 'CD_UT.TXT' : wrong data loaded");
+
+        // Same content as in cd_test_lz_load
+        int32_t mismatch = 0;
+
+        while (mismatch < 5000 && data[mismatch] == ((mismatch * mismatch) >> 3) % 251)
+        {
+            mismatch++;
+        }
+
+        snprintf(buffer, buffer_size, "File 'LZ_UT.LZ' : loaded %d bytes, wrong byte at %d", manifest[1].Result, mismatch);
+        mu_assert(manifest[1].Result == 5000 && mismatch == 5000, buffer);
+
+        snprintf(buffer, buffer_size, "File 'NOFILE.BIN' : loaded");
+        mu_assert(manifest[2].Result < 0 && manifest[2].Destination == nullptr, buffer);
+
+        // TGA is decoded and native texture decompressed on slave, both straight into VDP1 texture
+        for (int32_t index = 3; index < 5; index++)
+        {
+            const int32_t texture = manifest[index].Result;
+            snprintf(buffer, buffer_size, "File '%s' : texture %d", manifest[index].Name, texture);
+            mu_assert(texture >= 0 && VDP1::Textures[texture].Width == 64 && VDP1::Textures[texture].Height == 48, buffer);
+            VDP1::FreeTexture(texture);
+        }
+
+        delete[] reinterpret_cast<uint8_t*>(manifest[0].Destination);
+        delete[] data;
+    }
+
+#if defined(SRL_CD_PROFILER)
+    // Test: Verify profiler accounts bytes, sectors and seeks of a plain file read.
+    MU_TEST(cd_test_profiler)
+    {
+        const char *filename = "CD_UT.TXT";
+        char content[64];
+
+        SRL::Cd::Profiler::Reset();
+
+        SRL::Cd::File file(filename);
+        int32_t size = SRL::Math::Min<int32_t>(file.Size.Bytes, sizeof(content));
+        snprintf(buffer, buffer_size, "File '%s' : read failed", filename);
+        mu_assert(file.Open() && file.Read(size, content) == size, buffer);
+        file.Close();
+
+        const SRL::Cd::Profiler::Stats& totals = SRL::Cd::Profiler::GetTotals();
+        snprintf(buffer, buffer_size, "File '%s' : profiler counted %uB, %u sct, %u seek", filename, totals.BytesRead, totals.SectorsRead, totals.Seeks);
+        mu_assert(totals.BytesRead == (uint32_t)size && totals.SectorsRead >= 1 && totals.Seeks >= 1 && totals.Failures == 0, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : read operation was not profiled", filename);
+        mu_assert(SRL::Cd::Profiler::GetOperationStats(SRL::Cd::Profiler::Operation::Read).Calls >= 1, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : missing from profiler file list", filename);
+        mu_assert(SRL::Cd::Profiler::GetFileCount() >= 1 &&
+            strncmp(filename, SRL::Cd::Profiler::GetFileStats((uint8_t)0).Name, strlen(filename)) == 0, buffer);
+    }
+#endif
+
+    // Test: Verify hashed file name index matches GFS and survives switching directories.
+    MU_TEST(cd_test_file_id_index)
+    {
+        const char *names[] = {"FILE.TXT", "FILE1.TXT", "FILE2.TXT", "OVERFLOW.TXT", "TESTFILE.UTS"};
+
+        SRL::Cd::ChangeDir("ROOT");
+
+        for (const char *name : names)
+        {
+            int32_t identifier = SRL::Cd::GetFileId(name);
+            int32_t expected = GFS_NameToId((int8_t *)name);
+            snprintf(buffer, buffer_size, "File '%s' : identifier %d, GFS has %d", name, identifier, expected);
+            mu_assert(identifier >= 0 && identifier == expected, buffer);
+        }
+
+        snprintf(buffer, buffer_size, "File 'NOFILE.BIN' : found in index");
+        mu_assert(SRL::Cd::GetFileId("NOFILE.BIN") < 0, buffer);
+
+        int32_t identifier = SRL::Cd::GetFileId("TESTFILE.UTS");
+
+        // Root and then back, second visit is served from the cached index
+        SRL::Cd::ChangeDir(static_cast<const char*>(nullptr));
+        snprintf(buffer, buffer_size, "File 'CD_UT.TXT' : not found after returning to root");
+        mu_assert(SRL::Cd::GetFileId("CD_UT.TXT") == GFS_NameToId((int8_t *)"CD_UT.TXT"), buffer);
+
+        SRL::Cd::ChangeDir("ROOT");
+        snprintf(buffer, buffer_size, "File 'TESTFILE.UTS' : identifier changed after revisiting directory");
+        mu_assert(SRL::Cd::GetFileId("TESTFILE.UTS") == identifier, buffer);
+
+        SRL::Cd::File file("TESTFILE.UTS");
+        uint8_t data[4];
+        snprintf(buffer, buffer_size, "File 'TESTFILE.UTS' : cannot be read after revisiting directory");
+        mu_assert(file.Open() && file.Seek(5) == 5 && file.Read(4, data) == 4 && data[0] == 5 && data[3] == 8, buffer);
+    }
+
     // Test: Verify seeking to the beginning of a file.
     MU_TEST(cd_file_seek_test_beginning)
     {
@@ -522,6 +1025,18 @@ extern "C"
         MU_RUN_TEST(cd_test_read_file2);
         MU_RUN_TEST(cd_test_null_file);
         MU_RUN_TEST(cd_test_missing_file);
+        MU_RUN_TEST(cd_test_read_file_async);
+        MU_RUN_TEST(cd_test_read_ahead);
+        MU_RUN_TEST(cd_test_read_direct);
+        MU_RUN_TEST(cd_test_archive);
+        MU_RUN_TEST(cd_test_lz_load);
+        MU_RUN_TEST(cd_test_file_id_index);
+        MU_RUN_TEST(cd_test_read_queue);
+        MU_RUN_TEST(cd_test_stream);
+        MU_RUN_TEST(cd_test_loader);
+#if defined(SRL_CD_PROFILER)
+        MU_RUN_TEST(cd_test_profiler);
+#endif
         MU_RUN_TEST(cd_file_seek_test_beginning);
         MU_RUN_TEST(cd_file_seek_test_offset);
         MU_RUN_TEST(cd_file_seek_test_relative);
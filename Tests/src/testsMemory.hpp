@@ -289,6 +289,442 @@ extern "C"
         delete[] srcPtr;
     }
 
+    /**
+     * @brief Test frame arena allocation and swapping
+     *
+     * Verifies that frame arena allocations are served from the current half,
+     * survive one swap and are reset after the second swap.
+     */
+    MU_TEST(memory_test_frame_arena)
+    {
+        size_t freeSpaceBefore = Memory::HighWorkRam::GetFreeSpace();
+        mu_assert(Memory::FrameArena::Initialize(1024), "Frame arena initialization failed");
+
+        char* first = framenew char[100];
+        mu_assert(first != nullptr, "Frame arena allocation failed");
+        mu_assert(Memory::FrameArena::InRange(first), "Frame arena allocation is outside of the arena");
+        mu_assert(Memory::FrameArena::GetUsedSpace() == 100, "Frame arena used space is wrong");
+
+        // Deleting arena memory must not touch the work RAM heap
+        delete[] first;
+        mu_assert(Memory::FrameArena::GetUsedSpace() == 100, "Frame arena memory was freed");
+
+        Memory::FrameArena::Swap();
+        char* second = framenew char[100];
+        mu_assert(second != nullptr && second != first, "Frame arena did not switch halves");
+
+        Memory::FrameArena::Swap();
+        char* third = framenew char[100];
+        mu_assert(third == first, "Frame arena half was not reset");
+
+        mu_assert(framenew char[2048] == nullptr, "Frame arena overflow did not return nullptr");
+
+        Memory::FrameArena::Release();
+        mu_assert(Memory::HighWorkRam::GetFreeSpace() == freeSpaceBefore, "Frame arena memory was not released");
+    }
+
+    /**
+     * @brief Test object pool acquire, release, handle validation and iteration
+     */
+    MU_TEST(memory_test_pool)
+    {
+        struct PoolItem
+        {
+            int32_t Value;
+            int32_t Padding;
+
+            PoolItem(int32_t value) : Value(value), Padding(0) { }
+        };
+
+        size_t freeSpaceBefore = Memory::LowWorkRam::GetFreeSpace();
+
+        {
+            Memory::Pool<PoolItem, 4, Memory::Zone::LWRam> pool;
+            mu_assert(pool.IsValid(), "Pool storage allocation failed");
+            mu_assert(Memory::LowWorkRam::GetFreeSpace() < freeSpaceBefore, "Pool storage was not allocated in the requested zone");
+
+            auto first = pool.Acquire(1);
+            auto second = pool.Acquire(2);
+            auto third = pool.Acquire(3);
+            auto fourth = pool.Acquire(4);
+            mu_assert(!first.IsNull() && !second.IsNull() && !third.IsNull() && !fourth.IsNull(), "Pool acquire failed");
+            mu_assert(pool.Acquire(5).IsNull(), "Full pool did not return null handle");
+            mu_assert(pool.Get(third)->Value == 3, "Pool object has wrong value");
+
+            mu_assert(pool.Release(second), "Pool release failed");
+            mu_assert(!pool.Release(second), "Pool released the same object twice");
+            mu_assert(pool.Get(second) == nullptr, "Stale handle still points to an object");
+
+            // Released slot is reused, but the old handle must stay invalid
+            auto reused = pool.Acquire(6);
+            mu_assert(reused.Index == second.Index, "Pool did not reuse released slot");
+            mu_assert(pool.Get(second) == nullptr, "Stale handle points to reused slot");
+            mu_assert(pool.Get(reused)->Value == 6, "Reused slot has wrong value");
+
+            pool.Release(first);
+
+            int32_t sum = 0;
+            size_t visited = 0;
+
+            for (PoolItem& item : pool)
+            {
+                sum += item.Value;
+                visited++;
+            }
+
+            mu_assert(visited == 3 && sum == 13, "Pool iteration visited wrong objects");
+            mu_assert(pool.GetCount() == 3 && pool.GetPeakCount() == 4, "Pool counters are wrong");
+
+            Memory::Report report = pool.GetReport();
+            mu_assert(report.UsedBlocks == 3 && report.FreeBlocks == 1, "Pool report is wrong");
+        }
+
+        mu_assert(Memory::LowWorkRam::GetFreeSpace() == freeSpaceBefore, "Pool storage was not released");
+    }
+
+    /**
+     * @brief Test word accelerated fill and copy with all source and destination alignments
+     */
+    MU_TEST(memory_test_memset_memcopy)
+    {
+        uint8_t source[80];
+        uint8_t destination[80];
+
+        for (size_t index = 0; index < sizeof(source); index++)
+        {
+            source[index] = static_cast<uint8_t>(index + 1);
+        }
+
+        for (size_t sourceOffset = 0; sourceOffset < 4; sourceOffset++)
+        {
+            for (size_t destinationOffset = 0; destinationOffset < 4; destinationOffset++)
+            {
+                const size_t length = 61;
+
+                Memory::MemSet(destination, 0xaa, sizeof(destination));
+                Memory::MemCopy(destination + destinationOffset, source + sourceOffset, length);
+
+                for (size_t index = 0; index < sizeof(destination); index++)
+                {
+                    const bool copied = index >= destinationOffset && index < destinationOffset + length;
+                    const uint8_t expected = copied ? source[index - destinationOffset + sourceOffset] : 0xaa;
+
+                    snprintf(buffer, buffer_size, "MemCopy failed at %d (offsets %d, %d)", index, sourceOffset, destinationOffset);
+                    mu_assert(destination[index] == expected, buffer);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Test asynchronous DMA copy on both channels
+     */
+    MU_TEST(memory_test_dma_copy)
+    {
+        const size_t length = 1024;
+        uint32_t* source = new uint32_t[length / sizeof(uint32_t)];
+        uint32_t* destination = new uint32_t[length / sizeof(uint32_t)];
+        uint32_t* lowDestination = lwnew uint32_t[length / sizeof(uint32_t)];
+
+        for (size_t index = 0; index < length / sizeof(uint32_t); index++)
+        {
+            source[index] = index * 0x01010101;
+        }
+
+        // DMA bypasses cache, read results through cache-through mirror
+        volatile uint32_t* result = reinterpret_cast<volatile uint32_t*>(reinterpret_cast<uint32_t>(destination) | 0x20000000);
+        volatile uint32_t* lowResult = reinterpret_cast<volatile uint32_t*>(reinterpret_cast<uint32_t>(lowDestination) | 0x20000000);
+
+        Memory::Dma::Channel channel = Memory::Dma::Copy(destination, source, length, Memory::Dma::Channel::Cpu);
+        Memory::Dma::Wait(channel);
+        mu_assert(Memory::Dma::IsFinished(channel), "CPU DMA did not finish");
+
+        // SCU DMA cannot access low work RAM, it must fall back to CPU DMA
+        channel = Memory::Dma::Copy(lowDestination, source, length, Memory::Dma::Channel::Scu);
+        mu_assert(channel == Memory::Dma::Channel::Cpu, "SCU DMA to low work RAM did not fall back to CPU DMA");
+        Memory::Dma::Wait(channel);
+
+        for (size_t index = 0; index < length / sizeof(uint32_t); index++)
+        {
+            mu_assert(result[index] == source[index], "CPU DMA copy failed");
+            mu_assert(lowResult[index] == source[index], "SCU DMA fallback copy failed");
+        }
+
+        delete[] source;
+        delete[] destination;
+        delete[] lowDestination;
+    }
+
+    /**
+     * @brief Test cartridge RAM detection and per-bank heaps
+     *
+     * Runs with or without RAM cartridge, checks that detection results and heaps agree with each other.
+     */
+    MU_TEST(memory_test_cart_detection)
+    {
+        Memory::CartRam::CartType type = Memory::CartRam::GetType();
+
+        if (type == Memory::CartRam::CartType::None)
+        {
+            mu_assert(Memory::CartRam::GetSize() == 0, "Cart RAM size reported without cartridge");
+            mu_assert(Memory::Malloc(16, Memory::Zone::CartRam) == nullptr, "Cart RAM allocation succeeded without cartridge");
+            return;
+        }
+
+        const size_t bankSize = type == Memory::CartRam::CartType::Ram4MB ? 0x200000 : 0x80000;
+        size_t total = 0;
+        void* blocks[Memory::CartRam::BankCount];
+
+        for (uint8_t bank = 0; bank < Memory::CartRam::BankCount; bank++)
+        {
+            snprintf(buffer, buffer_size, "Cart RAM bank %d has %d bytes, expected %d", bank, Memory::CartRam::GetBankSize(bank), bankSize);
+            mu_assert(Memory::CartRam::GetBankSize(bank) == bankSize, buffer);
+
+            Memory::Report report = Memory::CartRam::GetBankReport(bank);
+            snprintf(buffer, buffer_size, "Cart RAM bank %d heap is %d bytes", bank, report.TotalSize);
+            mu_assert(report.TotalSize > 0 && report.TotalSize <= bankSize, buffer);
+            total += report.TotalSize;
+        }
+
+        mu_assert(Memory::CartRam::GetReport().TotalSize == total, "Cart RAM report does not match its banks");
+
+        // Allocation larger than half of the bank cannot fit twice into single bank
+        for (uint8_t bank = 0; bank < Memory::CartRam::BankCount; bank++)
+        {
+            blocks[bank] = Memory::Malloc(bankSize / 2 + 16, Memory::Zone::CartRam);
+            mu_assert(blocks[bank] != nullptr, "Cart RAM allocation failed");
+            mu_assert(Memory::CartRam::InRange(blocks[bank]), "Cart RAM allocation is out of range");
+
+            // Memory must be usable
+            Memory::MemSet(blocks[bank], 0xa5, bankSize / 2 + 16);
+            mu_assert(reinterpret_cast<uint8_t*>(blocks[bank])[bankSize / 2] == 0xa5, "Cart RAM is not writable");
+        }
+
+        mu_assert(Memory::CartRam::GetBankReport(0).UsedBlocks == 1 && Memory::CartRam::GetBankReport(1).UsedBlocks == 1,
+            "Cart RAM allocations were not spread over both banks");
+
+        for (void* block : blocks)
+        {
+            Memory::Free(block);
+        }
+
+        mu_assert(Memory::CartRam::GetReport().UsedBlocks == 0, "Cart RAM allocations were not freed");
+    }
+
+    /**
+     * @brief Test reallocation through zone API, shrinking and growing must keep block content
+     * @details Simple allocator must also grow blocks in place, so vector-style growth does not copy the block on every step
+     */
+    MU_TEST(memory_test_realloc)
+    {
+        const size_t usedBlocks = Memory::HighWorkRam::GetReport().UsedBlocks;
+
+        uint8_t* block = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Malloc(64));
+        mu_assert(block != nullptr, "Allocation failed");
+        Memory::MemSet(block, 0x5a, 64);
+
+        // Shrinking never moves the block
+        mu_assert(Memory::HighWorkRam::Realloc(block, 16) == block, "Shrinking moved the block");
+
+#if !defined(USE_SEGREGATED_ALLOCATOR) && !defined(USE_TLSF_ALLOCATOR)
+        // Growing back takes the split off tail again
+        mu_assert(Memory::HighWorkRam::Realloc(block, 64) == block, "Growing into split off space moved the block");
+#endif
+
+        // Growing may move the block, but content must stay
+        block = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Realloc(block, 64));
+        mu_assert(block != nullptr && block[0] == 0x5a && block[15] == 0x5a, "Block content changed while growing");
+
+        block = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Realloc(block, 2048));
+        mu_assert(block != nullptr && block[0] == 0x5a && block[15] == 0x5a, "Block content changed while moving");
+
+        // Vector-style growth
+        size_t moves = 0;
+
+        for (size_t size = 2064; size <= 4096; size += 16)
+        {
+            uint8_t* grown = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Realloc(block, size));
+            mu_assert(grown != nullptr && grown[0] == 0x5a && grown[15] == 0x5a, "Vector-style growth failed");
+            moves += grown != block ? 1 : 0;
+            block = grown;
+        }
+
+#if !defined(USE_SEGREGATED_ALLOCATOR) && !defined(USE_TLSF_ALLOCATOR)
+        // Simple allocator grows into free space behind the block instead of copying it
+        snprintf(buffer, buffer_size, "Vector-style growth moved the block %d times", moves);
+        mu_assert(moves == 0, buffer);
+#endif
+
+        // Failed reallocation keeps the block
+        mu_assert(Memory::HighWorkRam::Realloc(block, Memory::HighWorkRam::GetFreeSpace() + 4096) == nullptr, "Oversized reallocation succeeded");
+        mu_assert(block[0] == 0x5a && block[15] == 0x5a, "Failed reallocation damaged the block");
+
+        Memory::HighWorkRam::Free(block);
+
+        snprintf(buffer, buffer_size, "Reallocated blocks were not freed: %d used, %d expected", Memory::HighWorkRam::GetReport().UsedBlocks, usedBlocks);
+        mu_assert(Memory::HighWorkRam::GetReport().UsedBlocks == usedBlocks, buffer);
+    }
+
+    /**
+     * @brief Test allocation class placement policy spilling over to other zone
+     */
+    MU_TEST(memory_test_spill_policy)
+    {
+        const Memory::Zone frameOnly[] = { Memory::Zone::Frame };
+        mu_assert(!Memory::Placement::SetPolicy(Memory::AllocationClass::Bulk, frameOnly, 1), "Frame arena accepted in placement policy");
+        mu_assert(!Memory::Placement::SetPolicy(Memory::AllocationClass::Bulk, frameOnly, 0), "Empty placement policy accepted");
+
+        // Request more than the smaller of work RAM zones can give, the other zone must take it
+        size_t hwLargest = Memory::GetReport(Memory::Zone::HWRam).LargestFreeSize;
+        size_t lwLargest = Memory::GetReport(Memory::Zone::LWRam).LargestFreeSize;
+        Memory::Zone small = hwLargest < lwLargest ? Memory::Zone::HWRam : Memory::Zone::LWRam;
+        Memory::Zone large = hwLargest < lwLargest ? Memory::Zone::LWRam : Memory::Zone::HWRam;
+        size_t size = (hwLargest < lwLargest ? hwLargest : lwLargest) + 64;
+
+        if ((hwLargest < lwLargest ? lwLargest : hwLargest) < size + 1024)
+        {
+            return;
+        }
+
+        Memory::Placement::ResetStats();
+        mu_assert(Memory::Placement::SetPolicy(Memory::AllocationClass::Bulk, { small, large }), "Placement policy was not set");
+        mu_assert(Memory::Placement::GetPolicy(Memory::AllocationClass::Bulk).Count == 2, "Placement policy has wrong zone count");
+
+        uint8_t* spilled = bulknew uint8_t[size];
+        mu_assert(spilled != nullptr, "Bulk allocation did not spill over");
+        mu_assert(large == Memory::Zone::HWRam ? Memory::HighWorkRam::InRange(spilled) : Memory::LowWorkRam::InRange(spilled), "Bulk allocation spilled into wrong zone");
+
+        const Memory::Placement::Stats& stats = Memory::Placement::GetStats(Memory::AllocationClass::Bulk);
+        snprintf(buffer, buffer_size, "Spill counters are %d allocations, %d spills, %d bytes", stats.Allocations, stats.Spills, stats.SpilledBytes);
+        mu_assert(stats.Allocations == 1 && stats.Spills == 1 && stats.SpilledBytes == size && stats.Failures == 0, buffer);
+        delete[] spilled;
+
+        // Same request must fail when policy does not allow spilling
+        mu_assert(Memory::Placement::SetPolicy(Memory::AllocationClass::Bulk, { small }), "Placement policy was not set");
+        mu_assert(Memory::Malloc(size, Memory::AllocationClass::Bulk) == nullptr, "Allocation spilled outside of placement policy");
+        mu_assert(stats.Allocations == 2 && stats.Spills == 1 && stats.Failures == 1, "Failed allocation was not counted");
+
+        // Restore default policy
+        Memory::Placement::SetPolicy(Memory::AllocationClass::Bulk, { Memory::Zone::HWRam, Memory::Zone::LWRam, Memory::Zone::CartRam });
+        Memory::Placement::ResetStats();
+    }
+
+    /**
+     * @brief Test movable heap compaction around locked block
+     */
+    MU_TEST(memory_test_movable_heap)
+    {
+        const size_t blockSize = 4096;
+        const uint8_t kept[] = { 0, 2, 4, 5 };
+        Memory::MovableHeap::Handle handles[6];
+
+        if (!Memory::MovableHeap::IsInitialized())
+        {
+            mu_assert(Memory::MovableHeap::Initialize(28 * 1024), "Movable heap was not allocated");
+        }
+
+        mu_assert(Memory::MovableHeap::GetUsedSpace() == 0, "Movable heap is not empty");
+
+        for (uint8_t block = 0; block < 6; block++)
+        {
+            handles[block] = Memory::MovableHeap::Malloc(blockSize);
+            mu_assert(handles[block] != Memory::MovableHeap::InvalidHandle, "Movable block allocation failed");
+
+            Memory::MemSet(Memory::MovableHeap::Lock(handles[block]), block + 1, blockSize);
+            Memory::MovableHeap::Unlock(handles[block]);
+        }
+
+        // Leave two holes, neither is large enough for 8KB block on its own
+        Memory::MovableHeap::Free(handles[1]);
+        Memory::MovableHeap::Free(handles[3]);
+        mu_assert(Memory::MovableHeap::GetReport().LargestFreeSize < blockSize * 2, "Movable heap is not fragmented");
+
+        uint8_t* pinned = reinterpret_cast<uint8_t*>(Memory::MovableHeap::Lock(handles[4]));
+        Memory::MovableHeap::Handle large = Memory::MovableHeap::Malloc(blockSize * 2);
+        mu_assert(large != Memory::MovableHeap::InvalidHandle, "Movable heap was not compacted for large block");
+        mu_assert(Memory::MovableHeap::Lock(handles[4]) == pinned, "Locked block was moved");
+        Memory::MovableHeap::Unlock(handles[4]);
+        Memory::MovableHeap::Unlock(handles[4]);
+
+        // Large block reuses handle table entry of the first freed block, its old handle must not reach it
+        mu_assert(large.Index == handles[1].Index && !Memory::MovableHeap::IsValid(handles[1]), "Freed handle is still valid");
+        mu_assert(Memory::MovableHeap::Lock(handles[1]) == nullptr, "Freed handle locked reused block");
+
+        // Moved blocks must keep their data
+        for (uint8_t block : kept)
+        {
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(Memory::MovableHeap::Lock(handles[block]));
+            size_t mismatch = 0;
+
+            while (mismatch < blockSize && data[mismatch] == block + 1)
+            {
+                mismatch++;
+            }
+
+            Memory::MovableHeap::Unlock(handles[block]);
+            snprintf(buffer, buffer_size, "Movable block %d corrupted at byte %d", block, mismatch);
+            mu_assert(mismatch == blockSize, buffer);
+            Memory::MovableHeap::Free(handles[block]);
+        }
+
+        Memory::MovableHeap::Free(large);
+        mu_assert(Memory::MovableHeap::GetUsedSpace() == 0, "Movable heap was not freed");
+        mu_assert(Memory::MovableHeap::GetReport().FreeBlocks == 1, "Free movable blocks were not merged");
+    }
+
+#if defined(SRL_MEMORY_PROFILER)
+    /**
+     * @brief Test allocation profiler tag and zone accounting
+     */
+    MU_TEST(memory_test_profiler)
+    {
+        const char* tagName = "UtProfiler";
+        size_t hwBytesBefore = Memory::Profiler::GetZoneStats(Memory::Zone::HWRam).Bytes;
+        size_t lwBytesBefore = Memory::Profiler::GetZoneStats(Memory::Zone::LWRam).Bytes;
+        void* first;
+        void* second;
+
+        {
+            Memory::Profiler::Scope scope(tagName);
+            first = Memory::Malloc(100, Memory::Zone::HWRam);
+            second = Memory::Malloc(50, Memory::Zone::LWRam);
+        }
+
+        mu_assert(first != nullptr && second != nullptr, "Memory allocation failed");
+
+        size_t tag = 0;
+
+        for (size_t index = 0; index < Memory::Profiler::GetTagCount(); index++)
+        {
+            if (Memory::Profiler::GetTagStats(index).Name == tagName)
+            {
+                tag = index;
+            }
+        }
+
+        mu_assert(tag != 0, "Profiler tag was not registered");
+        mu_assert(Memory::Profiler::GetTagStats(tag).Bytes == 150, "Profiler tag bytes are wrong");
+        mu_assert(Memory::Profiler::GetTagStats(tag).Blocks == 2, "Profiler tag blocks are wrong");
+        mu_assert(Memory::Profiler::GetZoneStats(Memory::Zone::HWRam).Bytes == hwBytesBefore + 100, "Profiler HWRAM bytes are wrong");
+        mu_assert(Memory::Profiler::GetZoneStats(Memory::Zone::LWRam).Bytes == lwBytesBefore + 50, "Profiler LWRAM bytes are wrong");
+
+        // Reallocation keeps the original tag even outside of the scope
+        second = Memory::LowWorkRam::Realloc(second, 80);
+        mu_assert(second != nullptr, "Memory reallocation failed");
+        mu_assert(Memory::Profiler::GetTagStats(tag).Bytes == 180, "Profiler did not track reallocation");
+
+        Memory::Profiler::EndFrame();
+        mu_assert(Memory::Profiler::GetZoneStats(Memory::Zone::HWRam).FrameAllocations >= 1, "Profiler frame counter is wrong");
+
+        Memory::Free(first);
+        Memory::Free(second);
+        mu_assert(Memory::Profiler::GetTagStats(tag).Bytes == 0, "Profiler did not track free");
+        mu_assert(Memory::Profiler::GetTagStats(tag).PeakBytes == 180, "Profiler peak is wrong");
+        mu_assert(Memory::Profiler::GetZoneStats(Memory::Zone::HWRam).Bytes == hwBytesBefore, "Profiler HWRAM bytes were not restored");
+        mu_assert(Memory::Profiler::GetFragmentation(Memory::Zone::HWRam) <= 100, "Profiler fragmentation is out of range");
+    }
+#endif
+
     /**
      * @brief Memory test suite configuration and test case registration
      *
@@ -314,5 +750,16 @@ extern "C"
         MU_RUN_TEST(memory_test_move_memory_blocks_various_sizes); // Register the new test case
         MU_RUN_TEST(memory_test_move_memory_blocks_edge_cases); // Register the new test case
         MU_RUN_TEST(memory_test_move_memory_blocks_invalid_pointers); // Register the new test case
+        MU_RUN_TEST(memory_test_frame_arena);
+        MU_RUN_TEST(memory_test_pool);
+        MU_RUN_TEST(memory_test_memset_memcopy);
+        MU_RUN_TEST(memory_test_dma_copy);
+        MU_RUN_TEST(memory_test_cart_detection);
+        MU_RUN_TEST(memory_test_realloc);
+        MU_RUN_TEST(memory_test_spill_policy);
+        MU_RUN_TEST(memory_test_movable_heap);
+#if defined(SRL_MEMORY_PROFILER)
+        MU_RUN_TEST(memory_test_profiler);
+#endif
     }
 }
@@ -629,6 +629,62 @@ extern "C"
         mu_assert(final_free_space == initial_free_space, buffer);
     }
 
+    /**
+     * @brief Test allocator report consistency
+     *
+     * Verifies that the report of the selected allocator backend tracks used blocks
+     * and agrees with the free space query.
+     */
+    MU_TEST(memory_HWRam_test_report_consistency)
+    {
+        Memory::Report before = Memory::HighWorkRam::GetReport();
+        mu_assert(before.FreeSize == Memory::HighWorkRam::GetFreeSpace(), "Report free size does not match free space");
+        mu_assert(before.TotalSize == Memory::HighWorkRam::GetSize(), "Report total size does not match zone size");
+
+        void *ptr = Memory::HighWorkRam::Malloc(256);
+        mu_assert(ptr != nullptr, "Memory allocation failed");
+
+        Memory::Report during = Memory::HighWorkRam::GetReport();
+        mu_assert(during.UsedBlocks == before.UsedBlocks + 1, "Report did not count the used block");
+        mu_assert(during.FreeSize + 256 <= before.FreeSize, "Report free size did not shrink");
+
+        Memory::HighWorkRam::Free(ptr);
+
+        Memory::Report after = Memory::HighWorkRam::GetReport();
+        mu_assert(after.UsedBlocks == before.UsedBlocks, "Report did not count the freed block");
+        mu_assert(after.FreeSize == before.FreeSize, "Report free size was not restored");
+    }
+
+#if defined(USE_SEGREGATED_ALLOCATOR) || defined(USE_TLSF_ALLOCATOR)
+    /**
+     * @brief Test merging of free blocks on both sides
+     *
+     * Verifies that a freed block surrounded by free blocks is merged with both of them,
+     * so the zone ends up in the same state as before the allocations.
+     */
+    MU_TEST(memory_HWRam_test_coalescing)
+    {
+        Memory::Report before = Memory::HighWorkRam::GetReport();
+
+        void *ptr1 = Memory::HighWorkRam::Malloc(100);
+        void *ptr2 = Memory::HighWorkRam::Malloc(200);
+        void *ptr3 = Memory::HighWorkRam::Malloc(300);
+        mu_assert(ptr1 != nullptr && ptr2 != nullptr && ptr3 != nullptr, "Memory allocation failed");
+
+        // Middle block is freed last, it has free blocks on both sides
+        Memory::HighWorkRam::Free(ptr1);
+        Memory::HighWorkRam::Free(ptr3);
+        Memory::HighWorkRam::Free(ptr2);
+
+        Memory::Report after = Memory::HighWorkRam::GetReport();
+
+        snprintf(buffer, buffer_size,
+                 "Free blocks were not merged : %d blocks before vs %d after", before.FreeBlocks, after.FreeBlocks);
+        mu_assert(after.FreeBlocks == before.FreeBlocks, buffer);
+        mu_assert(after.FreeSize == before.FreeSize, "Free space was not restored");
+    }
+#endif
+
     /**
      * @brief Memory test suite configuration and test case registration
      *
@@ -656,6 +712,7 @@ extern "C"
         MU_RUN_TEST(memory_HWRam_test_get_used_space);
         MU_RUN_TEST(memory_HWRam_test_get_size);
         MU_RUN_TEST(memory_HWRam_test_get_report_hwram);
+        MU_RUN_TEST(memory_HWRam_test_report_consistency);
         MU_RUN_TEST(memory_HWRam_test_highworkram_get_free_space);
         MU_RUN_TEST(memory_HWRam_test_highworkram_get_used_space);
         MU_RUN_TEST(memory_HWRam_test_highworkram_get_size);
@@ -673,6 +730,9 @@ extern "C"
         MU_RUN_TEST(memory_HWRam_test_fragmentation);
         MU_RUN_TEST(memory_HWRam_test_boundary_conditions);
         MU_RUN_TEST(memory_HWRam_test_deplete_highworkram);
+#if defined(USE_SEGREGATED_ALLOCATOR) || defined(USE_TLSF_ALLOCATOR)
+        MU_RUN_TEST(memory_HWRam_test_coalescing);
+#endif
 
         // 5. Stress and Performance Tests
         MU_RUN_TEST(memory_HWRam_test_stress);
@@ -0,0 +1,137 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+#include "srl_vdp1.hpp"
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+
+    /**
+     * @brief Set up routine for VDP1 unit tests
+     *
+     * This function is called before each test in the VDP1 test suite.
+     * Every test starts with empty texture heap.
+     */
+    void vdp1_test_setup(void)
+    {
+        VDP1::ResetTextureHeap();
+    }
+
+    /**
+     * @brief Tear down routine for VDP1 unit tests
+     *
+     * This function is called after each test in the VDP1 test suite.
+     * Textures allocated by the test are released.
+     */
+    void vdp1_test_teardown(void)
+    {
+        VDP1::ResetTextureHeap();
+    }
+
+    /**
+     * @brief Output header for test suite error reporting
+     *
+     * This function is called on the first test failure to print
+     * a header indicating that VDP1 unit test errors have occurred.
+     * It increments a global error counter to ensure the header
+     * is printed only once per test suite run.
+     */
+    void vdp1_test_output_header(void)
+    {
+        // Print error header only on the first test failure
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_VDP1****");
+            }
+            else
+            {
+                LogInfo("****UT_VDP1_ERROR(S)****");
+            }
+        }
+    }
+
+    /**
+     * @brief Free texture in the middle of the heap
+     *
+     * Other textures must keep their indexes and VRAM, freed index and memory must be reused by the next texture that fits.
+     */
+    MU_TEST(vdp1_test_free_texture)
+    {
+        const int32_t first = VDP1::TryAllocateTexture(64, 48, CRAM::TextureColorMode::RGB555, 0);
+        const int32_t second = VDP1::TryAllocateTexture(32, 32, CRAM::TextureColorMode::Paletted16, 0);
+        const int32_t third = VDP1::TryAllocateTexture(16, 16, CRAM::TextureColorMode::Paletted256, 0);
+
+        snprintf(buffer, buffer_size, "Texture allocation failed: %d %d %d", first, second, third);
+        mu_assert(first == 0 && second == 1 && third == 2 && VDP1::GetTextureCount() == 3, buffer);
+
+        const uint16_t secondAddress = VDP1::Textures[second].Address;
+        const uint16_t thirdAddress = VDP1::Textures[third].Address;
+        VDP1::FreeTexture(second);
+
+        snprintf(buffer, buffer_size, "Free texture failed: count %d", VDP1::GetTextureCount());
+        mu_assert(VDP1::GetTextureCount() == 2 && VDP1::Textures[third].Address == thirdAddress, buffer);
+
+        const int32_t reused = VDP1::TryAllocateTexture(16, 16, CRAM::TextureColorMode::Paletted16, 0);
+
+        snprintf(buffer, buffer_size, "Freed texture not reused: id %d", reused);
+        mu_assert(reused == second && VDP1::Textures[reused].Address == secondAddress, buffer);
+    }
+
+    /**
+     * @brief Report free memory split by allocated textures
+     *
+     * Freed texture between two others leaves a hole that counts into available memory but not into the largest block,
+     * freeing its neighbours merges everything back into one block.
+     */
+    MU_TEST(vdp1_test_available_memory)
+    {
+        size_t largest = 0;
+        const size_t total = VDP1::GetAvailableMemory(&largest);
+
+        snprintf(buffer, buffer_size, "Empty heap is not one block: %d of %d", largest, total);
+        mu_assert(total > 0 && largest == total, buffer);
+
+        const int32_t first = VDP1::TryAllocateTexture(64, 64, CRAM::TextureColorMode::RGB555, 0);
+        const int32_t second = VDP1::TryAllocateTexture(64, 64, CRAM::TextureColorMode::RGB555, 0);
+        const int32_t third = VDP1::TryAllocateTexture(64, 64, CRAM::TextureColorMode::RGB555, 0);
+        VDP1::FreeTexture(second);
+
+        const size_t available = VDP1::GetAvailableMemory(&largest);
+
+        snprintf(buffer, buffer_size, "Fragmented heap: %d available, %d largest", available, largest);
+        mu_assert(available == total - (2 * 64 * 64 * 2) && largest == total - (3 * 64 * 64 * 2), buffer);
+
+        VDP1::FreeTexture(first);
+        VDP1::FreeTexture(third);
+
+        snprintf(buffer, buffer_size, "Free blocks were not merged: %d of %d", largest, total);
+        mu_assert(VDP1::GetAvailableMemory(&largest) == total && largest == total, buffer);
+    }
+
+    /**
+     * @brief VDP1 test suite configuration and test case registration
+     *
+     * Configures the test suite with setup, teardown, and error reporting functions.
+     * Registers individual test cases to be executed during the test run.
+     */
+    MU_TEST_SUITE(vdp1_test_suite)
+    {
+        // Configure test suite with setup, teardown, and error reporting functions
+        MU_SUITE_CONFIGURE_WITH_HEADER(&vdp1_test_setup,
+                                       &vdp1_test_teardown,
+                                       &vdp1_test_output_header);
+
+        // Register test cases to be executed
+        MU_RUN_TEST(vdp1_test_free_texture);
+        MU_RUN_TEST(vdp1_test_available_memory);
+    }
+}
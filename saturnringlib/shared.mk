@@ -67,6 +67,14 @@ ifeq ($(strip ${SRL_MAX_CD_FILES}),)
 	SRL_MAX_CD_FILES=255
 endif
 
+ifeq ($(strip ${SRL_MAX_CD_CACHED_DIRECTORIES}),)
+	SRL_MAX_CD_CACHED_DIRECTORIES=4
+endif
+
+ifeq ($(strip ${SRL_MAX_CD_QUEUED_READS}),)
+	SRL_MAX_CD_QUEUED_READS=16
+endif
+
 ifeq ($(strip ${SRL_MAX_CD_RETRIES}),)
 	SRL_MAX_CD_RETRIES=5
 endif
@@ -93,6 +101,14 @@ ifneq ($(strip ${SRL_LOG_LEVEL}),)
 	CCFLAGS += -DSRL_LOG_LEVEL=$(strip ${SRL_LOG_LEVEL})
 endif
 
+ifeq ($(strip ${SRL_MEMORY_PROFILER}), 1)
+	CCFLAGS += -DSRL_MEMORY_PROFILER
+endif
+
+ifeq ($(strip ${SRL_CD_PROFILER}), 1)
+	CCFLAGS += -DSRL_CD_PROFILER
+endif
+
 ifeq ($(strip ${SRL_USE_SGL_SOUND_DRIVER}), 1)
 	CCFLAGS += -DSRL_USE_SGL_SOUND_DRIVER=$(strip ${SRL_USE_SGL_SOUND_DRIVER})
 	LIBS += $(SGLLDIR)/LIBSND.A
@@ -120,6 +136,8 @@ CCFLAGS += -DSRL_MODE_$(strip ${SRL_MODE}) \
 	-DSRL_MAX_TEXTURES=$(strip ${SRL_MAX_TEXTURES}) \
 	-DSRL_MAX_CD_BACKGROUND_JOBS=$(strip ${SRL_MAX_CD_BACKGROUND_JOBS}) \
 	-DSRL_MAX_CD_FILES=$(strip ${SRL_MAX_CD_FILES}) \
+	-DSRL_MAX_CD_CACHED_DIRECTORIES=$(strip ${SRL_MAX_CD_CACHED_DIRECTORIES}) \
+	-DSRL_MAX_CD_QUEUED_READS=$(strip ${SRL_MAX_CD_QUEUED_READS}) \
 	-DSRL_MAX_CD_RETRIES=$(strip ${SRL_MAX_CD_RETRIES}) \
 	-DSRL_DEBUG_MAX_PRINT_LENGTH=$(strip ${SRL_DEBUG_MAX_PRINT_LENGTH}) \
 	-DSRL_DEBUG_MAX_LOG_LENGTH=$(strip ${SRL_DEBUG_MAX_LOG_LENGTH}) \
@@ -171,9 +189,13 @@ SATURNMATHPPDIR = $(MODDIR)/SaturnMathPP
 SYSSOURCES += $(SGLLDIR)/../SRC/workarea.c
 
 ifdef SRL_MALLOC_METHOD
-	ifeq ($(SRL_MALLOC_METHOD), TLSF)
+	ifeq ($(strip $(SRL_MALLOC_METHOD)), TLSF)
 		SYSSOURCES += $(TLSFDIR)/tlsf.c
-		USE_TLSF_ALLOCATOR := TRUE
+		CCFLAGS += -DUSE_TLSF_ALLOCATOR
+	endif
+
+	ifeq ($(strip $(SRL_MALLOC_METHOD)), SEGREGATED)
+		CCFLAGS += -DUSE_SEGREGATED_ALLOCATOR
 	endif
 endif
 
@@ -13,5 +13,7 @@ static_assert(SGL_MAX_POLYGONS > 4,
 #include "srl_core.hpp"
 #include "srl_datetime.hpp"
 #include "srl_tga.hpp"
+#include "srl_srt.hpp"
+#include "srl_loader.hpp"
 #include "srl_scene2d.hpp"
 #include "srl_scene3d.hpp"
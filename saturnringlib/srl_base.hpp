@@ -5,6 +5,7 @@
 extern "C" {
     #include <sgl.h>
     #include <sega_gfs.h>
+    #include <sega_stm.h>
     #include <sega_bup.h>
     #include <sega_int.h>
     #include "stdint-gcc.h"
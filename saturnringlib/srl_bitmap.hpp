@@ -126,4 +126,36 @@ namespace SRL::Bitmap
             return BitmapInfo(0, 0);
         }
     };
+
+    /** @brief Destination image loaders decode pixels into
+     * @details Lets a loader write decoded rows straight to their final place (e.g. VDP1 texture or VDP2 cells) instead of its own buffer.
+     * Rows are stored as they would be in IBitmap::GetData(), paletted images with up to 16 colors take half a byte per pixel, others one byte per pixel, RGB555 images two bytes per pixel.
+     */
+    struct IDecodeTarget
+    {
+        /** @brief Destroy the decode target
+         */
+        virtual ~IDecodeTarget() = default;
+
+        /** @brief Prepare target for decoded image
+         * @note Called before any row is requested, palette of the image is already decoded
+         * @param info Decoded image info
+         * @return false if target cannot hold the image
+         */
+        virtual bool Begin(BitmapInfo info) = 0;
+
+        /** @brief Get where row of pixels should be decoded to
+         * @note Rows are requested one by one in order they are stored in the file (top to bottom or bottom to top), previous row is complete once next one is requested
+         * @param y Image row (0 is top row)
+         * @return Start of the row
+         */
+        virtual uint8_t* GetRow(uint16_t y) = 0;
+
+        /** @brief All rows were decoded
+         */
+        virtual void End()
+        {
+            // Do nothing
+        }
+    };
 }
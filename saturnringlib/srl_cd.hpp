@@ -2,6 +2,19 @@
 
 #include "srl_base.hpp"
 #include "srl_debug.hpp"
+#include "srl_event.hpp"
+
+#if defined(SRL_CD_PROFILER)
+extern "C" {
+    #include <sega_tim.h>
+}
+
+#ifndef SRL_CD_PROFILER_MAX_FILES
+/** @brief Number of files CD profiler keeps statistics of
+ */
+#define SRL_CD_PROFILER_MAX_FILES 32
+#endif
+#endif
 
 namespace SRL
 {
@@ -26,6 +39,166 @@ namespace SRL
          */
         inline static bool isInitialized = false;
 
+        /** @brief Cached directory listing with hashed name index
+         */
+        struct DirectoryIndex
+        {
+            /** @brief Frame address of the directory, 0 if entry is not used
+             */
+            int32_t Fad;
+
+            /** @brief Number of records in the listing
+             */
+            int32_t Count;
+
+            /** @brief Copy of the directory records
+             */
+            GfsDirName* Records;
+
+            /** @brief Open addressing hash table of file identifiers, -1 marks empty slot
+             */
+            int16_t* Slots;
+
+            /** @brief Number of slots minus one (number of slots is power of two)
+             */
+            uint32_t Mask;
+
+            /** @brief Time of the last use, least recently used entry is replaced first
+             */
+            uint32_t LastUse;
+        };
+
+        /** @brief Indexes of recently visited directories
+         */
+        inline static DirectoryIndex directories[SRL_MAX_CD_CACHED_DIRECTORIES];
+
+        /** @brief Index of the current directory, nullptr if names are resolved by GFS
+         */
+        inline static DirectoryIndex* currentDirectory = nullptr;
+
+        /** @brief Counter used to track directory usage
+         */
+        inline static uint32_t directoryClock = 0;
+
+        /** @brief Compare record name with file name
+         * @param record Directory record
+         * @param name File name
+         * @return true if names are same
+         */
+        inline static bool RecordNameEquals(const GfsDirName& record, const char* name)
+        {
+            for (size_t character = 0; character < GFS_FNAME_LEN; character++)
+            {
+                if (record.fname[character] != name[character])
+                {
+                    return false;
+                }
+                else if (name[character] == '\0')
+                {
+                    return true;
+                }
+            }
+
+            // Record name fills the whole field and is not terminated
+            return name[GFS_FNAME_LEN] == '\0';
+        }
+
+        /** @brief Find index of cached directory
+         * @param fad Frame address of the directory
+         * @return Directory index or nullptr if directory is not cached
+         */
+        inline static DirectoryIndex* FindDirectory(const int32_t fad)
+        {
+            for (DirectoryIndex& directory : Cd::directories)
+            {
+                if (directory.Fad != 0 && directory.Fad == fad)
+                {
+                    return &directory;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /** @brief Build index of the directory listing that was just loaded and make it current
+         * @details Least recently used cached directory is replaced, if there is not enough memory names are resolved by GFS
+         * @param records Loaded directory records
+         * @param count Number of loaded records
+         */
+        inline static void IndexDirectory(const GfsDirName* records, const int32_t count)
+        {
+            const int32_t limit = count < SRL_MAX_CD_FILES ? count : SRL_MAX_CD_FILES;
+            int32_t loaded = 0;
+            Cd::currentDirectory = nullptr;
+
+            // Unused part of the table is empty, no record can start at frame address 0
+            while (loaded < limit && records[loaded].dirrec.fad != 0)
+            {
+                loaded++;
+            }
+
+            if (loaded == 0)
+            {
+                return;
+            }
+
+            DirectoryIndex* entry = &Cd::directories[0];
+
+            for (DirectoryIndex& directory : Cd::directories)
+            {
+                if (directory.LastUse < entry->LastUse)
+                {
+                    entry = &directory;
+                }
+            }
+
+            delete[] entry->Records;
+            delete[] entry->Slots;
+
+            // Keep the table at most half full so probe sequences stay short
+            uint32_t slots = 4;
+
+            while (slots < static_cast<uint32_t>(loaded) << 1)
+            {
+                slots <<= 1;
+            }
+
+            entry->Fad = 0;
+            entry->Records = new GfsDirName[loaded];
+            entry->Slots = new int16_t[slots];
+
+            if (entry->Records == nullptr || entry->Slots == nullptr)
+            {
+                delete[] entry->Records;
+                delete[] entry->Slots;
+                entry->Records = nullptr;
+                entry->Slots = nullptr;
+                entry->LastUse = 0;
+                return;
+            }
+
+            Memory::MemCopy(entry->Records, records, sizeof(GfsDirName) * loaded);
+            Memory::MemSet(entry->Slots, 0xff, sizeof(int16_t) * slots);
+
+            for (int32_t fid = 0; fid < loaded; fid++)
+            {
+                uint32_t slot = Cd::HashName(reinterpret_cast<const char*>(records[fid].fname), GFS_FNAME_LEN) & (slots - 1);
+
+                while (entry->Slots[slot] >= 0)
+                {
+                    slot = (slot + 1) & (slots - 1);
+                }
+
+                entry->Slots[slot] = fid;
+            }
+
+            entry->Fad = records[0].dirrec.fad;
+            entry->Count = loaded;
+            entry->Mask = slots - 1;
+            entry->LastUse = ++Cd::directoryClock;
+            Cd::currentDirectory = entry;
+        }
+
     public:
         /** @brief Number of tracks CD can have
          */
@@ -199,185 +372,1675 @@ namespace SRL
             }
         };
 
-        /** @brief Disk file
+        struct File;
+
+#if defined(SRL_CD_PROFILER)
+        /** @brief CD access profiler
+         * @details Enabled by setting @c SRL_CD_PROFILER = 1 in the project makefile.
+         * Every File::Open(), File::Read(), File::ReadSectors(), File::Seek(), File::LoadBytes() and Cd::Initialize() call is timed
+         * with the free running timer of master CPU, sectors requested from the drive are counted together with seeks between
+         * sectors that do not follow each other, so it is possible to tell which files load slowly and why.<br/>
+         * Statistics are kept in total and for each file, files are told apart by their position on disc.
+         * Use Print() to output the collected data.
+         * @code {.cpp}
+         * SRL::Cd::Profiler::Reset();
+         * LoadLevel();
+         *
+         * const SRL::Cd::Profiler::Stats& totals = SRL::Cd::Profiler::GetTotals();
+         * SRL::Logger::LogInfo("Level loaded in %u us, %u seeks", SRL::Cd::Profiler::TicksToMicroseconds(totals.Ticks), totals.Seeks);
+         * @endcode
+         * @note Profiler keeps statistics of up to @c SRL_CD_PROFILER_MAX_FILES files (32 by default), other files are counted only in total.
+         * Timer is switched to 1/32 of system clock, which wraps every ~78ms, so it is extended by Tick() called from vertical blank interrupt.
          */
-        struct File
+        class Profiler
         {
-        private:
-            /** @brief Maximal number of sectors to be read in a single pass
+        public:
+            /** @brief Profiled operation
              */
-            inline static const uint16_t SectorsToReadAtOnce = 5;
+            enum class Operation : uint8_t
+            {
+                /** @brief Cd::Initialize()
+                 */
+                Initialize,
 
-            /** @brief File identifier
+                /** @brief File::Open()
+                 */
+                Open,
+
+                /** @brief File::Read()
+                 */
+                Read,
+
+                /** @brief File::ReadSectors()
+                 */
+                ReadSectors,
+
+                /** @brief File::Seek()
+                 */
+                Seek,
+
+                /** @brief File::LoadBytes()
+                 */
+                LoadBytes
+            };
+
+            /** @brief Number of profiled operations
              */
-            int32_t identifier;
+            static constexpr uint8_t OperationCount = 6;
 
-            /** @brief Number of bytes read in total
+            /** @brief Statistics of one operation
              */
-            int32_t readBytes;
+            struct OperationStats
+            {
+                /** @brief Number of calls
+                 */
+                uint32_t Calls;
+
+                /** @brief Time spent in all calls in timer ticks
+                 */
+                uint32_t Ticks;
 
-            /** @brief File read buffer
+                /** @brief Longest call in timer ticks
+                 */
+                uint32_t MaxTicks;
+            };
+
+            /** @brief Statistics of one file or of all files in total
              */
-            uint8_t *workBuffer;
+            struct Stats
+            {
+                /** @brief File name, empty for totals
+                 */
+                char Name[GFS_FNAME_LEN + 1];
+
+                /** @brief Frame address of the first sector of the file, -1 for totals
+                 */
+                int32_t Fad;
+
+                /** @brief Number of profiled calls
+                 */
+                uint32_t Calls;
+
+                /** @brief Number of bytes returned to the caller
+                 */
+                uint32_t BytesRead;
+
+                /** @brief Number of sectors requested from the drive
+                 */
+                uint32_t SectorsRead;
+
+                /** @brief Number of reads that did not continue where the previous read ended
+                 */
+                uint32_t Seeks;
+
+                /** @brief Number of reads that had to be repeated (see @c SRL_MAX_CD_RETRIES)
+                 */
+                uint32_t Retries;
+
+                /** @brief Number of failed calls
+                 */
+                uint32_t Failures;
+
+                /** @brief Time spent in all calls in timer ticks
+                 */
+                uint32_t Ticks;
+
+                /** @brief Longest call in timer ticks
+                 */
+                uint32_t MaxTicks;
+            };
 
-            /** @brief Get the byte offset inside current work buffer
-             * @param absolute Absolute position
-             * @param workBufferSize Size of a work buffer
-             * @return size_t Position within work buffer
+            /** @brief Measures one call for the lifetime of the scope
              */
-            int32_t GetOffsetInWorkBuffer(int32_t absolute, int32_t workBufferSize)
+            class Measure
             {
-                if (absolute >= workBufferSize)
+            private:
+                /** @brief Measured operation
+                 */
+                Operation operation;
+
+                /** @brief File identifier, negative if call is not related to a file
+                 */
+                int32_t identifier;
+
+                /** @brief Timer value at the start of the call
+                 */
+                uint32_t start;
+
+                /** @brief Call result
+                 */
+                int32_t result;
+
+                /** @brief Call was made from inside of another measured call
+                 */
+                bool nested;
+
+            public:
+                /** @brief Start measuring
+                 * @param operation Measured operation
+                 * @param identifier File identifier, negative if call is not related to a file
+                 */
+                Measure(Operation operation, int32_t identifier) : operation(operation),
+                                                                   identifier(identifier),
+                                                                   start(Profiler::GetTicks()),
+                                                                   result(0),
+                                                                   nested(Profiler::depth++ > 0)
                 {
-                    return absolute % workBufferSize;
                 }
 
-                return absolute;
-            }
+                /** @brief Set call result
+                 * @param result Number of bytes returned to the caller, negative on failure
+                 */
+                void SetResult(int32_t result)
+                {
+                    this->result = result;
+                }
 
-        public:
-            /** @brief File handle
+                /** @brief Record the call
+                 */
+                ~Measure()
+                {
+                    Profiler::depth--;
+                    Profiler::Record(this->operation, this->identifier, Profiler::GetTicks() - this->start, this->result, this->nested);
+                }
+            };
+
+        private:
+            /** @brief Maximal number of profiled files
              */
-            GfsHn Handle;
+            static constexpr uint8_t MaxFiles = SRL_CD_PROFILER_MAX_FILES;
 
-            /** @brief Size of the file
+            /** @brief VDP2 status register, lowest bit is set on PAL systems
              */
-            FileSize Size;
+            inline static const uint32_t VideoStatusAddress = 0x25f80004;
 
-            /** @brief disable default constructor
+            /** @brief Timer ticks counted by Tick()
              */
-            File() = delete;
+            inline static volatile uint32_t ticks = 0;
 
-            /** @brief Construct a new File object from Gfs handle and identifier
-             * @param handle Gfs handle
-             * @param fid File identifier
-             * @param getSize Fetch file size (will cause file to be open for a bit)
+            /** @brief Timer counter value seen by last Tick()
              */
-            File(GfsHn handle, int32_t fid, bool getSize = true) : Handle(handle),
-                                                                   Size(getSize ? FileSize(handle) : FileSize()),
-                                                                   identifier(fid),
-                                                                   workBuffer(nullptr),
-                                                                   readBytes(0)
-            {
-                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
-                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
-                #endif
-            }
+            inline static volatile uint16_t lastCounter = 0;
 
-            /** @brief Open a file on CD
-             * @param name File name
+            /** @brief Frame address right after the last requested sector
              */
-            File(const char *name) : Handle(nullptr),
-                                     Size(0),
-                                     identifier(-1),
-                                     workBuffer(nullptr),
-                                     readBytes(0)
-            {
-                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
-                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
-                #endif
+            inline static int32_t lastFad = -1;
 
-                if (name != nullptr)
-                {
-                    int32_t sectorSize;
-                    int32_t sectorCount;
-                    int32_t lastSectorSize;
-                    int32_t id = GFS_NameToId((int8_t *)name);
+            /** @brief Number of measured calls in progress
+             */
+            inline static uint8_t depth = 0;
 
-                    if (id >= 0)
-                    {
-                        this->identifier = id;
+            /** @brief Statistics of all files
+             */
+            inline static Stats totals = { "", -1 };
 
-                        if (this->Open())
-                        {
-                            this->Size = FileSize(this->Handle);
-                            this->Close();
-                        }
-                        else
-                        {
-                            this->identifier = -1;
-                        }
-                    }
-                }
-            }
+            /** @brief Statistics of each operation
+             */
+            inline static OperationStats operations[Profiler::OperationCount];
 
-            /** @brief Close file
+            /** @brief Statistics of each profiled file
              */
-            ~File()
-            {
-                this->Close();
-            }
+            inline static Stats files[Profiler::MaxFiles];
 
-            /**
-             * @name File handling and status
-             * @{
+            /** @brief Number of profiled files
              */
+            inline static uint8_t fileCount = 0;
 
-            /** @brief Close file
+            /** @brief Find or add statistics of a file
+             * @param identifier File identifier in current directory
+             * @return File statistics, nullptr if file is not valid or table is full
              */
-            void Close()
+            inline static Stats* GetFileStats(int32_t identifier)
             {
-                if (this->Handle != nullptr)
+                GfsDirId info;
+
+                if (identifier < 0 || GFS_GetDirInfo(identifier, &info) != ErrorCode::ErrorOk)
                 {
-                    GFS_Close(this->Handle);
-                    this->Handle = nullptr;
+                    return nullptr;
                 }
 
-                if (this->workBuffer != nullptr)
+                for (uint8_t index = 0; index < Profiler::fileCount; index++)
                 {
-                    delete this->workBuffer;
-                    this->workBuffer = nullptr;
+                    if (Profiler::files[index].Fad == info.dirrec.fad)
+                    {
+                        return &Profiler::files[index];
+                    }
                 }
-            }
 
-            /** @brief Open file
-             * @return True on success
-             */
-            bool Open()
-            {
-                if (this->IsOpen())
+                if (Profiler::fileCount >= Profiler::MaxFiles)
                 {
-                    return true;
+                    return nullptr;
                 }
-                else if (this->identifier >= 0)
+
+                Stats* stats = &Profiler::files[Profiler::fileCount++];
+                *stats = Stats();
+                stats->Fad = info.dirrec.fad;
+
+                if (identifier < GFS_DIRTBL_NDIR(&Cd::GfsDirectories))
                 {
-                    this->readBytes = 0;
-                    this->Handle = GFS_Open(this->identifier);
+                    Memory::MemCopy(stats->Name, GFS_DIRTBL_DIRNAME(&Cd::GfsDirectories)[identifier].fname, GFS_FNAME_LEN);
                 }
 
-                return this->Handle != nullptr;
+                return stats;
             }
 
-            /** @brief File exists
-             * @return True if exists
+            /** @brief Add finished call to statistics
+             * @param operation Measured operation
+             * @param identifier File identifier, negative if call is not related to a file
+             * @param elapsed Duration of the call in timer ticks
+             * @param result Number of bytes returned to the caller, negative on failure
+             * @param nested Call was made from inside of another measured call, its time is already counted by the outer one
              */
-            constexpr bool Exists()
+            inline static void Record(Operation operation, int32_t identifier, uint32_t elapsed, int32_t result, bool nested)
             {
-                return this->identifier >= 0;
-            }
+                OperationStats& stats = Profiler::operations[static_cast<uint8_t>(operation)];
+                stats.Calls++;
+                stats.Ticks += elapsed;
+                stats.MaxTicks = SRL::Math::Max<uint32_t>(stats.MaxTicks, elapsed);
 
-            /** @brief Gets the current position in the file
-             * @return Position in the file as bytes
-             */
-            constexpr size_t GetCurrentPosition()
-            {
-                return this->readBytes;
-            }
+                if (nested)
+                {
+                    return;
+                }
 
-            /** @brief File is open
-             * @return True if file is open
-             */
-            constexpr bool IsOpen()
-            {
-                return this->Exists() && this->Handle != nullptr;
-            }
+                Stats* file = Profiler::GetFileStats(identifier);
+
+                for (Stats* target : { &Profiler::totals, file })
+                {
+                    if (target == nullptr)
+                    {
+                        continue;
+                    }
+
+                    target->Calls++;
+                    target->Ticks += elapsed;
+                    target->MaxTicks = SRL::Math::Max<uint32_t>(target->MaxTicks, elapsed);
+
+                    if (result < 0)
+                    {
+                        target->Failures++;
+                    }
+                    else if (operation != Operation::Seek)
+                    {
+                        target->BytesRead += result;
+                    }
+                }
+            }
+
+        public:
+            /** @brief Disable default constructor
+             */
+            Profiler() = delete;
+
+            /** @brief Switch timer to 1/32 of system clock
+             * @details Called by Cd::Initialize()
+             */
+            inline static void Initialize()
+            {
+                TIM_FRT_INIT(TIM_CKS_32);
+                TIM_FRT_SET_16(0);
+                Profiler::lastCounter = 0;
+            }
+
+            /** @brief Extend 16-bit timer counter, must be called at least every ~78ms
+             * @details Called from vertical blank interrupt
+             */
+            inline static void Tick()
+            {
+                const uint16_t counter = TIM_FRT_GET_16();
+                Profiler::ticks = Profiler::ticks + static_cast<uint16_t>(counter - Profiler::lastCounter);
+                Profiler::lastCounter = counter;
+            }
+
+            /** @brief Get current time
+             * @return Number of timer ticks since start
+             */
+            inline static uint32_t GetTicks()
+            {
+                uint32_t base;
+                uint16_t last;
+                uint16_t counter;
+
+                // Tick() can interrupt us, read again if it did
+                do
+                {
+                    base = Profiler::ticks;
+                    last = Profiler::lastCounter;
+                    counter = TIM_FRT_GET_16();
+                }
+                while (base != Profiler::ticks);
+
+                return base + static_cast<uint16_t>(counter - last);
+            }
+
+            /** @brief Convert timer ticks to microseconds
+             * @param ticks Number of ticks
+             * @return Number of microseconds
+             */
+            inline static uint32_t TicksToMicroseconds(uint32_t ticks)
+            {
+                const bool pal = (*reinterpret_cast<volatile uint16_t*>(Profiler::VideoStatusAddress) & 1) != 0;
+                const bool fast = SYS_GETSYSCK != 0;
+                const uint32_t kiloHertz = pal ? (fast ? 28437 : 26687) : (fast ? 28636 : 26874);
+                return static_cast<uint32_t>((static_cast<uint64_t>(ticks) * 32000) / kiloHertz);
+            }
+
+            /** @brief Count sectors requested from the drive
+             * @param identifier File identifier
+             * @param sector First sector in the file
+             * @param count Number of sectors
+             */
+            inline static void RecordTransfer(int32_t identifier, int32_t sector, int32_t count)
+            {
+                GfsDirId info;
+
+                if (count <= 0 || GFS_GetDirInfo(identifier, &info) != ErrorCode::ErrorOk)
+                {
+                    return;
+                }
+
+                const int32_t fad = info.dirrec.fad + sector;
+                const bool seek = fad != Profiler::lastFad;
+                Profiler::lastFad = fad + count;
+
+                for (Stats* target : { &Profiler::totals, Profiler::GetFileStats(identifier) })
+                {
+                    if (target != nullptr)
+                    {
+                        target->SectorsRead += count;
+                        target->Seeks += seek ? 1 : 0;
+                    }
+                }
+            }
+
+            /** @brief Count repeated read
+             * @param identifier File identifier
+             */
+            inline static void RecordRetry(int32_t identifier)
+            {
+                for (Stats* target : { &Profiler::totals, Profiler::GetFileStats(identifier) })
+                {
+                    if (target != nullptr)
+                    {
+                        target->Retries++;
+                    }
+                }
+            }
+
+            /** @brief Clear all statistics
+             */
+            inline static void Reset()
+            {
+                Profiler::totals = { "", -1 };
+                Profiler::fileCount = 0;
+                Profiler::lastFad = -1;
+
+                for (OperationStats& stats : Profiler::operations)
+                {
+                    stats = OperationStats();
+                }
+            }
+
+            /** @brief Get statistics of all files
+             * @return Total statistics
+             */
+            inline static const Stats& GetTotals()
+            {
+                return Profiler::totals;
+            }
+
+            /** @brief Get statistics of an operation
+             * @param operation Profiled operation
+             * @return Operation statistics
+             */
+            inline static const OperationStats& GetOperationStats(Operation operation)
+            {
+                return Profiler::operations[static_cast<uint8_t>(operation)];
+            }
+
+            /** @brief Get number of profiled files
+             * @return Number of files
+             */
+            inline static uint8_t GetFileCount()
+            {
+                return Profiler::fileCount;
+            }
+
+            /** @brief Get statistics of a profiled file
+             * @param index File index (less than GetFileCount())
+             * @return File statistics
+             */
+            inline static const Stats& GetFileStats(uint8_t index)
+            {
+                return Profiler::files[index];
+            }
+
+            /** @brief Print collected statistics on screen, files are listed in order of their first access
+             * @param x Offset from left of the screen
+             * @param y Offset from top of the screen
+             * @param maxFiles Maximal number of files to print
+             * @return Number of lines printed
+             */
+            inline static uint8_t Print(uint8_t x, uint8_t y, uint8_t maxFiles = 8)
+            {
+                uint8_t line = y;
+                const Stats& total = Profiler::totals;
+
+                Debug::Print(x, line++, "CD %uB %u sct %u seek %u us", total.BytesRead, total.SectorsRead, total.Seeks, Profiler::TicksToMicroseconds(total.Ticks));
+                Debug::Print(x + 1, line++, "retry %u fail %u max %u us", total.Retries, total.Failures, Profiler::TicksToMicroseconds(total.MaxTicks));
+
+                for (uint8_t index = 0; index < Profiler::fileCount && index < maxFiles; index++)
+                {
+                    const Stats& file = Profiler::files[index];
+                    Debug::Print(x, line++, "%-12s %uB %u seek %u us", file.Name, file.BytesRead, file.Seeks, Profiler::TicksToMicroseconds(file.Ticks));
+                }
+
+                return line - y;
+            }
+        };
+#endif
+
+        /** @brief Asynchronous file read
+         * @details Requests are created by File::ReadAsync() or File::QueueRead() and are advanced once per frame by Cd::ProcessRequests().
+         * Queued requests wait until the drive is idle, then the one with the highest priority is started. Requests of the same priority
+         * are started in order of their position on the disc, sweeping from the current drive position towards the end of the disc
+         * and then wrapping around to the start (C-SCAN), so the drive does not seek back and forth between distant files.
+         * Request stays valid until Release() is called, it is safe to call it from inside of the OnCompleted handler.
+         * @code {.cpp}
+         * void DataLoaded(SRL::Cd::ReadRequest* request)
+         * {
+         *      // Data are now available at request->GetDestination()
+         *      request->Release();
+         * }
+         *
+         * SRL::Cd::ReadRequest* request = file.ReadAsync(file.Size.Bytes, buffer);
+         *
+         * if (request != nullptr)
+         * {
+         *      request->OnCompleted += DataLoaded;
+         * }
+         * @endcode
+         */
+        class ReadRequest
+        {
+        public:
+            /** @brief State of the request
+             */
+            enum class Status : uint8_t
+            {
+                /** @brief Request slot is not used
+                 */
+                Free,
+
+                /** @brief Request waits for the drive
+                 */
+                Queued,
+
+                /** @brief Data are being read
+                 */
+                Pending,
+
+                /** @brief All data were read
+                 */
+                Completed,
+
+                /** @brief Read failed or was canceled
+                 */
+                Failed
+            };
+
+            /** @brief Priority class of queued request
+             */
+            enum class Priority : uint8_t
+            {
+                /** @brief Data needed right away (e.g. streamed audio)
+                 */
+                High,
+
+                /** @brief Regular asset loading
+                 */
+                Normal,
+
+                /** @brief Data that can wait (e.g. prefetching next area)
+                 */
+                Low
+            };
+
+        private:
+            /** @brief Cd class owns and processes requests
+             */
+            friend class Cd;
+
+            /** @brief File starts the requests
+             */
+            friend struct File;
+
+            /** @brief File being read
+             */
+            File* file;
+
+            /** @brief Gfs handle of the file being read
+             */
+            GfsHn handle;
+
+            /** @brief Buffer to read data into
+             */
+            void* destination;
+
+            /** @brief Sector the read started at
+             */
+            int32_t startSector;
+
+            /** @brief Number of bytes read
+             */
+            int32_t bytesRead;
+
+            /** @brief Number of bytes requested
+             */
+            int32_t size;
+
+            /** @brief Frame address of the first sector to read, used to order queued requests
+             */
+            int32_t fad;
+
+            /** @brief Frame the request was created in
+             */
+            uint32_t queuedFrame;
+
+            /** @brief Frame the drive started reading in
+             */
+            uint32_t startedFrame;
+
+            /** @brief Frame the request finished in
+             */
+            uint32_t finishedFrame;
+
+            /** @brief Current state
+             */
+            Status status;
+
+            /** @brief Priority class
+             */
+            Priority priority;
+
+            /** @brief File was opened only for this request and is closed once it is done
+             */
+            bool closeWhenDone;
+
+            /** @brief Completion handlers are being invoked, slot must not be reused yet
+             */
+            bool isNotifying;
+
+            /** @brief Set final state and notify listeners
+             * @param result Final state of the request
+             */
+            void Finish(const Status result)
+            {
+                this->status = result;
+                this->finishedFrame = Cd::frameCount;
+
+                // Request is no longer pending, so closing the file does not cancel it again
+                if (this->closeWhenDone)
+                {
+                    this->closeWhenDone = false;
+                    this->file->Close();
+                }
+
+                this->isNotifying = true;
+                this->OnCompleted.Invoke(this);
+                this->isNotifying = false;
+            }
+
+        public:
+            /** @brief Invoked once the read completes or fails
+             */
+            SRL::Types::Event<ReadRequest*> OnCompleted;
+
+            /** @brief Construct an unused request
+             */
+            ReadRequest() : file(nullptr),
+                            handle(nullptr),
+                            destination(nullptr),
+                            startSector(0),
+                            bytesRead(0),
+                            size(0),
+                            fad(0),
+                            queuedFrame(0),
+                            startedFrame(0),
+                            finishedFrame(0),
+                            status(Status::Free),
+                            priority(Priority::Normal),
+                            closeWhenDone(false),
+                            isNotifying(false)
+            {
+            }
+
+            /** @brief Get state of the request
+             * @return Request state
+             */
+            constexpr Status GetStatus()
+            {
+                return this->status;
+            }
+
+            /** @brief Check whether the request has finished
+             * @return true if request completed or failed
+             */
+            constexpr bool IsDone()
+            {
+                return this->status == Status::Completed || this->status == Status::Failed;
+            }
+
+            /** @brief Get priority class of the request
+             * @return Request priority
+             */
+            constexpr Priority GetPriority()
+            {
+                return this->priority;
+            }
+
+            /** @brief Get number of frames request waited in the queue before the drive started reading it
+             * @return Number of frames, frames waited so far if request is still queued
+             */
+            uint32_t GetQueueTime()
+            {
+                return (this->status == Status::Queued ? Cd::frameCount : this->startedFrame) - this->queuedFrame;
+            }
+
+            /** @brief Get number of frames from creating the request until it finished
+             * @return Number of frames, frames elapsed so far if request is not done yet
+             */
+            uint32_t GetLatency()
+            {
+                return (this->IsDone() ? this->finishedFrame : Cd::frameCount) - this->queuedFrame;
+            }
+
+            /** @brief Get number of bytes read
+             * @return Number of bytes, valid once the request completed
+             */
+            constexpr int32_t GetBytesRead()
+            {
+                return this->bytesRead;
+            }
+
+            /** @brief Get buffer data are read into
+             * @return Destination buffer
+             */
+            constexpr void* GetDestination()
+            {
+                return this->destination;
+            }
+
+            /** @brief Get file being read
+             * @return File the request was created from
+             */
+            constexpr File* GetFile()
+            {
+                return this->file;
+            }
+
+            /** @brief Block until the request is done
+             * @note Request that cannot start because all Gfs handles are taken by open files fails, no handle can be released while waiting
+             * @return true if all data were read
+             */
+            bool Wait()
+            {
+                while (this->status == Status::Queued || this->status == Status::Pending)
+                {
+                    Cd::ProcessRequests();
+
+                    // Drive is idle and request did not start, queue is stuck until some file gets closed
+                    if (this->status == Status::Queued && !Cd::IsReading())
+                    {
+                        this->Finish(Status::Failed);
+                    }
+                }
+
+                return this->status == Status::Completed;
+            }
+
+            /** @brief Stop reading, request will be marked as failed
+             */
+            void Cancel()
+            {
+                if (this->status == Status::Pending)
+                {
+                    GFS_NwStop(this->handle);
+                    this->Finish(Status::Failed);
+                }
+                else if (this->status == Status::Queued)
+                {
+                    this->Finish(Status::Failed);
+                }
+            }
+
+            /** @brief Return request back to the pool, pending read is canceled first
+             * @note Request must not be used after it was released
+             */
+            void Release()
+            {
+                this->Cancel();
+                this->file = nullptr;
+                this->handle = nullptr;
+                this->status = Status::Free;
+            }
+        };
+
+    private:
+        /** @brief Asynchronous read requests, both started and queued
+         */
+        inline static ReadRequest readRequests[SRL_MAX_CD_QUEUED_READS];
+
+        /** @brief Frame address right after the last sector requested from the drive
+         */
+        inline static int32_t headFad = 0;
+
+        /** @brief Number of frames since start, used to measure request latency
+         */
+        inline static uint32_t frameCount = 0;
+
+        /** @brief Find request that is queued or reading specified file
+         * @param file File being read
+         * @return Pending request or nullptr
+         */
+        inline static ReadRequest* GetPendingRequest(const File* file)
+        {
+            for (ReadRequest& request : Cd::readRequests)
+            {
+                if (request.file == file && (request.status == ReadRequest::Status::Pending || request.status == ReadRequest::Status::Queued))
+                {
+                    return &request;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /** @brief Check whether drive is reading any request
+         * @return true if some request is pending
+         */
+        inline static bool IsReading()
+        {
+            for (ReadRequest& request : Cd::readRequests)
+            {
+                if (request.status == ReadRequest::Status::Pending)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /** @brief Take unused request from the pool
+         * @param file File to read
+         * @param size Number of bytes to read
+         * @param destination Buffer to read bytes into
+         * @param priority Priority class
+         * @return Request or nullptr if pool is exhausted
+         */
+        inline static ReadRequest* AcquireRequest(File* file, const int32_t size, void* destination, const ReadRequest::Priority priority)
+        {
+            for (ReadRequest& request : Cd::readRequests)
+            {
+                if (request.status == ReadRequest::Status::Free && !request.isNotifying)
+                {
+                    request.OnCompleted = SRL::Types::Event<ReadRequest*>();
+                    request.file = file;
+                    request.handle = nullptr;
+                    request.destination = destination;
+                    request.size = size;
+                    request.startSector = file->IsOpen() ? file->readBytes / file->Size.SectorSize : 0;
+                    request.bytesRead = 0;
+                    request.priority = priority;
+                    request.closeWhenDone = false;
+                    request.queuedFrame = Cd::frameCount;
+                    request.startedFrame = Cd::frameCount;
+                    request.finishedFrame = Cd::frameCount;
+
+                    GfsDirId info;
+                    request.fad = request.startSector + (GFS_GetDirInfo(file->identifier, &info) == ErrorCode::ErrorOk ? info.dirrec.fad : 0);
+                    return &request;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /** @brief Start reading the request
+         * @details File must be open, file opened only for this request is closed if the read does not start
+         * @param request Request to start
+         * @return true if drive started reading
+         */
+        inline static bool StartRequest(ReadRequest& request)
+        {
+            File* file = request.file;
+
+            // Read-ahead might have moved Gfs ahead of the access pointer
+            const int32_t sectors = SRL::Math::Min<int32_t>(
+                (request.size + file->Size.SectorSize - 1) / file->Size.SectorSize,
+                file->Size.Sectors - request.startSector);
+
+            file->StopPrefetch();
+
+            if (sectors > 0 &&
+                GFS_Seek(file->Handle, request.startSector, Cd::SeekMode::Absolute) >= 0 &&
+                GFS_NwFread(file->Handle, sectors, request.destination, request.size) == ErrorCode::ErrorOk)
+            {
+                request.handle = file->Handle;
+                request.status = ReadRequest::Status::Pending;
+                request.startedFrame = Cd::frameCount;
+                Cd::headFad = request.fad + sectors;
+
+                #if defined(SRL_CD_PROFILER)
+                Profiler::RecordTransfer(file->identifier, request.startSector, sectors);
+                #endif
+                return true;
+            }
+
+            if (request.closeWhenDone)
+            {
+                request.closeWhenDone = false;
+                file->Close();
+            }
+
+            return false;
+        }
+
+        /** @brief Start the best queued request
+         * @details Highest priority class goes first, inside of the class requests are taken in one sweep over the disc (C-SCAN)
+         */
+        inline static void StartQueuedRequest()
+        {
+            while (true)
+            {
+                ReadRequest* next = nullptr;
+
+                for (ReadRequest& request : Cd::readRequests)
+                {
+                    if (request.status != ReadRequest::Status::Queued)
+                    {
+                        continue;
+                    }
+
+                    if (next == nullptr || request.priority < next->priority)
+                    {
+                        next = &request;
+                    }
+                    else if (request.priority == next->priority)
+                    {
+                        // Requests ahead of the drive come first, the rest after wrapping around
+                        const bool ahead = request.fad >= Cd::headFad;
+
+                        if ((ahead != (next->fad >= Cd::headFad)) ? ahead : (request.fad < next->fad))
+                        {
+                            next = &request;
+                        }
+                    }
+                }
+
+                if (next == nullptr)
+                {
+                    return;
+                }
+
+                // Closed file is opened only for the duration of the request
+                if (!next->file->IsOpen())
+                {
+                    if (!next->file->Open())
+                    {
+                        // All Gfs handles are taken by open files, try again next frame
+                        return;
+                    }
+
+                    next->closeWhenDone = true;
+                }
+
+                if (Cd::StartRequest(*next))
+                {
+                    return;
+                }
+
+                next->Finish(ReadRequest::Status::Failed);
+            }
+        }
+
+    public:
+        /** @brief Disk file
+         */
+        struct File
+        {
+        private:
+            /** @brief Cd class advances access pointer of asynchronous reads
+             */
+            friend class Cd;
+
+            /** @brief Default size of the read-ahead buffer in sectors
+             */
+            inline static const uint16_t DefaultReadAheadSectors = 5;
+
+            /** @brief File identifier
+             */
+            int32_t identifier;
+
+            /** @brief Number of bytes read in total
+             */
+            int32_t readBytes;
+
+            /** @brief Read-ahead ring buffer, holds whole sectors
+             */
+            uint8_t *workBuffer;
+
+            /** @brief Capacity of the read-ahead buffer in sectors
+             */
+            uint16_t readAheadSectors;
+
+            /** @brief Memory zone the read-ahead buffer is allocated in
+             */
+            Memory::Zone readAheadZone;
+
+            /** @brief File sector stored in the oldest buffer slot
+             */
+            int32_t bufferFirstSector;
+
+            /** @brief Buffer slot holding the oldest sector
+             */
+            uint16_t bufferHead;
+
+            /** @brief Number of sectors loaded in the buffer
+             */
+            uint16_t bufferedSectors;
+
+            /** @brief Number of sectors being prefetched right after the loaded ones
+             */
+            uint16_t prefetchSectors;
+
+            /** @brief Stop prefetching, sectors that were not fully transferred are dropped
+             */
+            void StopPrefetch()
+            {
+                if (this->prefetchSectors > 0)
+                {
+                    GFS_NwStop(this->Handle);
+                    this->prefetchSectors = 0;
+                }
+            }
+
+            /** @brief Forget all buffered sectors
+             * @param sector First sector the buffer should hold from now on
+             */
+            void ResetBuffer(int32_t sector)
+            {
+                this->StopPrefetch();
+                this->bufferFirstSector = sector;
+                this->bufferHead = 0;
+                this->bufferedSectors = 0;
+            }
+
+            /** @brief Start reading following sectors into free part of the buffer
+             * @details Read is only started once at least half of the buffer can be refilled, consumed sectors are kept until then so short backward seeks do not hit the disc
+             */
+            void StartPrefetch()
+            {
+                const int32_t nextSector = this->bufferFirstSector + this->bufferedSectors;
+
+                if (this->workBuffer == nullptr || this->prefetchSectors > 0 || nextSector >= this->Size.Sectors)
+                {
+                    return;
+                }
+
+                // Sectors before the one access pointer is in are no longer needed
+                const int32_t consumed = SRL::Math::Clamp<int32_t>(
+                    (this->readBytes / this->Size.SectorSize) - this->bufferFirstSector,
+                    0,
+                    this->bufferedSectors);
+
+                if (this->readAheadSectors - this->bufferedSectors + consumed < (this->readAheadSectors + 1) >> 1)
+                {
+                    return;
+                }
+
+                this->bufferFirstSector += consumed;
+                this->bufferHead = (this->bufferHead + consumed) % this->readAheadSectors;
+                this->bufferedSectors -= consumed;
+
+                // Fill free slots up to the physical end of the ring, rest is filled by the next prefetch
+                const int32_t tail = (this->bufferHead + this->bufferedSectors) % this->readAheadSectors;
+                const int32_t count = SRL::Math::Min<int32_t>(
+                    SRL::Math::Min<int32_t>(this->readAheadSectors - this->bufferedSectors, this->readAheadSectors - tail),
+                    this->Size.Sectors - nextSector);
+
+                if (GFS_Seek(this->Handle, nextSector, Cd::SeekMode::Absolute) >= 0 &&
+                    GFS_NwFread(this->Handle, count, this->workBuffer + (tail * this->Size.SectorSize), count * this->Size.SectorSize) == ErrorCode::ErrorOk)
+                {
+                    this->prefetchSectors = count;
+
+                    #if defined(SRL_CD_PROFILER)
+                    Profiler::RecordTransfer(this->identifier, nextSector, count);
+                    #endif
+                }
+            }
+
+            /** @brief Transfer prefetched sectors into the buffer
+             * @param wait Block until the prefetch is done
+             * @return false if reading failed
+             */
+            bool UpdatePrefetch(bool wait)
+            {
+                while (this->prefetchSectors > 0)
+                {
+                    if (GFS_NwExecOne(this->Handle) == GFS_SVR_ERROR)
+                    {
+                        this->StopPrefetch();
+                        return false;
+                    }
+
+                    if (GFS_NwIsComplete(this->Handle) == TRUE)
+                    {
+                        this->bufferedSectors += this->prefetchSectors;
+                        this->prefetchSectors = 0;
+                    }
+                    else if (!wait)
+                    {
+                        break;
+                    }
+                }
+
+                return true;
+            }
+
+            /** @brief Make sure sector is loaded in the buffer
+             * @param sector File sector
+             * @return true if sector is loaded
+             */
+            bool LoadSector(int32_t sector)
+            {
+                if (this->workBuffer == nullptr)
+                {
+                    this->workBuffer = new (this->readAheadZone) uint8_t[this->readAheadSectors * this->Size.SectorSize];
+
+                    if (this->workBuffer == nullptr)
+                    {
+                        return false;
+                    }
+
+                    this->ResetBuffer(sector);
+                }
+
+                const int32_t loadedEnd = this->bufferFirstSector + this->bufferedSectors;
+
+                // Sector is already being prefetched, just wait for it, failed prefetch is read again below
+                if (sector >= loadedEnd && sector < loadedEnd + this->prefetchSectors)
+                {
+                    this->UpdatePrefetch(true);
+                }
+
+                for (int32_t attempt = 0; attempt <= SRL_MAX_CD_RETRIES; attempt++)
+                {
+                    if (sector >= this->bufferFirstSector && sector < this->bufferFirstSector + this->bufferedSectors)
+                    {
+                        return true;
+                    }
+
+                    #if defined(SRL_CD_PROFILER)
+                    if (attempt > 0)
+                    {
+                        Profiler::RecordRetry(this->identifier);
+                    }
+                    #endif
+
+                    this->ResetBuffer(sector);
+                    this->StartPrefetch();
+                    this->UpdatePrefetch(true);
+                }
+
+                return sector >= this->bufferFirstSector && sector < this->bufferFirstSector + this->bufferedSectors;
+            }
+
+            /** @brief Get number of whole sectors that can be transferred straight into the destination
+             * @details Sectors already loaded or being prefetched are taken from the buffer instead, Gfs can only transfer into 4 byte aligned memory
+             * @param sector First sector to read
+             * @param size Number of bytes left to read
+             * @param destination Where the sector would be transferred
+             * @return Number of sectors, 0 if the buffer has to be used
+             */
+            int32_t GetDirectSectors(int32_t sector, int32_t size, const uint8_t* destination)
+            {
+                if ((reinterpret_cast<uint32_t>(destination) & 3) != 0 ||
+                    this->readBytes != sector * this->Size.SectorSize ||
+                    (sector >= this->bufferFirstSector && sector < this->bufferFirstSector + this->bufferedSectors + this->prefetchSectors))
+                {
+                    return 0;
+                }
+
+                // Partial last sector of the file goes through the buffer as well
+                return SRL::Math::Min<int32_t>(size, this->Size.Bytes - this->readBytes) / this->Size.SectorSize;
+            }
+
+            /** @brief Transfer whole sectors straight into the destination
+             * @details Buffer continues right after the transferred sectors
+             * @param sector First sector to read
+             * @param count Number of sectors
+             * @param destination Where to transfer sectors, must be 4 byte aligned
+             * @return true if all sectors were read
+             */
+            bool ReadDirect(int32_t sector, int32_t count, uint8_t* destination)
+            {
+                const int32_t size = count * this->Size.SectorSize;
+
+                // Handle can serve only one read at a time
+                this->ResetBuffer(sector + count);
+
+                #if defined(SRL_CD_PROFILER)
+                Profiler::RecordTransfer(this->identifier, sector, count);
+                #endif
+
+                for (int32_t attempt = 0; attempt <= SRL_MAX_CD_RETRIES; attempt++)
+                {
+                    #if defined(SRL_CD_PROFILER)
+                    if (attempt > 0)
+                    {
+                        Profiler::RecordRetry(this->identifier);
+                    }
+                    #endif
+
+                    if (GFS_Seek(this->Handle, sector, Cd::SeekMode::Absolute) >= 0 &&
+                        GFS_Fread(this->Handle, count, destination, size) == size)
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+        public:
+            /** @brief File handle
+             */
+            GfsHn Handle;
+
+            /** @brief Size of the file
+             */
+            FileSize Size;
+
+            /** @brief disable default constructor
+             */
+            File() = delete;
+
+            /** @brief Construct a new File object from Gfs handle and identifier
+             * @param handle Gfs handle
+             * @param fid File identifier
+             * @param getSize Fetch file size (will cause file to be open for a bit)
+             */
+            File(GfsHn handle, int32_t fid, bool getSize = true) : Handle(handle),
+                                                                   Size(getSize ? FileSize(handle) : FileSize()),
+                                                                   identifier(fid),
+                                                                   workBuffer(nullptr),
+                                                                   readBytes(0),
+                                                                   readAheadSectors(File::DefaultReadAheadSectors),
+                                                                   readAheadZone(Memory::Zone::HWRam),
+                                                                   bufferFirstSector(0),
+                                                                   bufferHead(0),
+                                                                   bufferedSectors(0),
+                                                                   prefetchSectors(0)
+            {
+                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
+                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
+                #endif
+            }
+
+            /** @brief Open a file on CD
+             * @param name File name
+             */
+            File(const char *name) : Handle(nullptr),
+                                     Size(0),
+                                     identifier(-1),
+                                     workBuffer(nullptr),
+                                     readBytes(0),
+                                     readAheadSectors(File::DefaultReadAheadSectors),
+                                     readAheadZone(Memory::Zone::HWRam),
+                                     bufferFirstSector(0),
+                                     bufferHead(0),
+                                     bufferedSectors(0),
+                                     prefetchSectors(0)
+            {
+                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
+                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
+                #endif
+
+                if (name != nullptr)
+                {
+                    int32_t sectorSize;
+                    int32_t sectorCount;
+                    int32_t lastSectorSize;
+                    int32_t id = Cd::GetFileId(name);
+
+                    if (id >= 0)
+                    {
+                        this->identifier = id;
+
+                        if (this->Open())
+                        {
+                            this->Size = FileSize(this->Handle);
+                            this->Close();
+                        }
+                        else
+                        {
+                            this->identifier = -1;
+                        }
+                    }
+                }
+            }
+
+            /** @brief Close file
+             */
+            ~File()
+            {
+                this->Close();
+            }
+
+            /**
+             * @name File handling and status
+             * @{
+             */
+
+            /** @brief Close file
+             */
+            void Close()
+            {
+                ReadRequest* pending = Cd::GetPendingRequest(this);
+
+                if (pending != nullptr)
+                {
+                    pending->Cancel();
+                }
+
+                this->ResetBuffer(0);
+
+                if (this->Handle != nullptr)
+                {
+                    GFS_Close(this->Handle);
+                    this->Handle = nullptr;
+                }
+
+                if (this->workBuffer != nullptr)
+                {
+                    delete[] this->workBuffer;
+                    this->workBuffer = nullptr;
+                }
+            }
+
+            /** @brief Open file
+             * @return True on success
+             */
+            bool Open()
+            {
+                #if defined(SRL_CD_PROFILER)
+                Profiler::Measure measure(Profiler::Operation::Open, this->identifier);
+                #endif
+
+                if (this->IsOpen())
+                {
+                    return true;
+                }
+                else if (this->identifier >= 0)
+                {
+                    this->readBytes = 0;
+                    this->Handle = GFS_Open(this->identifier);
+                }
+
+                #if defined(SRL_CD_PROFILER)
+                measure.SetResult(this->Handle != nullptr ? 0 : -1);
+                #endif
+
+                return this->Handle != nullptr;
+            }
+
+            /** @brief Set size and location of the read-ahead buffer used by Read()
+             * @details Larger buffer lets the drive stream more data between reads, which helps sustained reading of FMV or audio.
+             * Currently buffered data are discarded.
+             * @note Frame zone is not allowed, buffer must outlive the frame
+             * @param sectors Buffer size in sectors (at least 1)
+             * @param zone Memory zone to allocate the buffer in
+             * @return true if the buffer was set
+             */
+            bool SetReadAhead(uint16_t sectors, Memory::Zone zone = Memory::Zone::HWRam)
+            {
+                if (sectors == 0 || zone == Memory::Zone::Frame)
+                {
+                    return false;
+                }
+
+                this->ResetBuffer(0);
+
+                if (this->workBuffer != nullptr)
+                {
+                    delete[] this->workBuffer;
+                    this->workBuffer = nullptr;
+                }
+
+                this->readAheadSectors = sectors;
+                this->readAheadZone = zone;
+                return true;
+            }
+
+            /** @brief Get size of the read-ahead buffer
+             * @return Buffer size in sectors
+             */
+            constexpr uint16_t GetReadAheadSectors()
+            {
+                return this->readAheadSectors;
+            }
+
+            /** @brief Transfer data prefetched by the drive into the read-ahead buffer without blocking
+             * @details Calling this once per frame while streaming keeps the buffer filled between calls to Read()
+             */
+            void UpdateReadAhead()
+            {
+                if (this->IsOpen() && this->workBuffer != nullptr && this->UpdatePrefetch(false))
+                {
+                    this->StartPrefetch();
+                }
+            }
+
+            /** @brief File exists
+             * @return True if exists
+             */
+            constexpr bool Exists()
+            {
+                return this->identifier >= 0;
+            }
+
+            /** @brief Gets the current position in the file
+             * @return Position in the file as bytes
+             */
+            constexpr size_t GetCurrentPosition()
+            {
+                return this->readBytes;
+            }
+
+            /** @brief File is open
+             * @return True if file is open
+             */
+            constexpr bool IsOpen()
+            {
+                return this->Exists() && this->Handle != nullptr;
+            }
 
             /** @brief EOF has been reached
+             * @note Derived from the file access pointer, prefetch reaching end of the file ahead of it does not count
              * @return true if EOF, false otherwise
              */
-            constexpr bool IsEOF()
+            constexpr bool IsEOF()
+            {
+                return this->readBytes >= this->Size.Bytes;
+            }
+
+            /**
+             * @}
+             */
+
+            /**
+             * @name File reading
+             * @{
+             */
+
+            /** @brief Loads specified amount of bytes from a file
+             * @note This function does not need file to be open
+             * @param sectorOffset Number of sectors to skip at the start
+             * @param size Number of bytes to read (length of the batch)
+             * @param destination Buffer to read batch into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t LoadBytes(size_t sectorOffset, int32_t size, void *destination)
+            {
+                #if defined(SRL_CD_PROFILER)
+                Profiler::Measure measure(Profiler::Operation::LoadBytes, this->identifier);
+                #endif
+
+                bool wasOpen = false;
+                int32_t result = 0;
+
+                if (this->identifier >= 0)
+                {
+                    if (this->IsOpen())
+                    {
+                        this->Close();
+                        wasOpen = true;
+                    }
+
+                    // This function reads whole file, file does not need to be opened
+                    result = GFS_Load(this->identifier, sectorOffset, destination, size);
+
+                    #if defined(SRL_CD_PROFILER)
+                    Profiler::RecordTransfer(this->identifier, sectorOffset, (result + this->Size.SectorSize - 1) / this->Size.SectorSize);
+                    #endif
+
+                    // Open again
+                    if (wasOpen)
+                    {
+                        this->Open();
+                    }
+                }
+
+                #if defined(SRL_CD_PROFILER)
+                measure.SetResult(result);
+                #endif
+
+                return result;
+            }
+
+            /** @brief Read specified number of bytes from the file and advances file access pointer
+             * @details Whole sectors that are not buffered yet are transferred by Gfs straight into the destination (when it is 4 byte aligned),
+             * only unaligned start and end of the read go through the read-ahead buffer. Destination can be in any memory Gfs can write to, including VRAM and sound RAM.
+             * @param size Number of bytes to read
+             * @param destination Buffer to read bytes into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t Read(int32_t size, void *destination)
+            {
+                #if defined(SRL_CD_PROFILER)
+                Profiler::Measure measure(Profiler::Operation::Read, this->identifier);
+                measure.SetResult(-1);
+                #endif
+
+                if (this->IsOpen() && size > 0 && this->Size.Bytes > 0 && Cd::GetPendingRequest(this) == nullptr)
+                {
+                    int32_t currentlyRead = 0;
+
+                    while (currentlyRead < size && this->readBytes < this->Size.Bytes)
+                    {
+                        const int32_t sector = this->readBytes / this->Size.SectorSize;
+                        uint8_t* target = reinterpret_cast<uint8_t*>(destination) + currentlyRead;
+                        const int32_t directSectors = this->GetDirectSectors(sector, size - currentlyRead, target);
+
+                        // Whole sectors skip the buffer, only unaligned head and tail are copied
+                        if (directSectors > 0)
+                        {
+                            if (!this->ReadDirect(sector, directSectors, target))
+                            {
+                                return -1;
+                            }
+
+                            this->readBytes += directSectors * this->Size.SectorSize;
+                            currentlyRead += directSectors * this->Size.SectorSize;
+                            continue;
+                        }
+
+                        if (!this->LoadSector(sector))
+                        {
+                            return -1;
+                        }
+
+                        // Copy everything loaded up to the physical end of the ring at once
+                        const int32_t slot = (this->bufferHead + (sector - this->bufferFirstSector)) % this->readAheadSectors;
+                        const int32_t sectors = SRL::Math::Min<int32_t>(
+                            this->bufferFirstSector + this->bufferedSectors - sector,
+                            this->readAheadSectors - slot);
+                        const int32_t sectorOffset = this->readBytes - (sector * this->Size.SectorSize);
+                        const int32_t toRead = SRL::Math::Min<int32_t>(
+                            SRL::Math::Min<int32_t>((sectors * this->Size.SectorSize) - sectorOffset, size - currentlyRead),
+                            this->Size.Bytes - this->readBytes);
+
+                        Memory::MemCopy(
+                            target,
+                            this->workBuffer + (slot * this->Size.SectorSize) + sectorOffset,
+                            toRead);
+
+                        // Set state
+                        this->readBytes += toRead;
+                        currentlyRead += toRead;
+                    }
+
+                    // Keep the drive busy while caller processes the data
+                    this->UpdateReadAhead();
+
+                    #if defined(SRL_CD_PROFILER)
+                    measure.SetResult(currentlyRead);
+                    #endif
+
+                    return currentlyRead;
+                }
+
+                return -1;
+            }
+
+            /** @brief Read specified number of sectors from the file and advances file access pointer
+             * @param sectorCount Number of sectors to be read from file
+             * @param destination Buffer to read bytes into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t ReadSectors(const int32_t sectorCount, void* destination)
+            {
+                #if defined(SRL_CD_PROFILER)
+                Profiler::Measure measure(Profiler::Operation::ReadSectors, this->identifier);
+                #endif
+
+                if (this->IsOpen() && !this->IsEOF() && sectorCount > 0)
+                {
+                    // Handle can serve only one read at a time
+                    this->StopPrefetch();
+
+                    // Sector the access pointer is in, Gfs pointer could have been moved by prefetch or left behind by Seek()
+                    const int32_t currentSector = this->readBytes / this->Size.SectorSize;
+                    const auto toRead = SRL::Math::Min<int32_t>(sectorCount, this->Size.Sectors - currentSector);
+                    
+                    if (toRead > 0)
+                    {
+                        auto read = GFS_Seek(this->Handle, currentSector, Cd::SeekMode::Absolute) >= 0 ?
+                            GFS_Fread(this->Handle, toRead, destination, this->Size.SectorSize * toRead) :
+                            -1;
+
+                        #if defined(SRL_CD_PROFILER)
+                        Profiler::RecordTransfer(this->identifier, currentSector, toRead);
+                        #endif
+
+                        for (int32_t retry = 0; read < 0 && retry < SRL_MAX_CD_RETRIES; retry++)
+                        {
+                            #if defined(SRL_CD_PROFILER)
+                            Profiler::RecordRetry(this->identifier);
+                            #endif
+
+                            if (GFS_Seek(this->Handle, currentSector, Cd::SeekMode::Absolute) >= 0)
+                            {
+                                read = GFS_Fread(this->Handle, toRead, destination, this->Size.SectorSize * toRead);
+                            }
+                        }
+
+                        // Advance read pointer
+                        if (read >= 0)
+                        {
+                            this->readBytes = (currentSector * this->Size.SectorSize) + read;
+                        }
+
+                        #if defined(SRL_CD_PROFILER)
+                        measure.SetResult(read);
+                        #endif
+
+                        return read;
+                    }
+                }
+
+                return 0;
+            }
+
+            /** @brief Start reading specified number of bytes from the current sector without blocking
+             * @details Read starts at the beginning of the sector the file access pointer is in.
+             * Request is advanced once per frame, or by calling ReadRequest::Wait().
+             * File access pointer is moved past the read data once the request completes, same as with ReadSectors().
+             * @note File must not be read by other means until the request is done
+             * @param size Number of bytes to read
+             * @param destination Buffer to read bytes into (must be large enough to hold whole sectors)
+             * @return Read request, nullptr if the read could not be started
+             */
+            ReadRequest* ReadAsync(int32_t size, void* destination)
+            {
+                if (!this->IsOpen() || size <= 0 || destination == nullptr || Cd::GetPendingRequest(this) != nullptr)
+                {
+                    return nullptr;
+                }
+
+                ReadRequest* request = Cd::AcquireRequest(this, size, destination, ReadRequest::Priority::High);
+
+                if (request != nullptr && !Cd::StartRequest(*request))
+                {
+                    request->file = nullptr;
+                    return nullptr;
+                }
+
+                return request;
+            }
+
+            /** @brief Queue read of specified number of bytes from the current sector
+             * @details Request waits until the drive is idle, requests queued in the same frame are reordered by priority and position on the disc.
+             * File does not have to be open, in that case it is opened only while the drive reads it and reading starts at the beginning of the file.
+             * Such request also waits until a Gfs file handle is free, at most SRL_MAX_CD_BACKGROUND_JOBS files can be open at once.
+             * Access pointer of open file is moved past the read data once the request completes, same as with ReadAsync().
+             * @note File must not be read by other means until the request is done
+             * @param size Number of bytes to read
+             * @param destination Buffer to read bytes into (must be large enough to hold whole sectors)
+             * @param priority Priority class of the request
+             * @return Read request, nullptr if request queue is full
+             */
+            ReadRequest* QueueRead(int32_t size, void* destination, ReadRequest::Priority priority = ReadRequest::Priority::Normal)
+            {
+                if (this->identifier < 0 || size <= 0 || destination == nullptr || Cd::GetPendingRequest(this) != nullptr)
+                {
+                    return nullptr;
+                }
+
+                ReadRequest* request = Cd::AcquireRequest(this, size, destination, priority);
+
+                if (request != nullptr)
+                {
+                    request->status = ReadRequest::Status::Queued;
+                }
+
+                return request;
+            }
+
+            /** @brief Seek file access pointer to specific byte
+             * @param offset offset from start of the file
+             * @return New position of the access pointer otherwise negative on error
+             */
+            int32_t Seek(int32_t offset)
             {
-                return (GFS_IsEof(Handle) == TRUE);
+                #if defined(SRL_CD_PROFILER)
+                Profiler::Measure measure(Profiler::Operation::Seek, this->identifier);
+                #endif
+
+                if (this->IsOpen() && offset >= 0 && offset < this->Size.Bytes)
+                {
+                    // Data are loaded on next read, target that is already buffered or being prefetched does not touch the disc
+                    this->readBytes = offset;
+                    return offset;
+                }
+
+                #if defined(SRL_CD_PROFILER)
+                measure.SetResult(-1);
+                #endif
+
+                return -1;
             }
 
             /**
@@ -385,234 +2048,733 @@ namespace SRL
              */
 
             /**
-             * @name File reading
+             * @name Other
              * @{
              */
 
-            /** @brief Loads specified amount of bytes from a file
-             * @note This function does not need file to be open
-             * @param sectorOffset Number of sectors to skip at the start
-             * @param size Number of bytes to read (length of the batch)
-             * @param destination Buffer to read batch into
+            /** @brief
+             * @return Current state of file access pointer
+             */
+            int32_t GetCurrentAccessPointer()
+            {
+                return this->IsOpen() ? this->readBytes : -1;
+            }
+
+            /** @brief Get file identifier
+             * @return File identifier
+             */
+            constexpr int32_t GetIdentifier()
+            {
+                return this->identifier;
+            }
+
+            /** @brief Get number sectors take by specified byte count for this file
+             * @param bytes Number of bytes
+             * @return Number of sectors, -1 on error
+             */
+            int32_t GetSectorCount(size_t bytes)
+            {
+                if (this->IsOpen())
+                {
+                    return GFS_ByteToSct(this->Handle, bytes);
+                }
+
+                return -1;
+            }
+
+            /**
+             * @}
+             */
+        };
+
+        /** @brief Compute case insensitive hash of a file name
+         * @param name File name
+         * @return 32-bit FNV-1a hash of upper case name
+         */
+        constexpr inline static uint32_t HashName(const char* name)
+        {
+            return Cd::HashName(name, static_cast<size_t>(-1));
+        }
+
+        /** @brief Compute case insensitive hash of a file name that does not have to be terminated
+         * @param name File name
+         * @param length Maximal length of the name
+         * @return 32-bit FNV-1a hash of upper case name
+         */
+        constexpr inline static uint32_t HashName(const char* name, size_t length)
+        {
+            uint32_t hash = 2166136261u;
+
+            while (name != nullptr && length-- > 0 && *name != '\0')
+            {
+                const char character = *name++;
+                hash ^= static_cast<uint8_t>(character >= 'a' && character <= 'z' ? character - ('a' - 'A') : character);
+                hash *= 16777619u;
+            }
+
+            return hash;
+        }
+
+        /** @brief Packed asset archive
+         * @details Archive is a single file on disc holding many assets, created by tools/scripts/srl_pack.py.
+         * Table of contents is read once when archive is opened, assets are then served without any further directory lookups.
+         * Assets placed next to each other by the packer can be loaded with a single contiguous read using LoadRange().
+         *
+         * Layout (all numbers are big endian):
+         * | Offset | Content |
+         * | ------ | ------- |
+         * | 0      | Archive::Header |
+         * | 16     | Archive::Entry for each asset |
+         * | Header::DataOffset | Asset data, padded to sector size |
+         *
+         * @code {.cpp}
+         * SRL::Cd::Archive archive("SPRITES.PAK");
+         * SRL::Cd::Archive::View view = archive.Open("PLAYER.TGA");
+         *
+         * if (view.IsOpen())
+         * {
+         *      view.Read(view.GetSize(), buffer);
+         * }
+         * @endcode
+         */
+        class Archive
+        {
+        public:
+            /** @brief Archive format version this library understands
+             */
+            inline static const uint16_t Version = 1;
+
+            /** @brief Size of asset name field, names are always zero terminated
+             */
+            inline static const uint16_t MaxNameLength = 20;
+
+            /** @brief Archive file header
+             */
+            struct Header
+            {
+                /** @brief Archive identifier, must be "SRLA"
+                 */
+                char Magic[4];
+
+                /** @brief Format version
+                 */
+                uint16_t Version;
+
+                /** @brief Number of assets in the archive
+                 */
+                uint16_t EntryCount;
+
+                /** @brief Start of asset data in bytes, always aligned to sector size
+                 */
+                uint32_t DataOffset;
+
+                /** @brief Size of asset data in bytes
+                 */
+                uint32_t DataSize;
+            };
+
+            /** @brief Table of contents entry
+             */
+            struct Entry
+            {
+                /** @brief Hash of the asset name (see Cd::HashName())
+                 */
+                uint32_t Hash;
+
+                /** @brief Offset of the asset data from Header::DataOffset
+                 */
+                uint32_t Offset;
+
+                /** @brief Size of the asset in bytes
+                 */
+                uint32_t Size;
+
+                /** @brief Upper case asset name
+                 */
+                char Name[Archive::MaxNameLength];
+            };
+
+            /** @brief Read-only view of a single asset inside archive
+             * @details View mirrors reading part of the Cd::File interface, all views share file of the archive
+             */
+            class View
+            {
+            private:
+                /** @brief Archive creates views
+                 */
+                friend class Archive;
+
+                /** @brief Archive the asset belongs to
+                 */
+                Archive* archive;
+
+                /** @brief Asset entry
+                 */
+                const Entry* entry;
+
+                /** @brief Position within the asset
+                 */
+                int32_t position;
+
+                /** @brief Construct a new view
+                 * @param archive Archive the asset belongs to
+                 * @param entry Asset entry (nullptr for invalid view)
+                 */
+                View(Archive* archive, const Entry* entry) : archive(archive), entry(entry), position(0)
+                {
+                }
+
+            public:
+                /** @brief View points to an existing asset
+                 * @return true if asset can be read
+                 */
+                constexpr bool IsOpen()
+                {
+                    return this->entry != nullptr;
+                }
+
+                /** @brief Get asset name
+                 * @return Asset name, nullptr if view is not open
+                 */
+                constexpr const char* GetName()
+                {
+                    return this->IsOpen() ? this->entry->Name : nullptr;
+                }
+
+                /** @brief Get asset size
+                 * @return Number of bytes
+                 */
+                constexpr int32_t GetSize()
+                {
+                    return this->IsOpen() ? this->entry->Size : 0;
+                }
+
+                /** @brief Gets the current position in the asset
+                 * @return Position in the asset as bytes
+                 */
+                constexpr int32_t GetCurrentPosition()
+                {
+                    return this->position;
+                }
+
+                /** @brief End of the asset has been reached
+                 * @return true if whole asset was read
+                 */
+                constexpr bool IsEOF()
+                {
+                    return this->position >= this->GetSize();
+                }
+
+                /** @brief Read specified number of bytes from the asset and advances access pointer
+                 * @param size Number of bytes to read
+                 * @param destination Buffer to read bytes into
+                 * @return Number of bytes read (if lower than 0, error was encountered)
+                 */
+                int32_t Read(int32_t size, void* destination)
+                {
+                    if (!this->IsOpen() || size < 0)
+                    {
+                        return -1;
+                    }
+
+                    size = SRL::Math::Min<int32_t>(size, this->GetSize() - this->position);
+
+                    if (size <= 0)
+                    {
+                        return 0;
+                    }
+
+                    File& file = this->archive->file;
+
+                    if (file.Seek(this->archive->dataOffset + this->entry->Offset + this->position) < 0)
+                    {
+                        return -1;
+                    }
+
+                    const int32_t read = file.Read(size, destination);
+
+                    if (read > 0)
+                    {
+                        this->position += read;
+                    }
+
+                    return read;
+                }
+
+                /** @brief Seek access pointer to specific byte
+                 * @param offset Offset from start of the asset
+                 * @return New position of the access pointer otherwise negative on error
+                 */
+                int32_t Seek(int32_t offset)
+                {
+                    if (this->IsOpen() && offset >= 0 && offset < this->GetSize())
+                    {
+                        this->position = offset;
+                        return offset;
+                    }
+
+                    return -1;
+                }
+            };
+
+        private:
+            /** @brief Archive file
+             */
+            File file;
+
+            /** @brief Table of contents
+             */
+            Entry* entries;
+
+            /** @brief Number of assets
+             */
+            uint16_t entryCount;
+
+            /** @brief Start of asset data in archive file
+             */
+            int32_t dataOffset;
+
+            /** @brief Compare stored asset name with requested one
+             * @param stored Upper case name from table of contents
+             * @param name Requested name (case insensitive)
+             * @return true if names match
+             */
+            static bool NameEquals(const char* stored, const char* name)
+            {
+                for (uint16_t index = 0; index < Archive::MaxNameLength; index++)
+                {
+                    const char character = name[index] >= 'a' && name[index] <= 'z' ? name[index] - ('a' - 'A') : name[index];
+
+                    if (stored[index] != character)
+                    {
+                        return false;
+                    }
+                    else if (character == '\0')
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+        public:
+            /** @brief Open archive and read its table of contents
+             * @param name Archive file name
+             */
+            Archive(const char* name) : file(name), entries(nullptr), entryCount(0), dataOffset(0)
+            {
+                Header header;
+
+                if (!this->file.Open() || this->file.Read(sizeof(Header), &header) != sizeof(Header))
+                {
+                    this->file.Close();
+                    return;
+                }
+
+                if (header.Magic[0] != 'S' || header.Magic[1] != 'R' || header.Magic[2] != 'L' || header.Magic[3] != 'A' ||
+                    header.Version != Archive::Version ||
+                    static_cast<int32_t>(header.DataOffset + header.DataSize) > this->file.Size.Bytes)
+                {
+                    this->file.Close();
+                    return;
+                }
+
+                if (header.EntryCount > 0)
+                {
+                    const int32_t tocSize = header.EntryCount * sizeof(Entry);
+                    this->entries = autonew Entry[header.EntryCount];
+
+                    if (this->entries == nullptr || this->file.Read(tocSize, this->entries) != tocSize)
+                    {
+                        delete[] this->entries;
+                        this->entries = nullptr;
+                        this->file.Close();
+                        return;
+                    }
+                }
+
+                this->entryCount = header.EntryCount;
+                this->dataOffset = header.DataOffset;
+            }
+
+            /** @brief Close archive
+             */
+            ~Archive()
+            {
+                if (this->entries != nullptr)
+                {
+                    delete[] this->entries;
+                }
+            }
+
+            /** @brief Archive was opened and its table of contents is valid
+             * @return true if archive can be read
+             */
+            constexpr bool IsOpen()
+            {
+                return this->file.Handle != nullptr;
+            }
+
+            /** @brief Get archive file, for example to configure its read-ahead buffer
+             * @return Archive file
+             */
+            File& GetFile()
+            {
+                return this->file;
+            }
+
+            /** @brief Get number of assets in archive
+             * @return Number of assets
+             */
+            constexpr uint16_t GetEntryCount()
+            {
+                return this->entryCount;
+            }
+
+            /** @brief Get table of contents entry
+             * @param index Asset index
+             * @return Entry or nullptr if index is out of range
+             */
+            constexpr const Entry* GetEntry(uint16_t index)
+            {
+                return index < this->entryCount ? &this->entries[index] : nullptr;
+            }
+
+            /** @brief Find asset by name
+             * @param name Asset name (case insensitive)
+             * @return Asset index, -1 if not found
+             */
+            int32_t Find(const char* name)
+            {
+                const uint32_t hash = Cd::HashName(name);
+
+                for (uint16_t index = 0; index < this->entryCount; index++)
+                {
+                    if (this->entries[index].Hash == hash && Archive::NameEquals(this->entries[index].Name, name))
+                    {
+                        return index;
+                    }
+                }
+
+                return -1;
+            }
+
+            /** @brief Open view of an asset
+             * @param index Asset index
+             * @return Asset view, check View::IsOpen() for success
+             */
+            View Open(uint16_t index)
+            {
+                return View(this, this->GetEntry(index));
+            }
+
+            /** @brief Open view of an asset
+             * @param name Asset name (case insensitive)
+             * @return Asset view, check View::IsOpen() for success
+             */
+            View Open(const char* name)
+            {
+                const int32_t index = this->Find(name);
+                return View(this, index >= 0 ? this->GetEntry(index) : nullptr);
+            }
+
+            /** @brief Get number of bytes LoadRange() needs for a range of assets
+             * @param first Index of the first asset
+             * @param count Number of assets
+             * @return Number of bytes including padding between assets, -1 on invalid range
+             */
+            int32_t GetRangeSize(uint16_t first, uint16_t count)
+            {
+                if (count == 0 || first + count > this->entryCount)
+                {
+                    return -1;
+                }
+
+                const Entry& last = this->entries[first + count - 1];
+                return (last.Offset + last.Size) - this->entries[first].Offset;
+            }
+
+            /** @brief Load whole asset
+             * @param index Asset index
+             * @param destination Buffer to load asset into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t Load(uint16_t index, void* destination)
+            {
+                return this->LoadRange(index, 1, destination);
+            }
+
+            /** @brief Load range of neighboring assets with single contiguous read
+             * @details Asset N of the range starts at GetEntry(N)->Offset - GetEntry(first)->Offset in the destination buffer
+             * @param first Index of the first asset
+             * @param count Number of assets
+             * @param destination Buffer of at least GetRangeSize() bytes
              * @return Number of bytes read (if lower than 0, error was encountered)
              */
-            int32_t LoadBytes(size_t sectorOffset, int32_t size, void *destination)
+            int32_t LoadRange(uint16_t first, uint16_t count, void* destination)
             {
-                bool wasOpen = false;
-                int32_t result = 0;
+                const int32_t size = this->GetRangeSize(first, count);
 
-                if (this->identifier >= 0)
+                if (!this->IsOpen() || size < 0)
                 {
-                    if (this->IsOpen())
-                    {
-                        this->Close();
-                        wasOpen = true;
-                    }
-
-                    // This function reads whole file, file does not need to be opened
-                    result = GFS_Load(this->identifier, sectorOffset, destination, size);
+                    return -1;
+                }
+                else if (size == 0)
+                {
+                    return 0;
+                }
 
-                    // Open again
-                    if (wasOpen)
-                    {
-                        this->Open();
-                    }
+                if (this->file.Seek(this->dataOffset + this->entries[first].Offset) < 0)
+                {
+                    return -1;
                 }
 
-                return result;
+                return this->file.Read(size, destination);
             }
+        };
 
-            /** @brief Read specified number of bytes from the file and advances file access pointer
-             * @param size Number of bytes to read
-             * @param destination Buffer to read bytes into
-             * @return Number of bytes read (if lower than 0, error was encountered)
+        /** @brief Interleaved data stream played by the SGL stream system
+         * @details Stream reads a file once from start to end, sectors are sorted into channels by the channel number in their subheader,
+         * so a single file can carry video frames, audio and game data at once. Every channel gets its own transfer buffer,
+         * data transferred into it are handed over by OnData event once per frame and the buffer is then reused.
+         * Drive keeps sectors that did not fit in the CD block buffer, so only a few sectors per channel have to live in RAM.
+         * Only one stream can play at a time.
+         * @note Data passed to OnData are valid only during the call, drive must not be used by other reads while stream plays
+         * @code {.cpp}
+         * SRL::Cd::Stream stream("MOVIE.STM");
+         * int8_t video = stream.AddChannel(0, 8);
+         * int8_t audio = stream.AddChannel(1, 4, SRL::Memory::Zone::LWRam);
+         * stream.OnData += HandleStreamData;
+         * stream.Start();
+         * @endcode
+         */
+        class Stream
+        {
+        public:
+            /** @brief Maximal number of channels in one stream
              */
-            int32_t Read(int32_t size, void *destination)
-            {
-                int32_t workBufferSize = this->Size.SectorSize * File::SectorsToReadAtOnce;
+            inline static const uint8_t MaxChannels = 8;
 
-                if (this->IsOpen() && size > 0 && this->Size.Bytes > 0)
-                {
-                    int32_t currentlyRead = 0;
+            /** @brief Channel number that accepts every sector of the file, used for files that are not interleaved
+             */
+            inline static const int16_t AnyChannel = STM_KEY_NONE;
 
-                    // We have not read any data yet
-                    if (this->workBuffer == nullptr)
-                    {
-                        this->workBuffer = autonew uint8_t[workBufferSize];
+        private:
+            /** @brief Stream channel
+             */
+            struct Channel
+            {
+                /** @brief Stream system handle
+                 */
+                StmHn Handle;
 
-                        // Refresh data for new sector
-                        int32_t error = GFS_Fread(this->Handle, File::SectorsToReadAtOnce, this->workBuffer, workBufferSize);
+                /** @brief Transfer buffer
+                 */
+                uint8_t* Buffer;
+            };
 
-                        if (error < 0)
-                        {
-                            delete[] this->workBuffer;
-                            this->workBuffer = nullptr;
-                            return -1;
-                        }
-                    }
+            /** @brief Work area of the stream system
+             */
+            inline static uint32_t work[STM_WORK_SIZE(1, Stream::MaxChannels) / sizeof(uint32_t)];
 
-                    // Read data sector by sector
-                    while (currentlyRead < size && this->readBytes < this->Size.Bytes)
-                    {
-                        // Current location within the sector
-                        const int32_t sectorStartOffset = this->GetOffsetInWorkBuffer(this->readBytes, workBufferSize);
+            /** @brief Stream system was initialized
+             */
+            inline static bool isInitialized = false;
 
-                        int32_t toRead = size - currentlyRead;
+            /** @brief Stream that is currently playing
+             */
+            inline static Stream* active = nullptr;
 
-                        // We can't read more than one sector at a time
-                        if (toRead >= workBufferSize - sectorStartOffset)
-                        {
-                            // We have read whole sector
-                            toRead = workBufferSize - sectorStartOffset;
+            /** @brief File identifier
+             */
+            int32_t identifier;
 
-                            // Copy to target buffer
-                            for (int32_t byte = 0; byte < toRead; byte++)
-                            {
-                                reinterpret_cast<uint8_t*>(destination)[currentlyRead + byte] = this->workBuffer[byte + sectorStartOffset];
-                            }
+            /** @brief Stream group holding all channels
+             */
+            StmGrpHn group;
 
-                            // Refresh data for new sector
-                            int32_t error = GFS_Fread(this->Handle, File::SectorsToReadAtOnce, this->workBuffer, workBufferSize);
+            /** @brief Opened channels
+             */
+            Channel channels[Stream::MaxChannels];
 
-                            if (error < 0)
-                            {
-                                delete[] this->workBuffer;
-                                this->workBuffer = nullptr;
-                                return -1;
-                            }
-                        }
-                        else
-                        {
-                            // We have not reached sector bounds, we can just copy bytes over
-                            for (int32_t byte = 0; byte < toRead; byte++)
-                            {
-                                reinterpret_cast<uint8_t*>(destination)[currentlyRead + byte] = this->workBuffer[byte + sectorStartOffset];
-                            }
-                        }
+            /** @brief Number of opened channels
+             */
+            uint8_t channelCount;
 
-                        // Set state
-                        this->readBytes += toRead;
-                        currentlyRead += toRead;
-                    }
+        public:
+            /** @brief Data of a channel were transferred, handler receives channel index, data and size in bytes
+             */
+            SRL::Types::Event<uint8_t, const uint8_t*, int32_t> OnData;
 
-                    return currentlyRead;
-                }
+            /** @brief Disable default constructor
+             */
+            Stream() = delete;
 
-                return -1;
+            /** @brief Prepare stream of a file in current directory
+             * @param name File name
+             */
+            Stream(const char* name) : identifier(name != nullptr ? Cd::GetFileId(name) : -1), group(nullptr), channels(), channelCount(0)
+            {
             }
 
-            /** @brief Read specified number of sectors from the file and advances file access pointer
-             * @param sectorCount Number of sectors to be read from file
-             * @param destination Buffer to read bytes into
-             * @return Number of bytes read (if lower than 0, error was encountered)
+            /** @brief Stop the stream and free all channels
              */
-            int32_t ReadSectors(const int32_t sectorCount, void* destination)
+            ~Stream()
             {
-                if (this->IsOpen() && !this->IsEOF() && sectorCount > 0)
-                {
-                    // Number of the current sector offset
-                    const auto currentSector = GFS_Tell(this->Handle);
-                    const auto toRead = SRL::Math::Min<int32_t>(sectorCount, this->Size.Sectors - currentSector);
-                    
-                    if (toRead > 0)
-                    {
-                        const auto read = GFS_Fread(this->Handle, sectorCount, destination, this->Size.SectorSize * toRead);
+                this->Close();
+            }
 
-                        // Advance read pointer
-                        if (read >= 0)
-                        {
-                            this->readBytes = (currentSector * this->Size.SectorSize) + read;
-                        }
+            /** @brief Add channel to the stream, channels must be added before the stream is started
+             * @param channel Subheader channel number, or Stream::AnyChannel to take all sectors of the file
+             * @param sectors Size of the transfer buffer in sectors, must hold data the channel receives during one frame
+             * @param zone Memory zone to allocate transfer buffer in (not Frame)
+             * @return Channel index passed to OnData, -1 on error
+             */
+            int8_t AddChannel(int16_t channel, uint16_t sectors, Memory::Zone zone = Memory::Zone::HWRam)
+            {
+                if (this->identifier < 0 || Stream::active == this || this->channelCount >= Stream::MaxChannels || sectors == 0 || zone == Memory::Zone::Frame)
+                {
+                    return -1;
+                }
 
-                        return read;
-                    }
+                if (!Stream::isInitialized)
+                {
+                    Stream::isInitialized = STM_Init(1, Stream::MaxChannels, Stream::work);
                 }
 
-                return 0;
-            }
+                if (!Stream::isInitialized || (this->group == nullptr && (this->group = STM_OpenGrp()) == nullptr))
+                {
+                    return -1;
+                }
 
-            /** @brief Seek file access pointer to specific byte
-             * @param offset offset from start of the file
-             * @return New position of the access pointer otherwise negative on error
-             */
-            int32_t Seek(int32_t offset)
-            {
-                int32_t result = -1;
-                int32_t workBufferSize = this->Size.SectorSize * File::SectorsToReadAtOnce;
+                Channel& opened = this->channels[this->channelCount];
+                opened.Buffer = new (zone) uint8_t[sectors * STM_UNIT_FORM1];
 
-                if (this->IsOpen() && offset >= 0 && offset < this->Size.Bytes)
+                if (opened.Buffer == nullptr)
                 {
-                    // Initialize read buffer if does not exist yet
-                    if (this->workBuffer == nullptr)
-                    {
-                        this->workBuffer = autonew uint8_t[workBufferSize];
-                    }
-                    
-                    this->readBytes = offset;
-                    int32_t sector = this->GetSectorCount(offset);
+                    return -1;
+                }
 
-                    if (sector >= 0)
-                    {
-                        // Seek to predefined location
-                        result = GFS_Seek(this->Handle, sector, Cd::SeekMode::Absolute);
+                StmKey key;
+                STM_KEY_FN(&key) = STM_KEY_NONE;
+                STM_KEY_CN(&key) = channel;
+                STM_KEY_SMMSK(&key) = STM_KEY_NONE;
+                STM_KEY_SMVAL(&key) = STM_KEY_NONE;
+                STM_KEY_CIMSK(&key) = STM_KEY_NONE;
+                STM_KEY_CIVAL(&key) = STM_KEY_NONE;
 
-                        // Refresh buffer
-                        if (result >= 0 && GFS_Fread(this->Handle, File::SectorsToReadAtOnce, this->workBuffer, workBufferSize) >= 0)
-                        {
-                            return offset;
-                        }
-                        else
-                        {
-                            return -1;
-                        }
-                    }
+                opened.Handle = STM_OpenFid(this->group, this->identifier, &key, STM_LOOP_NOREAD);
+
+                if (opened.Handle == nullptr)
+                {
+                    delete[] opened.Buffer;
+                    opened.Buffer = nullptr;
+                    return -1;
                 }
 
-                return result;
+                STM_SetTrBuf(opened.Handle, opened.Buffer, sectors, STM_UNIT_FORM1);
+                return this->channelCount++;
             }
 
-            /**
-             * @}
+            /** @brief Start playing the stream, data are then delivered once per frame
+             * @return true if stream started
              */
+            bool Start()
+            {
+                if (this->channelCount == 0 || (Stream::active != nullptr && Stream::active != this) || !STM_SetExecGrp(this->group))
+                {
+                    return false;
+                }
 
-            /**
-             * @name Other
-             * @{
+                Stream::active = this;
+                return true;
+            }
+
+            /** @brief Stop the stream and free all channels
              */
+            void Close()
+            {
+                if (Stream::active == this)
+                {
+                    Stream::active = nullptr;
+                }
 
-            /** @brief
-             * @return Current state of file access pointer
+                for (uint8_t index = 0; index < this->channelCount; index++)
+                {
+                    STM_Close(this->channels[index].Handle);
+                    delete[] this->channels[index].Buffer;
+                    this->channels[index] = Channel();
+                }
+
+                this->channelCount = 0;
+
+                if (this->group != nullptr)
+                {
+                    STM_CloseGrp(this->group);
+                    this->group = nullptr;
+                }
+            }
+
+            /** @brief Check whether the stream is playing
+             * @return true if stream was started and was not closed yet
              */
-            int32_t GetCurrentAccessPointer()
+            bool IsPlaying()
             {
-                return this->IsOpen() ? this->readBytes : -1;
+                return Stream::active == this;
             }
 
-            /** @brief Get file identifier
-             * @return File identifier
+            /** @brief Check whether all channels were read to the end of the file
+             * @return true if stream is done
              */
-            constexpr int32_t GetIdentifier()
+            bool IsComplete()
             {
-                return this->identifier;
+                for (uint8_t index = 0; index < this->channelCount; index++)
+                {
+                    if (!STM_IsComplete(this->channels[index].Handle) || STM_GetLenTrBuf(this->channels[index].Handle) > 0)
+                    {
+                        return false;
+                    }
+                }
+
+                return this->channelCount > 0;
             }
 
-            /** @brief Get number sectors take by specified byte count for this file
-             * @param bytes Number of bytes
-             * @return Number of sectors, -1 on error
+            /** @brief Run the stream server and deliver transferred data
+             * @details Called once per frame for the playing stream, can be called more often to speed up the transfer
              */
-            int32_t GetSectorCount(size_t bytes)
+            void Update()
             {
-                if (this->IsOpen())
+                if (Stream::active != this)
                 {
-                    return GFS_ByteToSct(this->Handle, bytes);
+                    return;
                 }
 
-                return -1;
+                STM_ExecServer();
+
+                for (uint8_t index = 0; index < this->channelCount; index++)
+                {
+                    const StmHn handle = this->channels[index].Handle;
+                    const int32_t words = STM_GetLenTrBuf(handle);
+
+                    if (words > 0)
+                    {
+                        // Length is in stream system words, convert it through the size of one sector
+                        this->OnData.Invoke(index, this->channels[index].Buffer, (words * STM_UNIT_FORM1) / STM_SctToWord(handle, 1));
+                        STM_ResetTrBuf(handle);
+                    }
+                }
             }
 
-            /**
-             * @}
+            /** @brief Update the playing stream
              */
+            inline static void UpdateActive()
+            {
+                if (Stream::active != nullptr)
+                {
+                    Stream::active->Update();
+                }
+            }
         };
 
         /** @brief Initialize file handling stuff
@@ -622,16 +2784,106 @@ namespace SRL
         {
             if (!Cd::isInitialized)
             {
+                #if defined(SRL_CD_PROFILER)
+                Profiler::Initialize();
+                Profiler::Measure measure(Profiler::Operation::Initialize, -1);
+                #endif
+
                 // Initialize GFS
                 GFS_DIRTBL_TYPE(&Cd::GfsDirectories) = GFS_DIR_NAME;
                 GFS_DIRTBL_DIRNAME(&Cd::GfsDirectories) = Cd::GfsDirectoryNames;
                 GFS_DIRTBL_NDIR(&Cd::GfsDirectories) = SRL_MAX_CD_FILES;
                 Cd::isInitialized = (GFS_Init(SRL_MAX_CD_BACKGROUND_JOBS, Cd::GfsWork, &Cd::GfsDirectories) <= 2);
+                Cd::IndexDirectory(Cd::GfsDirectoryNames, SRL_MAX_CD_FILES);
+
+                #if defined(SRL_CD_PROFILER)
+                measure.SetResult(Cd::isInitialized ? 0 : -1);
+                #endif
             }
             
             return Cd::isInitialized;
         }
 
+        /** @brief Advance all pending asynchronous reads and start queued reads once the drive is idle
+         * @details Called once per frame after synchronization, can be called more often to speed up the reading
+         */
+        inline static void ProcessRequests()
+        {
+            bool busy = false;
+
+            for (ReadRequest& request : Cd::readRequests)
+            {
+                if (request.status != ReadRequest::Status::Pending)
+                {
+                    continue;
+                }
+
+                if (GFS_NwExecOne(request.handle) == GFS_SVR_ERROR)
+                {
+                    request.Finish(ReadRequest::Status::Failed);
+                }
+                else if (GFS_NwIsComplete(request.handle) == TRUE)
+                {
+                    int32_t accessMode;
+                    int32_t readData;
+                    GFS_NwGetStat(request.handle, &accessMode, &readData);
+
+                    request.bytesRead = readData;
+                    request.file->readBytes = (request.startSector * request.file->Size.SectorSize) + readData;
+
+                    request.Finish(ReadRequest::Status::Completed);
+                }
+                else
+                {
+                    busy = true;
+                }
+            }
+
+            if (!busy)
+            {
+                Cd::StartQueuedRequest();
+            }
+        }
+
+        /** @brief Advance frame counter used for request latency, process requests and playing stream
+         * @details Called once per frame after synchronization
+         */
+        inline static void Update()
+        {
+            Cd::frameCount++;
+            Cd::ProcessRequests();
+            Stream::UpdateActive();
+        }
+
+        /** @brief Get identifier of a file in the current directory
+         * @details Names are looked up in hashed index of the directory built when directory is loaded,
+         * names that are not in the index are resolved by GFS.
+         * @param name File name
+         * @return File identifier or error code
+         */
+        inline static int32_t GetFileId(const char* name)
+        {
+            if (name == nullptr)
+            {
+                return ErrorCode::ErrorNoName;
+            }
+
+            const DirectoryIndex* directory = Cd::currentDirectory;
+
+            if (directory != nullptr)
+            {
+                for (uint32_t slot = Cd::HashName(name) & directory->Mask; directory->Slots[slot] >= 0; slot = (slot + 1) & directory->Mask)
+                {
+                    if (Cd::RecordNameEquals(directory->Records[directory->Slots[slot]], name))
+                    {
+                        return directory->Slots[slot];
+                    }
+                }
+            }
+
+            return GFS_NameToId((int8_t *)name);
+        }
+
         /** @brief Change current directory
          * @param name Directory name (NULL for root directory)
          * @returns number of files or error code
@@ -649,7 +2901,31 @@ namespace SRL
         {
             if (name != nullptr && name[0] != '\0')
             {
-                int32_t fid = GFS_NameToId((int8_t *)name);
+                int32_t fid = Cd::GetFileId(name);
+
+                // Directory visited recently can be switched to without reading its listing from the disc again
+                if (fid >= 0 && Cd::currentDirectory != nullptr && fid < Cd::currentDirectory->Count)
+                {
+                    DirectoryIndex* cached = Cd::FindDirectory(Cd::currentDirectory->Records[fid].dirrec.fad);
+
+                    if (cached != nullptr)
+                    {
+                        GFS_DIRTBL_TYPE(&GfsDirectories) = GFS_DIR_NAME;
+                        GFS_DIRTBL_DIRNAME(&GfsDirectories) = cached->Records;
+                        GFS_DIRTBL_NDIR(&GfsDirectories) = cached->Count;
+
+                        int32_t code = GFS_SetDir(&GfsDirectories);
+
+                        if (code >= ErrorCode::ErrorOk)
+                        {
+                            cached->LastUse = ++Cd::directoryClock;
+                            Cd::currentDirectory = cached;
+                        }
+
+                        return code;
+                    }
+                }
+
                 GFS_DIRTBL_TYPE(&GfsDirectories) = GFS_DIR_NAME;
                 GFS_DIRTBL_DIRNAME(&GfsDirectories) = Cd::GfsDirectoryNames;
                 GFS_DIRTBL_NDIR(&GfsDirectories) = SRL_MAX_CD_FILES;
@@ -658,7 +2934,17 @@ namespace SRL
 
                 if (code >= ErrorCode::ErrorOk)
                 {
+                    const int32_t records = code;
                     code = GFS_SetDir(&GfsDirectories);
+
+                    if (code >= ErrorCode::ErrorOk)
+                    {
+                        Cd::IndexDirectory(Cd::GfsDirectoryNames, records);
+                    }
+                    else
+                    {
+                        Cd::currentDirectory = nullptr;
+                    }
                 }
 
                 return code;
@@ -5,6 +5,7 @@
 #include "srl_tv.hpp"
 #include "srl_color.hpp"
 #include "srl_cd.hpp"
+#include "srl_lz.hpp"
 #include "srl_vdp1.hpp"
 #include "srl_vdp2.hpp"
 #include "srl_input.hpp"
@@ -68,6 +69,17 @@ namespace SRL
 
             // Initialize callbacks
             slIntFunction(Core::VblankHandling);
+            Core::OnAfterSync += Memory::FrameArena::Swap;
+            Core::OnAfterSync += Cd::Update;
+            Core::OnAfterSync += Memory::MovableHeap::Update;
+
+            #if defined(SRL_MEMORY_PROFILER)
+            Core::OnAfterSync += Memory::Profiler::EndFrame;
+            #endif
+
+            #if defined(SRL_CD_PROFILER)
+            Core::OnVblank += Cd::Profiler::Tick;
+            #endif
 
             // Start initializing stuff
             SRL::TV::TVOff();
@@ -190,6 +190,44 @@ namespace SRL
             }
         }
 
+#if defined(SRL_MEMORY_PROFILER)
+        /** @brief Print state of the memory profiler on screen (see SRL::Memory::Profiler)
+         * @param x Offset from left of the screen
+         * @param y Offset from top of the screen
+         * @return Number of lines printed
+         */
+        inline static uint8_t PrintMemoryProfile(uint8_t x, uint8_t y)
+        {
+            const char* zoneNames[] = { "HWRAM", "LWRAM", "CART" };
+            uint8_t line = y;
+
+            for (uint8_t zone = 0; zone < 3; zone++)
+            {
+                const Memory::Zone memoryZone = static_cast<Memory::Zone>(zone);
+
+                if (Memory::GetSize(memoryZone) == 0)
+                {
+                    continue;
+                }
+
+                const Memory::Report report = Memory::GetReport(memoryZone);
+                const Memory::Profiler::ZoneStats stats = Memory::Profiler::GetZoneStats(memoryZone);
+
+                Debug::Print(x, line++, "%s use %u peak %u", zoneNames[zone], stats.Bytes, stats.PeakBytes);
+                Debug::Print(x + 1, line++, "free %u big %u frag %u%%", report.FreeSize, report.LargestFreeSize, Memory::Profiler::GetFragmentation(memoryZone));
+                Debug::Print(x + 1, line++, "frame +%u -%u fail %u", stats.FrameAllocations, stats.FrameFrees, stats.Failures);
+            }
+
+            for (size_t tag = 0; tag < Memory::Profiler::GetTagCount(); tag++)
+            {
+                const Memory::Profiler::TagStats& stats = Memory::Profiler::GetTagStats(tag);
+                Debug::Print(x, line++, "%s %u peak %u", stats.Name, stats.Bytes, stats.PeakBytes);
+            }
+
+            return line - y;
+        }
+
+#endif
         /** @brief Breaks any further execution and shows assert screen
          * @param message Custom message to show
          * @param file File the assert happened in
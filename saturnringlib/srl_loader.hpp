@@ -0,0 +1,664 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_memory.hpp"
+#include "srl_event.hpp"
+#include "srl_cd.hpp"
+#include "srl_lz.hpp"
+#include "srl_slave.hpp"
+#include "srl_tga.hpp"
+#include "srl_srt.hpp"
+#include "srl_vdp1.hpp"
+
+namespace SRL
+{
+    /** @brief Pipelined loading of assets declared in a manifest
+     * @details Level declares its assets once, loader then moves them through three stages that all run at the same time:
+     * while one asset is read from the CD, the previous one is decoded on slave CPU and the one before it is uploaded by DMA.
+     * Load time is then bounded by the drive throughput instead of the sum of all stages.<br/>
+     * Data assets end up in their destination (work RAM, VDP2 VRAM, sound RAM...), files compressed by tools/scripts/srl_lz.py are decompressed
+     * on slave straight into the destination. If destination is not set, loader allocates it and stores it in the manifest.<br/>
+     * Texture assets are TGA images or native textures (see SRL::Bitmap::SRT), texture is allocated in VDP1 texture heap as soon as image header is read.
+     * Slave then decodes TGA pixels straight into it, native texture pixels are copied there by DMA or decompressed on slave.
+     * @code {.cpp}
+     * SRL::Loader::Asset level[] = {
+     *      SRL::Loader::Asset::Texture("TREE.TGA"),
+     *      SRL::Loader::Asset::Data("MAP.LZ", map, sizeof(map)),
+     *      SRL::Loader::Asset::Data("BG.CEL", (void*)VDP2_VRAM_A0, 0x20000)
+     * };
+     *
+     * SRL::Loader loader(level, 3);
+     * loader.Start();
+     *
+     * while (!loader.IsDone())
+     * {
+     *      SRL::Debug::Print(1, 1, "Loading %d%%", loader.GetProgress());
+     *      loader.Update();
+     *      SRL::Core::Synchronize();
+     * }
+     *
+     * int32_t treeTexture = level[0].Result;
+     * @endcode
+     * @note Slave CPU never allocates memory while decoding, so master can keep on using the heap during loading.
+     */
+    class Loader
+    {
+    public:
+        /** @brief Kind of asset
+         */
+        enum class AssetType : uint8_t
+        {
+            /** @brief Raw or compressed data copied to a destination
+             */
+            Data,
+
+            /** @brief TGA image or native texture loaded into VDP1 texture heap
+             */
+            Texture
+        };
+
+        /** @brief Manifest entry
+         */
+        struct Asset
+        {
+            /** @brief File name in the current directory
+             */
+            const char* Name;
+
+            /** @brief Kind of asset
+             */
+            AssetType Type;
+
+            /** @brief Where data are loaded to, nullptr to let the loader allocate it (data assets only)
+             */
+            void* Destination;
+
+            /** @brief Size of the destination in bytes (data assets only)
+             */
+            int32_t Size;
+
+            /** @brief Palette loader, expects index of the palette in CRAM as result (paletted textures only)
+             */
+            int16_t (*PaletteHandler)(Bitmap::BitmapInfo*);
+
+            /** @brief Image loader settings (textures only)
+             */
+            Bitmap::TGA::LoaderSettings Settings;
+
+            /** @brief Number of loaded bytes for data, index of the texture for textures, -1 if asset is not loaded or failed
+             */
+            int32_t Result;
+
+            /** @brief Construct a new manifest entry
+             * @param name File name
+             * @param type Kind of asset
+             * @param destination Where data are loaded to
+             * @param size Size of the destination in bytes
+             * @param paletteHandler Palette loader
+             * @param settings Image loader settings
+             */
+            Asset(const char* name,
+                const AssetType type,
+                void* destination,
+                const int32_t size,
+                int16_t (*paletteHandler)(Bitmap::BitmapInfo*),
+                const Bitmap::TGA::LoaderSettings& settings) :
+                Name(name),
+                Type(type),
+                Destination(destination),
+                Size(size),
+                PaletteHandler(paletteHandler),
+                Settings(settings),
+                Result(-1)
+            {
+            }
+
+            /** @brief Declare data asset
+             * @param name File name
+             * @param destination Where data are loaded to, nullptr to let the loader allocate it
+             * @param size Size of the destination in bytes
+             * @return Manifest entry
+             */
+            static Asset Data(const char* name, void* destination = nullptr, const int32_t size = 0)
+            {
+                return Asset(name, AssetType::Data, destination, size, nullptr, Bitmap::TGA::LoaderSettings());
+            }
+
+            /** @brief Declare texture asset
+             * @param name TGA file name
+             * @param paletteHandler Palette loader (only needed for paletted image)
+             * @param settings Image loader settings
+             * @return Manifest entry
+             */
+            static Asset Texture(
+                const char* name,
+                int16_t (*paletteHandler)(Bitmap::BitmapInfo*) = nullptr,
+                const Bitmap::TGA::LoaderSettings& settings = Bitmap::TGA::LoaderSettings())
+            {
+                return Asset(name, AssetType::Texture, nullptr, 0, paletteHandler, settings);
+            }
+        };
+
+    private:
+        /** @brief Asset moving through the pipeline
+         */
+        struct Job
+        {
+            /** @brief Loaded asset, nullptr if job is not used
+             */
+            Asset* asset;
+
+            /** @brief File being read
+             */
+            Cd::File* file;
+
+            /** @brief Read request of the file
+             */
+            Cd::ReadRequest* request;
+
+            /** @brief File data
+             */
+            uint8_t* stream;
+
+            /** @brief Size of the file in bytes
+             */
+            int32_t fileBytes;
+
+            /** @brief Size of the loaded data in bytes
+             */
+            int32_t bytes;
+
+            /** @brief Destination was allocated by the loader
+             */
+            bool ownsDestination;
+
+            /** @brief Running slave task, nullptr if asset needs no decoding
+             */
+            Types::ITask* task;
+
+            /** @brief Decompression of compressed data
+             */
+            Lz::DecompressTask* decompress;
+
+            /** @brief Decoded image
+             */
+            Bitmap::TGA* image;
+
+            /** @brief Native texture
+             */
+            Bitmap::SRT* native;
+
+            /** @brief Image decoding
+             */
+            Bitmap::TGA::DecodeTask decode;
+
+            /** @brief Texture image is decoded into
+             */
+            VDP1::TextureTarget texture;
+
+            /** @brief DMA channel carrying the upload
+             */
+            Memory::Dma::Channel channel;
+        };
+
+        /** @brief One job per pipeline stage
+         */
+        Job jobs[3];
+
+        /** @brief Job being read from CD
+         */
+        Job* reading;
+
+        /** @brief Job being decoded on slave
+         */
+        Job* decoding;
+
+        /** @brief Job being uploaded
+         */
+        Job* uploading;
+
+        /** @brief Asset manifest
+         */
+        Asset* manifest;
+
+        /** @brief Number of assets in the manifest
+         */
+        uint16_t count;
+
+        /** @brief Index of next asset to read
+         */
+        uint16_t next;
+
+        /** @brief Number of finished assets
+         */
+        uint16_t finished;
+
+        /** @brief Number of failed assets
+         */
+        uint16_t failed;
+
+        /** @brief Size of all files in the manifest
+         */
+        int32_t totalBytes;
+
+        /** @brief Size of files of finished assets
+         */
+        int32_t finishedBytes;
+
+        /** @brief Free all resources held by the job
+         * @param job Job to release
+         */
+        void Release(Job* job)
+        {
+            if (job->request != nullptr)
+            {
+                job->request->Release();
+            }
+
+            if (job->task != nullptr)
+            {
+                while (!job->task->IsDone());
+            }
+
+            Memory::Dma::Wait(job->channel);
+
+            delete job->file;
+            delete job->decompress;
+            delete job->image;
+            delete job->native;
+            delete[] job->stream;
+
+            if (job->ownsDestination)
+            {
+                delete[] reinterpret_cast<uint8_t*>(job->asset->Destination);
+                job->asset->Destination = nullptr;
+            }
+
+            job->asset = nullptr;
+        }
+
+        /** @brief Finish the job
+         * @param job Finished job
+         * @param result Result stored in the manifest, -1 if asset failed
+         */
+        void Finish(Job* job, const int32_t result)
+        {
+            Asset* asset = job->asset;
+            asset->Result = result;
+
+            if (result < 0)
+            {
+                // Texture allocated for asset that failed is not needed anymore
+                VDP1::FreeTexture(job->texture.GetId());
+                this->failed++;
+            }
+            else
+            {
+                // Destination belongs to the manifest now
+                job->ownsDestination = false;
+            }
+
+            this->finished++;
+            this->finishedBytes += job->fileBytes;
+            this->Release(job);
+
+            // Data written by slave or DMA must not be shadowed by stale cache of this CPU
+            if (asset->Type == AssetType::Data)
+            {
+                slCashPurge();
+            }
+
+            this->OnAssetCompleted.Invoke(asset);
+        }
+
+        /** @brief Start reading next asset from the manifest
+         */
+        void StartRead()
+        {
+            Job* job = &this->jobs[0];
+
+            while (job->asset != nullptr)
+            {
+                job++;
+            }
+
+            *job = Job();
+            job->asset = &this->manifest[this->next++];
+            job->asset->Result = -1;
+            job->file = new Cd::File(job->asset->Name);
+
+            if (job->file->Exists())
+            {
+                job->fileBytes = job->file->Size.Bytes;
+                job->stream = new uint8_t[job->file->Size.Sectors * job->file->Size.SectorSize];
+                job->request = job->file->QueueRead(job->fileBytes, job->stream, Cd::ReadRequest::Priority::Normal);
+            }
+
+            if (job->request == nullptr)
+            {
+                this->Finish(job, -1);
+                return;
+            }
+
+            this->reading = job;
+        }
+
+        /** @brief Start decoding data that were read
+         * @param job Job that finished reading
+         */
+        void StartDecode(Job* job)
+        {
+            const bool completed = job->request->GetStatus() == Cd::ReadRequest::Status::Completed;
+            job->bytes = job->request->GetBytesRead();
+            job->request->Release();
+            job->request = nullptr;
+
+            if (!completed || job->bytes < job->fileBytes)
+            {
+                this->Finish(job, -1);
+                return;
+            }
+
+            job->bytes = job->fileBytes;
+            Asset* asset = job->asset;
+
+            if (asset->Type == AssetType::Texture)
+            {
+                // Header and palette are processed and texture is allocated here, slave only fills texture pixels
+                job->texture = VDP1::TextureTarget(asset->PaletteHandler);
+
+                if (Bitmap::SRT::IsNative(job->stream))
+                {
+                    job->native = new Bitmap::SRT(job->stream, job->bytes, &job->texture, false);
+                }
+                else
+                {
+                    job->image = new Bitmap::TGA(job->stream, job->bytes, asset->Settings, &job->decode, &job->texture);
+                }
+
+                if (job->texture.GetId() < 0)
+                {
+                    this->Finish(job, -1);
+                    return;
+                }
+
+                if (job->native == nullptr)
+                {
+                    job->task = &job->decode;
+                }
+                else
+                {
+                    job->bytes = job->native->GetHeader().GetPixelSize();
+
+                    if (job->native->GetHeader().IsCompressed())
+                    {
+                        job->decompress = new Lz::DecompressTask(job->native->GetStoredData(), VDP1::Textures[job->texture.GetId()].GetData(), job->bytes);
+                        job->task = job->decompress;
+                    }
+                }
+            }
+            else if (Lz::IsCompressed(job->stream))
+            {
+                job->bytes = Lz::GetSize(job->stream);
+
+                if (asset->Destination == nullptr)
+                {
+                    asset->Destination = new uint8_t[job->bytes];
+                    asset->Size = job->bytes;
+                    job->ownsDestination = true;
+                }
+
+                if (asset->Size < job->bytes)
+                {
+                    this->Finish(job, -1);
+                    return;
+                }
+
+                job->decompress = new Lz::DecompressTask(job->stream, asset->Destination, asset->Size);
+                job->task = job->decompress;
+            }
+            else if (asset->Destination != nullptr && asset->Size < job->bytes)
+            {
+                this->Finish(job, -1);
+                return;
+            }
+
+            if (job->task != nullptr)
+            {
+                Slave::ExecuteOnSlave(*job->task);
+            }
+
+            this->decoding = job;
+        }
+
+        /** @brief Start uploading decoded data
+         * @param job Job that finished decoding
+         */
+        void StartUpload(Job* job)
+        {
+            Asset* asset = job->asset;
+            job->task = nullptr;
+
+            if (asset->Type == AssetType::Texture)
+            {
+                if (job->native == nullptr)
+                {
+                    // Pixels are already in the texture, truncated or broken image fails
+                    this->Finish(job, job->decode.GetResult() ? job->texture.GetId() : -1);
+                    return;
+                }
+                else if (job->decompress != nullptr)
+                {
+                    // Pixels were decompressed straight into the texture
+                    this->Finish(job, job->decompress->GetResult() == job->bytes ? job->texture.GetId() : -1);
+                    return;
+                }
+
+                // Native pixels need no processing, they are copied into the texture as they are
+                job->channel = Memory::Dma::Copy(VDP1::Textures[job->texture.GetId()].GetData(), job->native->GetStoredData(), job->bytes, Memory::Dma::Channel::Scu);
+            }
+            else if (job->decompress != nullptr)
+            {
+                // Decompressed straight into the destination
+                this->Finish(job, job->decompress->GetResult() == job->bytes ? job->bytes : -1);
+                return;
+            }
+            else if (asset->Destination == nullptr)
+            {
+                // Read buffer becomes the destination
+                asset->Destination = job->stream;
+                asset->Size = job->bytes;
+                job->stream = nullptr;
+                this->Finish(job, job->bytes);
+                return;
+            }
+            else
+            {
+                job->channel = Memory::Dma::Copy(asset->Destination, job->stream, job->bytes, Memory::Dma::Channel::Scu);
+            }
+
+            this->uploading = job;
+        }
+
+        /** @brief Move jobs that are done with their stage to the next one
+         * @return true if any job moved
+         */
+        bool Advance()
+        {
+            bool moved = false;
+
+            if (this->uploading != nullptr && Memory::Dma::IsFinished(this->uploading->channel))
+            {
+                Job* job = this->uploading;
+                this->uploading = nullptr;
+                this->Finish(job, job->asset->Type == AssetType::Texture ? job->texture.GetId() : job->bytes);
+                moved = true;
+            }
+
+            if (this->decoding != nullptr && this->uploading == nullptr && (this->decoding->task == nullptr || this->decoding->task->IsDone()))
+            {
+                Job* job = this->decoding;
+                this->decoding = nullptr;
+                this->StartUpload(job);
+                moved = true;
+            }
+
+            if (this->reading != nullptr && this->decoding == nullptr && this->reading->request->IsDone())
+            {
+                Job* job = this->reading;
+                this->reading = nullptr;
+                this->StartDecode(job);
+                moved = true;
+            }
+
+            if (this->reading == nullptr && this->next < this->count)
+            {
+                this->StartRead();
+                moved = true;
+            }
+
+            return moved;
+        }
+
+    public:
+        /** @brief Invoked once asset is loaded or fails, Asset::Result tells which
+         */
+        SRL::Types::Event<Asset*> OnAssetCompleted;
+
+        /** @brief Construct a new loader
+         * @param manifest Assets to load, must stay valid while loader is running
+         * @param count Number of assets in the manifest
+         */
+        Loader(Asset* manifest, const uint16_t count) :
+            reading(nullptr),
+            decoding(nullptr),
+            uploading(nullptr),
+            manifest(manifest),
+            count(manifest != nullptr ? count : 0),
+            next(0),
+            finished(0),
+            failed(0),
+            totalBytes(0),
+            finishedBytes(0)
+        {
+            for (Job& job : this->jobs)
+            {
+                job = Job();
+            }
+        }
+
+        /** @brief Stop loading, assets that did not finish yet are left unloaded
+         */
+        ~Loader()
+        {
+            this->Stop();
+        }
+
+        /** @brief Start loading the manifest from its first asset
+         * @details Size of all files is looked up first, so progress can be reported in bytes
+         */
+        void Start()
+        {
+            this->Stop();
+            this->next = 0;
+            this->finished = 0;
+            this->failed = 0;
+            this->totalBytes = 0;
+            this->finishedBytes = 0;
+
+            for (uint16_t index = 0; index < this->count; index++)
+            {
+                Cd::File file(this->manifest[index].Name);
+                this->totalBytes += file.Exists() ? file.Size.Bytes : 0;
+            }
+
+            this->Update();
+        }
+
+        /** @brief Stop loading, assets that did not finish yet are left unloaded
+         * @details Cancelled assets count as finished and failed, so IsDone() is true afterwards.
+         * @note Waits for running decode and upload to finish
+         */
+        void Stop()
+        {
+            for (Job& job : this->jobs)
+            {
+                if (job.asset != nullptr)
+                {
+                    this->Release(&job);
+
+                    // Texture of cancelled asset is not needed anymore
+                    VDP1::FreeTexture(job.texture.GetId());
+                }
+            }
+
+            this->reading = nullptr;
+            this->decoding = nullptr;
+            this->uploading = nullptr;
+            this->next = this->count;
+            this->failed += this->count - this->finished;
+            this->finished = this->count;
+        }
+
+        /** @brief Advance the pipeline
+         * @details Should be called at least once per frame, CD reads are advanced by Cd::Update() after synchronization
+         */
+        void Update()
+        {
+            while (this->Advance());
+        }
+
+        /** @brief Load whole manifest, blocks until all assets are loaded
+         * @return true if no asset failed
+         */
+        bool Load()
+        {
+            this->Start();
+
+            while (!this->IsDone())
+            {
+                Cd::ProcessRequests();
+                this->Update();
+            }
+
+            return this->failed == 0;
+        }
+
+        /** @brief Check whether all assets finished loading
+         * @return true if there is nothing left to load
+         */
+        bool IsDone()
+        {
+            return this->finished == this->count;
+        }
+
+        /** @brief Get loading progress
+         * @return Percentage of file bytes of finished assets
+         */
+        uint8_t GetProgress()
+        {
+            if (this->totalBytes <= 0)
+            {
+                return this->IsDone() ? 100 : 0;
+            }
+
+            return (uint8_t)((this->finishedBytes * 100LL) / this->totalBytes);
+        }
+
+        /** @brief Get number of finished assets
+         * @return Number of assets that were loaded or failed
+         */
+        uint16_t GetFinishedCount()
+        {
+            return this->finished;
+        }
+
+        /** @brief Get number of failed assets
+         * @return Number of assets that failed to load
+         */
+        uint16_t GetFailedCount()
+        {
+            return this->failed;
+        }
+    };
+}
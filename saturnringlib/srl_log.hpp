@@ -264,5 +264,45 @@ namespace SRL
         {
             SRL::Logger::LogInfo(message, args ...);
         }
+
+#if defined(SRL_MEMORY_PROFILER)
+        /** @brief Log state of the memory profiler (see SRL::Memory::Profiler)
+         * @tparam lvl Log level
+         */
+        template <SRL::Logger::LogLevels lvl = SRL::Logger::LogLevels::INFO>
+        inline void LogMemoryProfile()
+        {
+            const char* zoneNames[] = { "HWRAM", "LWRAM", "CART" };
+
+            for (uint8_t zone = 0; zone < 3; zone++)
+            {
+                const SRL::Memory::Zone memoryZone = static_cast<SRL::Memory::Zone>(zone);
+
+                if (SRL::Memory::GetSize(memoryZone) == 0)
+                {
+                    continue;
+                }
+
+                const SRL::Memory::Report report = SRL::Memory::GetReport(memoryZone);
+                const SRL::Memory::Profiler::ZoneStats stats = SRL::Memory::Profiler::GetZoneStats(memoryZone);
+
+                SRL::Logger::Log::LogPrint<lvl>("%s: used %u (peak %u), free %u, largest %u (%u%% fragmented)",
+                    zoneNames[zone], stats.Bytes, stats.PeakBytes, report.FreeSize, report.LargestFreeSize, SRL::Memory::Profiler::GetFragmentation(memoryZone));
+                SRL::Logger::Log::LogPrint<lvl>("%s: last frame %u allocations (%u bytes), %u frees, %u failed total",
+                    zoneNames[zone], stats.FrameAllocations, stats.FrameBytes, stats.FrameFrees, stats.Failures);
+            }
+
+            for (size_t tag = 0; tag < SRL::Memory::Profiler::GetTagCount(); tag++)
+            {
+                const SRL::Memory::Profiler::TagStats& stats = SRL::Memory::Profiler::GetTagStats(tag);
+                SRL::Logger::Log::LogPrint<lvl>("Tag %s: %u bytes in %u blocks (peak %u)", stats.Name, stats.Bytes, stats.Blocks, stats.PeakBytes);
+            }
+
+            if (SRL::Memory::Profiler::GetUntrackedCount() > 0)
+            {
+                SRL::Logger::Log::LogPrint<lvl>("Untracked allocations: %u", SRL::Memory::Profiler::GetUntrackedCount());
+            }
+        }
+#endif
     };
 }
@@ -0,0 +1,505 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_memory.hpp"
+#include "srl_cd.hpp"
+#include "srl_slave.hpp"
+
+namespace SRL
+{
+    /** @brief LZ compressed assets
+     * @details Compressed asset starts with Lz::Header followed by single LZ4 block, files are created by tools/scripts/srl_lz.py.
+     * Data can be decompressed from memory or streamed directly from a file (or archive view) into the destination buffer, including VRAM.
+     * @code {.cpp}
+     * SRL::Cd::File file("LEVEL.LZ");
+     * int32_t size = SRL::Lz::GetSize(&file);
+     *
+     * if (size > 0)
+     * {
+     *      uint8_t* level = new uint8_t[size];
+     *      SRL::Lz::Load(&file, level, size);
+     * }
+     * @endcode
+     */
+    class Lz
+    {
+    public:
+        /** @brief Compressed asset header (all numbers are big endian)
+         */
+        struct Header
+        {
+            /** @brief Asset identifier, must be "SRLZ"
+             */
+            char Magic[4];
+
+            /** @brief Size of decompressed data in bytes
+             */
+            uint32_t Size;
+
+            /** @brief Size of compressed block following the header in bytes
+             */
+            uint32_t CompressedSize;
+
+            /** @brief Check whether header is valid
+             * @return true if header belongs to compressed asset
+             */
+            constexpr bool IsValid() const
+            {
+                return this->Magic[0] == 'S' && this->Magic[1] == 'R' && this->Magic[2] == 'L' && this->Magic[3] == 'Z';
+            }
+        };
+
+    private:
+        /** @brief Number of bytes read from stream at once
+         */
+        inline static const int32_t StreamChunkSize = 2048;
+
+        /** @brief Minimal match length of LZ4 block
+         */
+        inline static const int32_t MinMatch = 4;
+
+        /** @brief Copy header out of data in memory
+         * @note Data do not need to be aligned, header is copied byte by byte if they are not
+         * @param data Data starting with header
+         * @return Copy of the header
+         */
+        inline static Header ReadHeader(const void* data)
+        {
+            Header header;
+            Memory::MemCopy(&header, data, sizeof(Header));
+            return header;
+        }
+
+        /** @brief Compressed input in memory
+         */
+        struct MemoryInput
+        {
+            /** @brief Current input byte
+             */
+            const uint8_t* current;
+
+            /** @brief End of the input
+             */
+            const uint8_t* end;
+
+            /** @brief Get next byte
+             * @param value Read byte
+             * @return false if input is exhausted
+             */
+            bool Next(uint8_t& value)
+            {
+                if (this->current >= this->end)
+                {
+                    return false;
+                }
+
+                value = *this->current++;
+                return true;
+            }
+
+            /** @brief Copy bytes from the input
+             * @param destination Where to copy bytes
+             * @param count Number of bytes to copy
+             * @return false if input is exhausted
+             */
+            bool Take(uint8_t* destination, int32_t count)
+            {
+                if (this->end - this->current < count)
+                {
+                    return false;
+                }
+
+                Memory::MemCopy(destination, this->current, count);
+                this->current += count;
+                return true;
+            }
+        };
+
+        /** @brief Compressed input read from a stream in chunks
+         * @tparam Source Type with Cd::File like Read(size, destination) function
+         */
+        template<typename Source>
+        struct StreamInput
+        {
+            /** @brief Stream compressed data are read from
+             */
+            Source* source;
+
+            /** @brief Number of compressed bytes not yet read from the stream
+             */
+            int32_t remaining;
+
+            /** @brief Staging buffer
+             */
+            uint8_t* buffer;
+
+            /** @brief Current byte in staging buffer
+             */
+            const uint8_t* current;
+
+            /** @brief End of valid data in staging buffer
+             */
+            const uint8_t* end;
+
+            /** @brief Load next chunk of the stream into the staging buffer
+             * @return false if stream is exhausted or failed
+             */
+            bool Refill()
+            {
+                const int32_t count = SRL::Math::Min<int32_t>(this->remaining, Lz::StreamChunkSize);
+
+                if (count <= 0 || this->source->Read(count, this->buffer) != count)
+                {
+                    return false;
+                }
+
+                this->remaining -= count;
+                this->current = this->buffer;
+                this->end = this->buffer + count;
+                return true;
+            }
+
+            /** @brief Get next byte
+             * @param value Read byte
+             * @return false if input is exhausted
+             */
+            bool Next(uint8_t& value)
+            {
+                if (this->current >= this->end && !this->Refill())
+                {
+                    return false;
+                }
+
+                value = *this->current++;
+                return true;
+            }
+
+            /** @brief Copy bytes from the input
+             * @param destination Where to copy bytes
+             * @param count Number of bytes to copy
+             * @return false if input is exhausted
+             */
+            bool Take(uint8_t* destination, int32_t count)
+            {
+                while (count > 0)
+                {
+                    if (this->current >= this->end && !this->Refill())
+                    {
+                        return false;
+                    }
+
+                    const int32_t available = SRL::Math::Min<int32_t>(this->end - this->current, count);
+                    Memory::MemCopy(destination, this->current, available);
+                    this->current += available;
+                    destination += available;
+                    count -= available;
+                }
+
+                return true;
+            }
+        };
+
+        /** @brief Read extended LZ4 length
+         * @tparam Input Input type
+         * @param input Compressed input
+         * @param length Length to extend
+         * @return false if input is exhausted
+         */
+        template<typename Input>
+        inline static bool ReadLength(Input& input, int32_t& length)
+        {
+            uint8_t value;
+
+            do
+            {
+                if (!input.Next(value))
+                {
+                    return false;
+                }
+
+                length += value;
+            }
+            while (value == 255);
+
+            return true;
+        }
+
+        /** @brief Decode LZ4 block
+         * @tparam Input Input type
+         * @param input Compressed input
+         * @param destination Destination buffer, also serves as history window
+         * @param size Size of decompressed data
+         * @return Number of decompressed bytes, -1 on corrupted data
+         */
+        template<typename Input>
+        inline static int32_t DecodeBlock(Input& input, uint8_t* destination, int32_t size)
+        {
+            uint8_t* output = destination;
+            uint8_t* const outputEnd = destination + size;
+
+            while (output < outputEnd)
+            {
+                uint8_t token;
+
+                if (!input.Next(token))
+                {
+                    return -1;
+                }
+
+                // Literals
+                int32_t length = token >> 4;
+
+                if ((length == 15 && !Lz::ReadLength(input, length)) ||
+                    length > outputEnd - output ||
+                    !input.Take(output, length))
+                {
+                    return -1;
+                }
+
+                output += length;
+
+                // Last sequence has no match
+                if (output == outputEnd)
+                {
+                    break;
+                }
+
+                // Match
+                uint8_t low;
+                uint8_t high;
+
+                if (!input.Next(low) || !input.Next(high))
+                {
+                    return -1;
+                }
+
+                const int32_t offset = low | (high << 8);
+                length = token & 0x0f;
+
+                if (length == 15 && !Lz::ReadLength(input, length))
+                {
+                    return -1;
+                }
+
+                length += Lz::MinMatch;
+
+                if (offset == 0 || offset > output - destination || length > outputEnd - output)
+                {
+                    return -1;
+                }
+
+                const uint8_t* match = output - offset;
+
+                if (offset >= length)
+                {
+                    Memory::MemCopy(output, match, length);
+                    output += length;
+                }
+                else
+                {
+                    // Overlapping match repeats last offset bytes
+                    for (uint8_t* end = output + length; output < end; output++, match++)
+                    {
+                        *output = *match;
+                    }
+                }
+            }
+
+            return output - destination;
+        }
+
+    public:
+        /** @brief Disable default constructor
+         */
+        Lz() = delete;
+
+        /** @brief Check whether data in memory are compressed
+         * @param data Data to check
+         * @return true if data start with valid header
+         */
+        inline static bool IsCompressed(const void* data)
+        {
+            return data != nullptr && Lz::ReadHeader(data).IsValid();
+        }
+
+        /** @brief Get decompressed size of data in memory
+         * @param data Compressed data including header, do not need to be aligned
+         * @return Size of decompressed data, -1 if data are not compressed
+         */
+        inline static int32_t GetSize(const void* data)
+        {
+            return Lz::IsCompressed(data) ? static_cast<int32_t>(Lz::ReadHeader(data).Size) : -1;
+        }
+
+        /** @brief Decompress data from memory
+         * @param compressed Compressed data including header, do not need to be aligned
+         * @param destination Destination buffer
+         * @param size Size of the destination buffer
+         * @return Number of decompressed bytes, -1 on error
+         */
+        inline static int32_t Decompress(const void* compressed, void* destination, int32_t size)
+        {
+            if (!Lz::IsCompressed(compressed))
+            {
+                return -1;
+            }
+
+            const Header header = Lz::ReadHeader(compressed);
+
+            if (destination == nullptr || static_cast<int32_t>(header.Size) > size)
+            {
+                return -1;
+            }
+
+            const uint8_t* block = reinterpret_cast<const uint8_t*>(compressed) + sizeof(Header);
+            MemoryInput input = { block, block + header.CompressedSize };
+            return Lz::DecodeBlock(input, reinterpret_cast<uint8_t*>(destination), header.Size);
+        }
+
+        /** @brief Decompress data while reading them from a stream
+         * @details Stream must be positioned at the start of the header, compressed data are never fully loaded into memory
+         * @tparam Source Type with Cd::File like Read(size, destination) function (e.g. Cd::File or Cd::Archive::View)
+         * @param source Stream to read from
+         * @param destination Destination buffer
+         * @param size Size of the destination buffer
+         * @return Number of decompressed bytes, -1 on error
+         */
+        template<typename Source>
+        inline static int32_t DecompressStream(Source* source, void* destination, int32_t size)
+        {
+            Header header;
+
+            if (source == nullptr ||
+                destination == nullptr ||
+                source->Read(sizeof(Header), &header) != sizeof(Header) ||
+                !header.IsValid() ||
+                static_cast<int32_t>(header.Size) > size)
+            {
+                return -1;
+            }
+
+            StreamInput<Source> input = { source, static_cast<int32_t>(header.CompressedSize), new uint8_t[Lz::StreamChunkSize], nullptr, nullptr };
+            input.current = input.end = input.buffer;
+
+            const int32_t result = input.buffer != nullptr ? Lz::DecodeBlock(input, reinterpret_cast<uint8_t*>(destination), header.Size) : -1;
+            delete[] input.buffer;
+            return result;
+        }
+
+        /** @brief Get decompressed size of a file
+         * @note File is left in the same open state it was in
+         * @param file File to check
+         * @return Size of decompressed data, -1 if file is not compressed
+         */
+        inline static int32_t GetSize(Cd::File* file)
+        {
+            if (file == nullptr)
+            {
+                return -1;
+            }
+
+            Header header;
+            const bool wasOpen = file->IsOpen();
+            const bool valid = file->Open() &&
+                file->Seek(0) == 0 &&
+                file->Read(sizeof(Header), &header) == sizeof(Header) &&
+                header.IsValid();
+
+            if (!wasOpen)
+            {
+                file->Close();
+            }
+
+            return valid ? static_cast<int32_t>(header.Size) : -1;
+        }
+
+        /** @brief Load and decompress whole file
+         * @note File is left in the same open state it was in
+         * @param file Compressed file
+         * @param destination Destination buffer
+         * @param size Size of the destination buffer
+         * @return Number of decompressed bytes, -1 on error
+         */
+        inline static int32_t Load(Cd::File* file, void* destination, int32_t size)
+        {
+            if (file == nullptr)
+            {
+                return -1;
+            }
+
+            const bool wasOpen = file->IsOpen();
+            const int32_t result = file->Open() && file->Seek(0) == 0 ? Lz::DecompressStream(file, destination, size) : -1;
+
+            if (!wasOpen)
+            {
+                file->Close();
+            }
+
+            return result;
+        }
+
+        /** @brief Decompress data from memory on slave CPU
+         * @details Master can keep on loading next asset while slave decodes the current one.
+         * Slave writes into the destination through its own cache, master must read the result through cache-through area or purge its cache first.
+         * @code {.cpp}
+         * SRL::Lz::DecompressTask task(compressed, destination, size);
+         * SRL::Slave::ExecuteOnSlave(task);
+         *
+         * // Do something else
+         *
+         * while (!task.IsDone());
+         * @endcode
+         */
+        class DecompressTask : public Types::ITask
+        {
+        private:
+            /** @brief Compressed data including header
+             */
+            const void* compressed;
+
+            /** @brief Destination buffer
+             */
+            void* destination;
+
+            /** @brief Size of the destination buffer
+             */
+            int32_t size;
+
+            /** @brief Number of decompressed bytes
+             */
+            volatile int32_t result;
+
+        protected:
+            /** @brief Decompress data
+             */
+            void Do() override
+            {
+                // Compressed data were written by CD or DMA behind cache of this CPU, buffer address could have been cached before
+                slCashPurge();
+                this->result = Lz::Decompress(this->compressed, this->destination, this->size);
+            }
+
+        public:
+            /** @brief Construct a new decompress task
+             * @param compressed Compressed data including header
+             * @param destination Destination buffer
+             * @param size Size of the destination buffer
+             */
+            DecompressTask(const void* compressed, void* destination, int32_t size) :
+                compressed(compressed),
+                destination(destination),
+                size(size),
+                result(-1)
+            {
+            }
+
+            /** @brief Get result of the decompression
+             * @return Number of decompressed bytes, -1 on error or if task is not done yet
+             */
+            int32_t GetResult()
+            {
+                return this->IsDone() ? this->result : -1;
+            }
+        };
+    };
+}
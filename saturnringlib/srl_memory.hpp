@@ -9,6 +9,22 @@ extern "C" {
 
 #include <tlsf.h>
 #include <stdlib.h>
+#include <initializer_list>
+#include <new>
+
+#if defined(SRL_MEMORY_PROFILER)
+#ifndef SRL_MEMORY_PROFILER_MAX_ALLOCATIONS
+/** @brief Number of live allocations memory profiler can track (must be power of two)
+ */
+#define SRL_MEMORY_PROFILER_MAX_ALLOCATIONS 1024
+#endif
+
+#ifndef SRL_MEMORY_PROFILER_MAX_TAGS
+/** @brief Number of tags memory profiler can track
+ */
+#define SRL_MEMORY_PROFILER_MAX_TAGS 16
+#endif
+#endif
 
 namespace SRL
 {
@@ -41,6 +57,10 @@ namespace SRL
             /** @brief Number of allocated blocks
              */
             size_t UsedBlocks;
+
+            /** @brief Size of the largest free block, compared with FreeSize it shows how fragmented the zone is
+             */
+            size_t LargestFreeSize;
         };
 
     private:
@@ -180,6 +200,7 @@ namespace SRL
                 if (header->Size == newBlock)
                 {
                     header->State = SimpleMalloc::BlockState::Used;
+                    return true;
                 }
                 else if (header->Size > newBlock)
                 {
@@ -237,7 +258,7 @@ namespace SRL
             inline static const Report GetReport(const MemoryZone& zone)
             {
                 size_t location = 0;
-                auto report = Report { 0, 0, 0, zone.Size, 0 };
+                auto report = Report { 0, 0, 0, zone.Size, 0, 0 };
 
                 while (location < zone.Size)
                 {
@@ -248,6 +269,7 @@ namespace SRL
                     {
                         report.FreeBlocks++;
                         report.FreeSize += header->Size;
+                        report.LargestFreeSize = header->Size > report.LargestFreeSize ? header->Size : report.LargestFreeSize;
                     }
                     else
                     {
@@ -321,471 +343,3318 @@ namespace SRL
             }
 
             /** @brief Reallocate memory (can either shrink, enlarge or move)
+             * @details Block is shrunk by splitting off its tail and grown into free blocks right after it, both without copying.
+             * Only when there is not enough free space behind the block, it is moved and its content copied.
              * @param zone Memory zone settings
-             * @param ptr Allocated memory to resize
+             * @param ptr Allocated memory to resize, if nullptr new block is allocated
              * @param size New size of the allocated block
-             * @return void* Pointer to resized or moved block
+             * @return void* Pointer to resized or moved block, nullptr if there is not enough space (original block stays valid)
              */
             inline static void* Realloc(const MemoryZone& zone, void* ptr, size_t size)
             {
-                // Validate pointer to not be null and be in zone
-                if (ptr != nullptr && Memory::InZone(zone, ptr))
+                if (ptr == nullptr)
+                {
+                    return SimpleMalloc::Malloc(zone, size);
+                }
+
+                // Validate pointer to be in zone
+                if (!Memory::InZone(zone, ptr))
+                {
+                    return nullptr;
+                }
+
+                size_t location = reinterpret_cast<size_t>(ptr) - reinterpret_cast<size_t>(zone.Address);
+
+                if (location == 0 || location >= zone.Size || (location & 3) != 0)
                 {
-                    // This one is located in the free() function as well, but I do not want to repeat its insides here again 
-                    size_t location = reinterpret_cast<size_t>(ptr) - reinterpret_cast<size_t>(zone.Address);
-                    size_t headerLocation = location - sizeof(SimpleMalloc::Header);
+                    return nullptr;
+                }
 
-                    // We free the block first, this will also join it will all free blocks right after it
-                    SimpleMalloc::Free(zone, ptr);
+                size_t headerLocation = location - sizeof(SimpleMalloc::Header);
+                SimpleMalloc::Header* header = ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[headerLocation]);
+                const size_t oldSize = header->Size;
+                const size_t length = ((size + 3) & ~((size_t)3)) & 0x7fffffff;
+
+                if (length > oldSize)
+                {
+                    // Try to take over free blocks right after this one
+                    size_t next = SimpleMalloc::GetNextBlockLocation(zone, headerLocation);
 
-                    // Now we check if we can fit inside the new created space
-                    if (SimpleMalloc::SetBlockAllocation(zone, headerLocation, size))
+                    if (next < zone.Size && ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[next])->State == SimpleMalloc::BlockState::Free)
                     {
-                        // We fit inside
-                        return (void*)&((uint8_t*)zone.Address)[location];
+                        SimpleMalloc::MergeFreeMemoryBlocks(zone, next);
+                        size_t available = oldSize + sizeof(SimpleMalloc::Header) + ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[next])->Size;
+
+                        if (available >= length)
+                        {
+                            header->Size = available;
+                            SimpleMalloc::SetBlockAllocation(zone, headerLocation, length);
+                            return ptr;
+                        }
                     }
-                    else
-                    {
-                        // We do not fit, try to find space elsewhere
-                        void* newSpace = SimpleMalloc::Malloc(zone, size);
 
-                        // Copy data to the new location
-                        slDMACopy(ptr, newSpace, ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[headerLocation])->Size);
-                        slDMAWait();
+                    // We do not fit, try to find space elsewhere
+                    void* newSpace = SimpleMalloc::Malloc(zone, length);
 
-                        // Return address to new thing
-                        return newSpace;
+                    if (newSpace != nullptr)
+                    {
+                        // Copy through CPU, DMA would leave stale data in cache of the new location
+                        Memory::MemCopy(newSpace, ptr, oldSize < length ? oldSize : length);
+                        SimpleMalloc::Free(zone, ptr);
                     }
+
+                    return newSpace;
                 }
 
-                return nullptr;
+                // Shrink in place, tail is split off only if it is large enough to become a block on its own
+                if (oldSize - length > (sizeof(SimpleMalloc::Header) << 1))
+                {
+                    header->Size = length;
+
+                    size_t tail = SimpleMalloc::GetNextBlockLocation(zone, headerLocation);
+                    ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[tail])->State = SimpleMalloc::BlockState::Free;
+                    ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[tail])->Size = oldSize - length - sizeof(SimpleMalloc::Header);
+                    SimpleMalloc::MergeFreeMemoryBlocks(zone, tail);
+                }
+
+                return ptr;
             }
         };
-        
-    public:
 
-        /** @brief Memory zone codes
+        /** @brief Segregated free-list allocator
+         * @details Free blocks are kept in size class lists indexed by a two-level bitmap (power of two classes, each split into four sub-classes),
+         * so allocation and release do not depend on the number of blocks in the zone.
+         * Every block knows whether its physical predecessor is free, which allows free blocks to be merged with neighbors on both sides.
+         * Allocator state is stored at the start of the memory zone.
          */
-        enum class Zone
+        class SegregatedMalloc
         {
-            /** @brief High (main) system RAM
+        private:
+
+            /** @brief Number of bits used by the second level (sub-class) index
              */
-            HWRam = 0,
+            static constexpr size_t SubClassBits = 2;
 
-            /** @brief Low system RAM
+            /** @brief Number of sub-classes in each size class
              */
-            LWRam = 1,
+            static constexpr size_t SubClassCount = 1 << SegregatedMalloc::SubClassBits;
 
-            /** @brief Expansion cart RAM
+            /** @brief Number of first level size classes (covers blocks up to 16MB)
              */
-            CartRam = 2
-        };
+            static constexpr size_t ClassCount = 24;
 
-        /** @brief Malloc for main system RAM
-         */
-        class HighWorkRam
-        {
-        private:
-        
-            /** @brief Memory class needs to be able to see private members to initialize zones
+            /** @brief Block is in use
              */
-            friend class Memory;
+            static constexpr size_t UsedFlag = 1;
 
-            /** @brief Main system memory zone
-             * @note This is assigned on system initialization
+            /** @brief Block physically preceding this one is free
              */
-            inline static MemoryZone zone;
+            static constexpr size_t PreviousFreeFlag = 2;
 
-            /** @brief Full main system memory zone
+            /** @brief Mask of all block flags
              */
-            inline static const MemoryZone fullZone = { (void*)0x06000000, 0x07FFFFFF - 0x06000000};
+            static constexpr size_t FlagMask = SegregatedMalloc::UsedFlag | SegregatedMalloc::PreviousFreeFlag;
 
-            /** @brief Initialize memory zone
+            /** @brief Block header
+             * @note Only the first field is present in allocated blocks, free blocks also store list links in the payload and a pointer to their header at the end of the payload
              */
-            inline static void Initialize()
+            struct Block
             {
-                auto address = reinterpret_cast<void*>(&_heap_start);
-                auto size = reinterpret_cast<size_t>(&_heap_end) - reinterpret_cast<size_t>(&_heap_start);
+                /** @brief Payload size combined with block flags
+                 */
+                size_t SizeAndFlags;
 
-                #if defined(USE_TLSF_ALLOCATOR)
-                HighWorkRam::zone = Memory::MemoryZone
-                {
-                    tlsf_create_with_pool(address, size),
-                    size
-                };
-                #else
-                HighWorkRam::zone = Memory::MemoryZone
-                {
-                    Memory::SimpleMalloc::InitializeZone(address, size),
-                    size
-                };
-                #endif
-            }
-            
-        public:
+                /** @brief Next free block in the same size class
+                 */
+                Block* NextFree;
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+                /** @brief Previous free block in the same size class
+                 */
+                Block* PreviousFree;
+            };
+
+            /** @brief Size of the block header present in every block
              */
-            static bool InRange(void* ptr)
-            {
-                return Memory::InZone(HighWorkRam::fullZone, ptr);
-            }
+            static constexpr size_t HeaderSize = sizeof(size_t);
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Smallest payload a block can have (free list links and footer must fit)
              */
-            static bool InRange(uint32_t ptr)
+            static constexpr size_t MinimalSize = sizeof(Block*) * 3;
+
+            /** @brief Allocator state stored at the start of the zone
+             */
+            struct Control
             {
-                return Memory::InZone(HighWorkRam::fullZone, (void*)ptr);
-            }
+                /** @brief Bit is set for each size class that has at least one free block
+                 */
+                uint32_t ClassBitmap;
 
-            /** @brief Free allocated memory
-             * @param ptr Pointer to allocated memory
+                /** @brief Bit is set for each sub-class that has at least one free block
+                 */
+                uint32_t SubClassBitmap[SegregatedMalloc::ClassCount];
+
+                /** @brief Free list heads
+                 */
+                Block* Heads[SegregatedMalloc::ClassCount][SegregatedMalloc::SubClassCount];
+            };
+
+            /** @brief Get allocator state of the zone
+             * @param zone Memory zone settings
+             * @return Allocator state
              */
-            static void Free(void* ptr)
+            inline static Control* GetControl(const MemoryZone& zone)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                tlsf_free(Memory::mainWorkRam.Address, ptr);
-                #else
-                Memory::SimpleMalloc::Free(HighWorkRam::zone, ptr);
-                #endif
+                return reinterpret_cast<Control*>(zone.Address);
             }
 
-            /** @brief Allocate some memory
-             * @param size Number of bytes to allocate
-             * @return Pointer to the allocated space in memory
+            /** @brief Get first block in the zone
+             * @param zone Memory zone settings
+             * @return First block
              */
-            static void* Malloc(size_t size)
+            inline static Block* GetFirstBlock(const MemoryZone& zone)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_malloc(Memory::mainWorkRam.Address, size);
-                #else
-                return Memory::SimpleMalloc::Malloc(HighWorkRam::zone, size);
-                #endif
+                return reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(zone.Address) + sizeof(SegregatedMalloc::Control));
             }
 
-            /** @brief Reallocate existing memory
-             * @param ptr Pointer to the existing allocated memory
-             * @param size New size in number of bytes that should be allocated
-             * @return Pointer to the allocated space in memory
+            /** @brief Get payload size of the block
+             * @param block Memory block
+             * @return Number of bytes
              */
-            static void* Realloc(void* ptr, size_t size)
+            inline static size_t GetSize(const Block* block)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_realloc(Memory::mainWorkRam.Address, size);
-                #else
-                return Memory::SimpleMalloc::Realloc(HighWorkRam::zone, ptr, size);
-                #endif
+                return block->SizeAndFlags & ~SegregatedMalloc::FlagMask;
             }
 
-            /** @brief Gets total size of the free space in the memory zone
-             * @return Number of bytes
+            /** @brief Get block physically following specified block
+             * @param block Memory block
+             * @return Next block
              */
-            static size_t GetFreeSpace()
+            inline static Block* GetNextBlock(Block* block)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                return Memory::SimpleMalloc::GetReport(HighWorkRam::zone).FreeSize;
-                #endif
+                return reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(block) + SegregatedMalloc::HeaderSize + SegregatedMalloc::GetSize(block));
             }
 
-            /** @brief Gets report on the allocator state
-             * @return Current state of the allocator
+            /** @brief Get block physically preceding specified block
+             * @note Valid only if block has PreviousFreeFlag set
+             * @param block Memory block
+             * @return Previous block
              */
-            static const Report GetReport()
+            inline static Block* GetPreviousBlock(Block* block)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return Report { 0, 0, 0, Memory::mainWorkRam.Size, 0};
-                #else
-                return Memory::SimpleMalloc::GetReport(HighWorkRam::zone);
-                #endif
+                return *(reinterpret_cast<Block**>(block) - 1);
             }
 
-            /** @brief Gets total size of the memory zone
-             * @return Number of bytes
+            /** @brief Store pointer to the block header at the end of its payload, so next block can find it
+             * @param block Free memory block
              */
-            static size_t GetSize()
+            inline static void WriteFooter(Block* block)
             {
-                return HighWorkRam::zone.Size;
+                *(reinterpret_cast<Block**>(SegregatedMalloc::GetNextBlock(block)) - 1) = block;
             }
-            
-            /** @brief Gets total size of the used space in the memory zone
-             * @return Number of bytes
+
+            /** @brief Get size class of the block size
+             * @param size Payload size
+             * @param sizeClass First level index
+             * @param subClass Second level index
              */
-            static size_t GetUsedSpace()
+            inline static void GetClass(const size_t size, size_t& sizeClass, size_t& subClass)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                auto report = Memory::SimpleMalloc::GetReport(HighWorkRam::zone);
-                return report.TotalSize - report.FreeSize;
-                #endif
+                sizeClass = 31 - __builtin_clz(size);
+                subClass = (size >> (sizeClass - SegregatedMalloc::SubClassBits)) & (SegregatedMalloc::SubClassCount - 1);
             }
 
-        };
+            /** @brief Add block to the free list of its size class
+             * @param control Allocator state
+             * @param block Free memory block
+             */
+            inline static void InsertFreeBlock(Control* control, Block* block)
+            {
+                size_t sizeClass;
+                size_t subClass;
+                SegregatedMalloc::GetClass(SegregatedMalloc::GetSize(block), sizeClass, subClass);
 
-        /** @brief Malloc for slower system RAM
-         */
-        class LowWorkRam
-        {
-        private:
+                Block* head = control->Heads[sizeClass][subClass];
+                block->NextFree = head;
+                block->PreviousFree = nullptr;
 
-            /** @brief Memory class needs to be able to see private members to initialize zones
-             */
-            friend class Memory;
+                if (head != nullptr)
+                {
+                    head->PreviousFree = block;
+                }
 
-            /** @brief Memory zone
-             */
-            inline static Memory::MemoryZone zone;
+                control->Heads[sizeClass][subClass] = block;
+                control->ClassBitmap |= 1UL << sizeClass;
+                control->SubClassBitmap[sizeClass] |= 1UL << subClass;
+            }
 
-            /** @brief Initialize memory zone
+            /** @brief Remove block from the free list of its size class
+             * @param control Allocator state
+             * @param block Free memory block
              */
-            inline static void Initialize()
+            inline static void RemoveFreeBlock(Control* control, Block* block)
             {
-                const volatile void* address = (void*)0x00200000;
-                const uint32_t size = 0x100000;
+                size_t sizeClass;
+                size_t subClass;
+                SegregatedMalloc::GetClass(SegregatedMalloc::GetSize(block), sizeClass, subClass);
 
-                #if defined(USE_TLSF_ALLOCATOR)
-                LowWorkRam::mainWorkRam = Memory::MemoryZone
+                if (block->NextFree != nullptr)
                 {
-                    tlsf_create_with_pool((void*)address, size),
-                    size
-                };
-                #else
-                LowWorkRam::zone = Memory::MemoryZone
+                    block->NextFree->PreviousFree = block->PreviousFree;
+                }
+
+                if (block->PreviousFree != nullptr)
                 {
-                    Memory::SimpleMalloc::InitializeZone((void*)address, size),
-                    size
-                };
-                #endif
+                    block->PreviousFree->NextFree = block->NextFree;
+                }
+                else
+                {
+                    control->Heads[sizeClass][subClass] = block->NextFree;
+
+                    // List is empty, clear its bits
+                    if (block->NextFree == nullptr)
+                    {
+                        control->SubClassBitmap[sizeClass] &= ~(1UL << subClass);
+
+                        if (control->SubClassBitmap[sizeClass] == 0)
+                        {
+                            control->ClassBitmap &= ~(1UL << sizeClass);
+                        }
+                    }
+                }
             }
-            
-        public:
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Find free block that can hold specified number of bytes
+             * @param control Allocator state
+             * @param size Aligned payload size
+             * @return Free block or nullptr if none was found
              */
-            inline static bool InRange(void* ptr)
+            inline static Block* FindFreeBlock(Control* control, const size_t size)
             {
-                return Memory::InZone(LowWorkRam::zone, ptr);
+                size_t sizeClass;
+                size_t subClass;
+
+                // Round size up to the next sub-class, any block found from there on is large enough
+                const size_t rounded = size + (1UL << ((31 - __builtin_clz(size)) - SegregatedMalloc::SubClassBits)) - 1;
+                SegregatedMalloc::GetClass(rounded, sizeClass, subClass);
+
+                if (sizeClass < SegregatedMalloc::ClassCount)
+                {
+                    uint32_t subClassMap = control->SubClassBitmap[sizeClass] & (0xffffffffUL << subClass);
+
+                    // Nothing in the current class, look at bigger classes
+                    if (subClassMap == 0)
+                    {
+                        const uint32_t classMap = control->ClassBitmap & (0xffffffffUL << (sizeClass + 1));
+
+                        if (classMap != 0)
+                        {
+                            sizeClass = __builtin_ctz(classMap);
+                            subClassMap = control->SubClassBitmap[sizeClass];
+                        }
+                    }
+
+                    if (subClassMap != 0)
+                    {
+                        return control->Heads[sizeClass][__builtin_ctz(subClassMap)];
+                    }
+                }
+
+                // Last resort, first block in the exact sub-class of the request might still be big enough (list is not walked to keep search constant time)
+                SegregatedMalloc::GetClass(size, sizeClass, subClass);
+
+                if (sizeClass < SegregatedMalloc::ClassCount)
+                {
+                    Block* block = control->Heads[sizeClass][subClass];
+
+                    if (block != nullptr && SegregatedMalloc::GetSize(block) >= size)
+                    {
+                        return block;
+                    }
+                }
+
+                return nullptr;
             }
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param zoneAddress Zone address to check
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Mark block as free, merge it with free neighbors and put it into free list
+             * @param control Allocator state
+             * @param block Memory block (must not be in any free list)
              */
-            inline static bool InRange(uint32_t zoneAddress)
+            inline static void ReleaseBlock(Control* control, Block* block)
             {
-                return Memory::InZone(LowWorkRam::zone, (void*)zoneAddress);
+                block->SizeAndFlags &= ~SegregatedMalloc::UsedFlag;
+
+                // Merge with previous block
+                if ((block->SizeAndFlags & SegregatedMalloc::PreviousFreeFlag) != 0)
+                {
+                    Block* previous = SegregatedMalloc::GetPreviousBlock(block);
+                    SegregatedMalloc::RemoveFreeBlock(control, previous);
+                    previous->SizeAndFlags += SegregatedMalloc::HeaderSize + SegregatedMalloc::GetSize(block);
+                    block = previous;
+                }
+
+                // Merge with next block
+                Block* next = SegregatedMalloc::GetNextBlock(block);
+
+                if ((next->SizeAndFlags & SegregatedMalloc::UsedFlag) == 0)
+                {
+                    SegregatedMalloc::RemoveFreeBlock(control, next);
+                    block->SizeAndFlags += SegregatedMalloc::HeaderSize + SegregatedMalloc::GetSize(next);
+                    next = SegregatedMalloc::GetNextBlock(block);
+                }
+
+                SegregatedMalloc::WriteFooter(block);
+                next->SizeAndFlags |= SegregatedMalloc::PreviousFreeFlag;
+                SegregatedMalloc::InsertFreeBlock(control, block);
             }
 
-            /** @brief Free allocated memory
-             * @param ptr Pointer to allocated memory
+            /** @brief Shrink block to specified size and release the left over space, if it is big enough to form a new block
+             * @param control Allocator state
+             * @param block Memory block (must not be in any free list)
+             * @param size Aligned payload size
              */
-            inline static void Free(void* ptr)
+            inline static void SplitBlock(Control* control, Block* block, const size_t size)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                tlsf_free(LowWorkRam::Zone.Address, ptr);
-                #else
-                Memory::SimpleMalloc::Free(LowWorkRam::zone, ptr);
-                #endif
+                const size_t blockSize = SegregatedMalloc::GetSize(block);
+
+                if (blockSize >= size + SegregatedMalloc::HeaderSize + SegregatedMalloc::MinimalSize)
+                {
+                    block->SizeAndFlags = size | (block->SizeAndFlags & SegregatedMalloc::FlagMask);
+
+                    Block* rest = SegregatedMalloc::GetNextBlock(block);
+                    rest->SizeAndFlags = blockSize - size - SegregatedMalloc::HeaderSize;
+                    SegregatedMalloc::ReleaseBlock(control, rest);
+                }
             }
 
-            /** @brief Allocate some memory
-             * @param size Number of bytes to allocate
-             * @return Pointer to the allocated space in memory
+            /** @brief Mark block as allocated
+             * @param block Memory block
              */
-            inline static void* Malloc(size_t size)
+            inline static void MarkUsed(Block* block)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_malloc(LowWorkRam::Zone.Address, size);
-                #else
-                return Memory::SimpleMalloc::Malloc(LowWorkRam::zone, size);
-                #endif
+                block->SizeAndFlags |= SegregatedMalloc::UsedFlag;
+                SegregatedMalloc::GetNextBlock(block)->SizeAndFlags &= ~SegregatedMalloc::PreviousFreeFlag;
             }
 
-           /** @brief Reallocate existing memory
-            * @param ptr Pointer to the existing allocated memory
-            * @param size New size in number of bytes that should be allocated
-            * @return Pointer to the allocated space in memory
-            */
-            inline static void* Realloc(void* ptr, size_t size)
+            /** @brief Get size of the payload needed for the requested number of bytes
+             * @param size Number of bytes
+             * @return Aligned payload size
+             */
+            inline static constexpr size_t AlignSize(const size_t size)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_realloc(LowWorkRam::Zone.Address, ptr, size);
-                #else
-                return Memory::SimpleMalloc::Realloc(LowWorkRam::zone, ptr, size);
-                #endif
+                return size < SegregatedMalloc::MinimalSize ? SegregatedMalloc::MinimalSize : ((size + 3) & ~((size_t)3));
             }
 
-            /** @brief Gets total size of the free space in the memory zone
-             * @return Number of bytes
+            /** @brief Get allocated block from pointer
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             * @return Memory block or nullptr if pointer is not an allocated block of this zone
              */
-            static size_t GetFreeSpace()
+            inline static Block* GetUsedBlock(const MemoryZone& zone, void* ptr)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                return Memory::SimpleMalloc::GetReport(LowWorkRam::zone).FreeSize;
+                if (ptr != nullptr &&
+                    (reinterpret_cast<uint32_t>(ptr) & 3) == 0 &&
+                    ptr > reinterpret_cast<void*>(SegregatedMalloc::GetFirstBlock(zone)) &&
+                    ptr < reinterpret_cast<uint8_t*>(zone.Address) + zone.Size)
+                {
+                    Block* block = reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(ptr) - SegregatedMalloc::HeaderSize);
+
+                    if ((block->SizeAndFlags & SegregatedMalloc::UsedFlag) != 0)
+                    {
+                        return block;
+                    }
+                }
+
+                return nullptr;
+            }
+
+        public:
+
+            /** @brief Free memory
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             */
+            inline static void Free(const MemoryZone& zone, void* ptr)
+            {
+                Block* block = SegregatedMalloc::GetUsedBlock(zone, ptr);
+
+                if (block != nullptr)
+                {
+                    SegregatedMalloc::ReleaseBlock(SegregatedMalloc::GetControl(zone), block);
+                }
+            }
+
+            /** @brief Get report on the allocator in specified memory zone
+             * @param zone Memory zone
+             * @return State report
+             */
+            inline static const Report GetReport(const MemoryZone& zone)
+            {
+                // Allocator state and end of zone marker are counted as headers
+                auto report = Report { sizeof(SegregatedMalloc::Control) + SegregatedMalloc::HeaderSize, 0, 0, zone.Size, 0, 0 };
+                Block* block = SegregatedMalloc::GetFirstBlock(zone);
+
+                // End of zone is marked by used block of zero size
+                while (SegregatedMalloc::GetSize(block) != 0)
+                {
+                    report.AllocationHeaders += SegregatedMalloc::HeaderSize;
+
+                    if ((block->SizeAndFlags & SegregatedMalloc::UsedFlag) == 0)
+                    {
+                        report.FreeBlocks++;
+                        report.FreeSize += SegregatedMalloc::GetSize(block);
+                        report.LargestFreeSize = SegregatedMalloc::GetSize(block) > report.LargestFreeSize ? SegregatedMalloc::GetSize(block) : report.LargestFreeSize;
+                    }
+                    else
+                    {
+                        report.UsedBlocks++;
+                    }
+
+                    block = SegregatedMalloc::GetNextBlock(block);
+                }
+
+                return report;
+            }
+
+            /** @brief Initializes a new memory zone and returns its starting address
+             * @param start Zone start address (must be 4 byte aligned)
+             * @param size Zone size
+             * @return Zone start address
+             */
+            inline static void* InitializeZone(void* start, const size_t size)
+            {
+                const MemoryZone zone = { start, size & ~((size_t)3) };
+                Control* control = SegregatedMalloc::GetControl(zone);
+                control->ClassBitmap = 0;
+
+                for (size_t sizeClass = 0; sizeClass < SegregatedMalloc::ClassCount; sizeClass++)
+                {
+                    control->SubClassBitmap[sizeClass] = 0;
+
+                    for (size_t subClass = 0; subClass < SegregatedMalloc::SubClassCount; subClass++)
+                    {
+                        control->Heads[sizeClass][subClass] = nullptr;
+                    }
+                }
+
+                // Whole zone is one big free block followed by zero sized used block marking the end
+                Block* block = SegregatedMalloc::GetFirstBlock(zone);
+                block->SizeAndFlags = zone.Size - sizeof(SegregatedMalloc::Control) - (SegregatedMalloc::HeaderSize << 1);
+                SegregatedMalloc::GetNextBlock(block)->SizeAndFlags = SegregatedMalloc::UsedFlag;
+                SegregatedMalloc::ReleaseBlock(control, block);
+                return start;
+            }
+
+            /** @brief Allocate memory
+             * @param zone Memory zone settings
+             * @param size Number of bytes to allocate
+             * @return Pointer to allocated space
+             */
+            inline static void* Malloc(const MemoryZone& zone, size_t size)
+            {
+                if (size >= zone.Size)
+                {
+                    return nullptr;
+                }
+
+                Control* control = SegregatedMalloc::GetControl(zone);
+                const size_t length = SegregatedMalloc::AlignSize(size);
+                Block* block = SegregatedMalloc::FindFreeBlock(control, length);
+
+                if (block != nullptr)
+                {
+                    SegregatedMalloc::RemoveFreeBlock(control, block);
+                    SegregatedMalloc::SplitBlock(control, block, length);
+                    SegregatedMalloc::MarkUsed(block);
+                    return reinterpret_cast<uint8_t*>(block) + SegregatedMalloc::HeaderSize;
+                }
+
+                // We could not allocate anything
+                return nullptr;
+            }
+
+            /** @brief Reallocate memory (can either shrink, enlarge or move)
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory to resize
+             * @param size New size of the allocated block
+             * @return void* Pointer to resized or moved block, nullptr on failure (original block is kept)
+             */
+            inline static void* Realloc(const MemoryZone& zone, void* ptr, size_t size)
+            {
+                if (ptr == nullptr)
+                {
+                    return SegregatedMalloc::Malloc(zone, size);
+                }
+
+                Block* block = SegregatedMalloc::GetUsedBlock(zone, ptr);
+
+                if (block == nullptr || size >= zone.Size)
+                {
+                    return nullptr;
+                }
+
+                Control* control = SegregatedMalloc::GetControl(zone);
+                const size_t length = SegregatedMalloc::AlignSize(size);
+                const size_t blockSize = SegregatedMalloc::GetSize(block);
+                Block* next = SegregatedMalloc::GetNextBlock(block);
+
+                // Shrink in place, or grow into the next block if it is free and big enough
+                if (length <= blockSize)
+                {
+                    SegregatedMalloc::SplitBlock(control, block, length);
+                    return ptr;
+                }
+                else if ((next->SizeAndFlags & SegregatedMalloc::UsedFlag) == 0 &&
+                    blockSize + SegregatedMalloc::HeaderSize + SegregatedMalloc::GetSize(next) >= length)
+                {
+                    SegregatedMalloc::RemoveFreeBlock(control, next);
+                    block->SizeAndFlags += SegregatedMalloc::HeaderSize + SegregatedMalloc::GetSize(next);
+                    SegregatedMalloc::MarkUsed(block);
+                    SegregatedMalloc::SplitBlock(control, block, length);
+                    return ptr;
+                }
+
+                // We do not fit, try to find space elsewhere
+                void* newSpace = SegregatedMalloc::Malloc(zone, size);
+
+                if (newSpace != nullptr)
+                {
+                    // Copy through CPU, DMA would leave stale data in cache of the new location
+                    Memory::MemCopy(newSpace, ptr, blockSize);
+                    SegregatedMalloc::ReleaseBlock(control, block);
+                }
+
+                return newSpace;
+            }
+        };
+
+#if defined(USE_TLSF_ALLOCATOR)
+        /** @brief Two-level segregated fit allocator (see modules/tlsf)
+         * @details Thin wrapper giving TLSF the same interface as other zone allocators.
+         * TLSF control structure is placed at the start of the zone, so zone address is also the TLSF instance.
+         */
+        class TlsfMalloc
+        {
+        private:
+
+            /** @brief Collects pool statistics while walking the pool
+             * @param ptr Block payload
+             * @param size Block size
+             * @param used Whether block is used
+             * @param user Report to fill
+             */
+            inline static void WalkBlock(void* ptr, size_t size, int used, void* user)
+            {
+                Report* report = reinterpret_cast<Report*>(user);
+                report->AllocationHeaders += tlsf_alloc_overhead();
+
+                if (used)
+                {
+                    report->UsedBlocks++;
+                }
+                else
+                {
+                    report->FreeBlocks++;
+                    report->FreeSize += size;
+                    report->LargestFreeSize = size > report->LargestFreeSize ? size : report->LargestFreeSize;
+                }
+            }
+
+        public:
+
+            /** @brief Free allocated memory
+             * @param zone Memory zone
+             * @param ptr Pointer to allocated memory
+             */
+            inline static void Free(const MemoryZone& zone, void* ptr)
+            {
+                tlsf_free(reinterpret_cast<tlsf_t>(zone.Address), ptr);
+            }
+
+            /** @brief Get report on the allocator in specified memory zone
+             * @param zone Memory zone
+             * @return State report
+             */
+            inline static const Report GetReport(const MemoryZone& zone)
+            {
+                // Allocator state is counted as header
+                auto report = Report { tlsf_size(), 0, 0, zone.Size, 0, 0 };
+                tlsf_walk_pool(tlsf_get_pool(reinterpret_cast<tlsf_t>(zone.Address)), TlsfMalloc::WalkBlock, &report);
+                return report;
+            }
+
+            /** @brief Initializes a new memory zone and returns its starting address
+             * @param start Start of the memory zone
+             * @param size Size of the memory zone
+             * @return Zone start address
+             */
+            inline static void* InitializeZone(void* start, const size_t size)
+            {
+                return tlsf_create_with_pool(start, size);
+            }
+
+            /** @brief Allocate memory
+             * @param zone Memory zone
+             * @param size Number of bytes to allocate
+             * @return Pointer to allocated memory or nullptr
+             */
+            inline static void* Malloc(const MemoryZone& zone, size_t size)
+            {
+                return tlsf_malloc(reinterpret_cast<tlsf_t>(zone.Address), size);
+            }
+
+            /** @brief Reallocate existing memory
+             * @param zone Memory zone
+             * @param ptr Pointer to the existing allocated memory
+             * @param size New size in number of bytes
+             * @return Pointer to reallocated memory or nullptr
+             */
+            inline static void* Realloc(const MemoryZone& zone, void* ptr, size_t size)
+            {
+                return tlsf_realloc(reinterpret_cast<tlsf_t>(zone.Address), ptr, size);
+            }
+        };
+
+        /** @brief Allocator used by memory zones
+         */
+        using ZoneAllocator = Memory::TlsfMalloc;
+#elif defined(USE_SEGREGATED_ALLOCATOR)
+        /** @brief Allocator used by memory zones
+         */
+        using ZoneAllocator = Memory::SegregatedMalloc;
+#else
+        /** @brief Allocator used by memory zones
+         */
+        using ZoneAllocator = Memory::SimpleMalloc;
+#endif
+        
+    public:
+
+        /** @brief Memory zone codes
+         */
+        enum class Zone
+        {
+            /** @brief High (main) system RAM
+             */
+            HWRam = 0,
+
+            /** @brief Low system RAM
+             */
+            LWRam = 1,
+
+            /** @brief Expansion cart RAM
+             */
+            CartRam = 2,
+
+            /** @brief Per-frame arena (see Memory::FrameArena)
+             */
+            Frame = 3
+        };
+
+        /** @brief Allocation classes used to pick memory zone (see Memory::Placement)
+         */
+        enum class AllocationClass : uint8_t
+        {
+            /** @brief Frequently accessed data that must stay in fast memory
+             */
+            Hot = 0,
+
+            /** @brief Allocations made by plain @c new
+             */
+            Default = 1,
+
+            /** @brief Large rarely touched data (level data, decompressed assets, etc...)
+             */
+            Bulk = 2
+        };
+
+        /** @brief Malloc for main system RAM
+         */
+        class HighWorkRam
+        {
+        private:
+        
+            /** @brief Memory class needs to be able to see private members to initialize zones
+             */
+            friend class Memory;
+
+            /** @brief Main system memory zone
+             * @note This is assigned on system initialization
+             */
+            inline static MemoryZone zone;
+
+            /** @brief Full main system memory zone
+             */
+            inline static const MemoryZone fullZone = { (void*)0x06000000, 0x07FFFFFF - 0x06000000};
+
+            /** @brief Initialize memory zone
+             */
+            inline static void Initialize()
+            {
+                auto address = reinterpret_cast<void*>(&_heap_start);
+                auto size = reinterpret_cast<size_t>(&_heap_end) - reinterpret_cast<size_t>(&_heap_start);
+
+                HighWorkRam::zone = Memory::MemoryZone
+                {
+                    Memory::ZoneAllocator::InitializeZone(address, size),
+                    size
+                };
+            }
+            
+        public:
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            static bool InRange(void* ptr)
+            {
+                return Memory::InZone(HighWorkRam::fullZone, ptr);
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            static bool InRange(uint32_t ptr)
+            {
+                return Memory::InZone(HighWorkRam::fullZone, (void*)ptr);
+            }
+
+            /** @brief Free allocated memory
+             * @param ptr Pointer to allocated memory
+             */
+            static void Free(void* ptr)
+            {
+                #if defined(SRL_MEMORY_PROFILER)
+                Memory::Profiler::OnFree(ptr);
                 #endif
+
+                Memory::ZoneAllocator::Free(HighWorkRam::zone, ptr);
+            }
+
+            /** @brief Allocate some memory
+             * @param size Number of bytes to allocate
+             * @return Pointer to the allocated space in memory
+             */
+            static void* Malloc(size_t size)
+            {
+                void* ptr = Memory::ZoneAllocator::Malloc(HighWorkRam::zone, size);
+
+                #if defined(SRL_MEMORY_PROFILER)
+                Memory::Profiler::OnMalloc(Zone::HWRam, ptr, size);
+                #endif
+
+                return ptr;
+            }
+
+            /** @brief Reallocate existing memory
+             * @param ptr Pointer to the existing allocated memory
+             * @param size New size in number of bytes that should be allocated
+             * @return Pointer to the allocated space in memory
+             */
+            static void* Realloc(void* ptr, size_t size)
+            {
+                #if defined(SRL_MEMORY_PROFILER)
+                void* result = Memory::ZoneAllocator::Realloc(HighWorkRam::zone, ptr, size);
+                Memory::Profiler::OnRealloc(Zone::HWRam, ptr, result, size);
+                return result;
+                #else
+                return Memory::ZoneAllocator::Realloc(HighWorkRam::zone, ptr, size);
+                #endif
+            }
+
+            /** @brief Gets total size of the free space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetFreeSpace()
+            {
+                return Memory::ZoneAllocator::GetReport(HighWorkRam::zone).FreeSize;
+            }
+
+            /** @brief Gets report on the allocator state
+             * @return Current state of the allocator
+             */
+            static const Report GetReport()
+            {
+                return Memory::ZoneAllocator::GetReport(HighWorkRam::zone);
+            }
+
+            /** @brief Gets total size of the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetSize()
+            {
+                return HighWorkRam::zone.Size;
+            }
+            
+            /** @brief Gets total size of the used space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetUsedSpace()
+            {
+                auto report = Memory::ZoneAllocator::GetReport(HighWorkRam::zone);
+                return report.TotalSize - report.FreeSize;
+            }
+
+        };
+
+        /** @brief Malloc for slower system RAM
+         */
+        class LowWorkRam
+        {
+        private:
+
+            /** @brief Memory class needs to be able to see private members to initialize zones
+             */
+            friend class Memory;
+
+            /** @brief Memory zone
+             */
+            inline static Memory::MemoryZone zone;
+
+            /** @brief Initialize memory zone
+             */
+            inline static void Initialize()
+            {
+                const volatile void* address = (void*)0x00200000;
+                const uint32_t size = 0x100000;
+
+                LowWorkRam::zone = Memory::MemoryZone
+                {
+                    Memory::ZoneAllocator::InitializeZone((void*)address, size),
+                    size
+                };
+            }
+            
+        public:
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(void* ptr)
+            {
+                return Memory::InZone(LowWorkRam::zone, ptr);
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param zoneAddress Zone address to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(uint32_t zoneAddress)
+            {
+                return Memory::InZone(LowWorkRam::zone, (void*)zoneAddress);
+            }
+
+            /** @brief Free allocated memory
+             * @param ptr Pointer to allocated memory
+             */
+            inline static void Free(void* ptr)
+            {
+                #if defined(SRL_MEMORY_PROFILER)
+                Memory::Profiler::OnFree(ptr);
+                #endif
+
+                Memory::ZoneAllocator::Free(LowWorkRam::zone, ptr);
+            }
+
+            /** @brief Allocate some memory
+             * @param size Number of bytes to allocate
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Malloc(size_t size)
+            {
+                void* ptr = Memory::ZoneAllocator::Malloc(LowWorkRam::zone, size);
+
+                #if defined(SRL_MEMORY_PROFILER)
+                Memory::Profiler::OnMalloc(Zone::LWRam, ptr, size);
+                #endif
+
+                return ptr;
+            }
+
+           /** @brief Reallocate existing memory
+            * @param ptr Pointer to the existing allocated memory
+            * @param size New size in number of bytes that should be allocated
+            * @return Pointer to the allocated space in memory
+            */
+            inline static void* Realloc(void* ptr, size_t size)
+            {
+                #if defined(SRL_MEMORY_PROFILER)
+                void* result = Memory::ZoneAllocator::Realloc(LowWorkRam::zone, ptr, size);
+                Memory::Profiler::OnRealloc(Zone::LWRam, ptr, result, size);
+                return result;
+                #else
+                return Memory::ZoneAllocator::Realloc(LowWorkRam::zone, ptr, size);
+                #endif
+            }
+
+            /** @brief Gets total size of the free space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetFreeSpace()
+            {
+                return Memory::ZoneAllocator::GetReport(LowWorkRam::zone).FreeSize;
+            }
+
+            /** @brief Gets report on the allocator state
+             * @return Current state of the allocator
+             */
+            static const Report GetReport()
+            {
+                return Memory::ZoneAllocator::GetReport(LowWorkRam::zone);
+            }
+
+            /** @brief Gets total size of the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetSize()
+            {
+                return LowWorkRam::zone.Size;
+            }
+            
+            /** @brief Gets total size of the used space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetUsedSpace()
+            {
+                auto report = Memory::ZoneAllocator::GetReport(LowWorkRam::zone);
+                return report.TotalSize - report.FreeSize;
+            }
+        };
+
+        /** @brief Malloc for expansion cart RAM
+         */
+        class CartRam
+        {
+        public:
+
+            /** @brief Number of RAM banks on the cartridge
+             */
+            inline static const uint8_t BankCount = 2;
+
+            /** @brief Type of the cartridge reported by its ID
+             */
+            enum class CartType : uint8_t
+            {
+                /** @brief No RAM cartridge present
+                 */
+                None = 0x00,
+
+                /** @brief 1MB (8Mbit) RAM cartridge, two 512KB banks
+                 */
+                Ram1MB = 0x5a,
+
+                /** @brief 4MB (32Mbit) RAM cartridge, two 2MB banks
+                 */
+                Ram4MB = 0x5c
+            };
+
+        private:
+
+            /** @brief Memory class needs to be able to see private members to initialize zones
+             */
+            friend class Memory;
+
+            /** @brief Cartridge ID register
+             */
+            inline static const uint32_t IdAddress = 0x24ffffff;
+
+            /** @brief Cartridge RAM enable register
+             */
+            inline static const uint32_t EnableAddress = 0x257efffe;
+
+            /** @brief SCU A-bus set register for CS0
+             */
+            inline static const uint32_t AbusSetAddress = 0x25fe00b0;
+
+            /** @brief SCU A-bus refresh register
+             */
+            inline static const uint32_t AbusRefreshAddress = 0x25fe00b8;
+
+            /** @brief Start of each bank (cache-through address)
+             */
+            inline static const uint32_t BankAddress[CartRam::BankCount] = { 0x22400000, 0x22600000 };
+
+            /** @brief Largest possible bank size
+             */
+            inline static const size_t MaxBankSize = 0x200000;
+
+            /** @brief Smallest possible bank size, also the step used when probing for mirrors
+             */
+            inline static const size_t MinBankSize = 0x80000;
+
+            /** @brief Detected cartridge
+             */
+            inline static CartType type = CartType::None;
+
+            /** @brief Address range of each detected bank
+             */
+            inline static Memory::MemoryZone banks[CartRam::BankCount];
+
+            /** @brief Heap of each detected bank
+             */
+            inline static Memory::MemoryZone zones[CartRam::BankCount];
+
+            /** @brief Find size of RAM bank by looking for the point where its start address mirrors
+             * @param address Cache-through start address of the bank
+             * @return Size of the bank in bytes, 0 if there is no working RAM
+             */
+            inline static size_t ProbeBank(uint32_t address)
+            {
+                volatile uint32_t* start = reinterpret_cast<volatile uint32_t*>(address);
+                const uint32_t saved = *start;
+                size_t size = CartRam::MinBankSize;
+
+                *start = 0x5aa5c33c;
+
+                if (*start != 0x5aa5c33c)
+                {
+                    *start = saved;
+                    return 0;
+                }
+
+                // Smaller RAM chips repeat over the whole bank window, write past the end shows up at the start
+                while (size < CartRam::MaxBankSize)
+                {
+                    volatile uint32_t* mirror = reinterpret_cast<volatile uint32_t*>(address + size);
+                    const uint32_t savedMirror = *mirror;
+
+                    *mirror = 0xa55a3cc3;
+                    const bool wrapped = *start == 0xa55a3cc3;
+                    *mirror = savedMirror;
+
+                    if (wrapped)
+                    {
+                        break;
+                    }
+
+                    size <<= 1;
+                }
+
+                *start = saved;
+                return size;
+            }
+
+            /** @brief Find bank the pointer belongs to
+             * @param ptr Pointer to check
+             * @return Bank index, -1 if pointer is not in cartridge RAM
+             */
+            inline static int8_t GetBankIndex(void* ptr)
+            {
+                for (uint8_t bank = 0; bank < CartRam::BankCount; bank++)
+                {
+                    if (CartRam::banks[bank].Address != nullptr && Memory::InZone(CartRam::banks[bank], ptr))
+                    {
+                        return bank;
+                    }
+                }
+
+                return -1;
+            }
+
+            /** @brief Detect cartridge and initialize heap in each of its banks
+             */
+            inline static void Initialize()
+            {
+                const uint8_t id = *reinterpret_cast<volatile uint8_t*>(CartRam::IdAddress);
+
+                if (id != static_cast<uint8_t>(CartType::Ram1MB) && id != static_cast<uint8_t>(CartType::Ram4MB))
+                {
+                    return;
+                }
+
+                // Set A-bus timing and enable writes to cartridge RAM
+                *reinterpret_cast<volatile uint32_t*>(CartRam::AbusSetAddress) = 0x23301ff0;
+                *reinterpret_cast<volatile uint32_t*>(CartRam::AbusRefreshAddress) = 0x00000013;
+                *reinterpret_cast<volatile uint16_t*>(CartRam::EnableAddress) = 0x0001;
+
+                const size_t expectedSize = id == static_cast<uint8_t>(CartType::Ram4MB) ? CartRam::MaxBankSize : CartRam::MinBankSize;
+
+                for (uint8_t bank = 0; bank < CartRam::BankCount; bank++)
+                {
+                    const size_t probedSize = CartRam::ProbeBank(CartRam::BankAddress[bank]);
+                    const size_t size = probedSize < expectedSize ? probedSize : expectedSize;
+
+                    if (size > 0)
+                    {
+                        // Heap uses cached mirror of the bank, same as work RAM
+                        void* address = reinterpret_cast<void*>(CartRam::BankAddress[bank] & 0x0fffffff);
+                        CartRam::banks[bank] = Memory::MemoryZone { address, size };
+                        CartRam::zones[bank] = Memory::MemoryZone { Memory::ZoneAllocator::InitializeZone(address, size), size };
+                        CartRam::type = static_cast<CartType>(id);
+                    }
+                }
+            }
+            
+        public:
+
+            /** @brief Get detected cartridge type
+             * @return Cartridge type, CartType::None if there is no usable RAM cartridge
+             */
+            inline static CartType GetType()
+            {
+                return CartRam::type;
+            }
+
+            /** @brief Get size of the bank
+             * @param bank Bank index
+             * @return Number of bytes, 0 if bank is not present
+             */
+            inline static size_t GetBankSize(uint8_t bank)
+            {
+                return bank < CartRam::BankCount ? CartRam::banks[bank].Size : 0;
+            }
+
+            /** @brief Get start address of the bank
+             * @param bank Bank index
+             * @return Start of the bank, nullptr if bank is not present
+             */
+            inline static void* GetBankAddress(uint8_t bank)
+            {
+                return bank < CartRam::BankCount ? CartRam::banks[bank].Address : nullptr;
+            }
+
+            /** @brief Gets report on the allocator state of single bank
+             * @param bank Bank index
+             * @return Current state of the bank allocator
+             */
+            static const Report GetBankReport(uint8_t bank)
+            {
+                if (bank < CartRam::BankCount && CartRam::zones[bank].Address != nullptr)
+                {
+                    return Memory::ZoneAllocator::GetReport(CartRam::zones[bank]);
+                }
+
+                return Report { 0, 0, 0, 0, 0, 0 };
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(void* ptr)
+            {
+                return CartRam::GetBankIndex(ptr) >= 0;
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param zoneAddress Address in the memory zone where object should be allocated
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(uint32_t zoneAddress)
+            {
+                return CartRam::InRange(reinterpret_cast<void*>(zoneAddress));
+            }
+
+            /** @brief Free allocated memory
+             * @param ptr Pointer to allocated memory
+             */
+            inline static void Free(void* ptr)
+            {
+                const int8_t bank = CartRam::GetBankIndex(ptr);
+
+                if (bank >= 0)
+                {
+                    #if defined(SRL_MEMORY_PROFILER)
+                    Memory::Profiler::OnFree(ptr);
+                    #endif
+
+                    Memory::ZoneAllocator::Free(CartRam::zones[bank], ptr);
+                }
+            }
+
+            /** @brief Allocate some memory
+             * @note Banks are separate heaps, single allocation cannot be larger than one bank
+             * @param size Number of bytes to allocate
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Malloc(size_t size)
+            {
+                void* ptr = nullptr;
+
+                for (uint8_t bank = 0; bank < CartRam::BankCount && ptr == nullptr; bank++)
+                {
+                    if (CartRam::zones[bank].Address != nullptr)
+                    {
+                        ptr = Memory::ZoneAllocator::Malloc(CartRam::zones[bank], size);
+                    }
+                }
+
+                #if defined(SRL_MEMORY_PROFILER)
+                if (CartRam::type != CartType::None)
+                {
+                    Memory::Profiler::OnMalloc(Zone::CartRam, ptr, size);
+                }
+                #endif
+
+                return ptr;
+            }
+
+            /** @brief Reallocate existing memory
+             * @note Memory is reallocated within the bank it was allocated in
+             * @param ptr Pointer to the existing allocated memory
+             * @param size New size in number of bytes that should be allocated
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Realloc(void* ptr, size_t size)
+            {
+                if (ptr == nullptr)
+                {
+                    return CartRam::Malloc(size);
+                }
+
+                const int8_t bank = CartRam::GetBankIndex(ptr);
+
+                if (bank >= 0)
+                {
+                    #if defined(SRL_MEMORY_PROFILER)
+                    void* result = Memory::ZoneAllocator::Realloc(CartRam::zones[bank], ptr, size);
+                    Memory::Profiler::OnRealloc(Zone::CartRam, ptr, result, size);
+                    return result;
+                    #else
+                    return Memory::ZoneAllocator::Realloc(CartRam::zones[bank], ptr, size);
+                    #endif
+                }
+
+                return nullptr;
+            }
+
+            /** @brief Gets total size of the free space in the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetFreeSpace()
+            {
+                return CartRam::GetReport().FreeSize;
+            }
+
+            /** @brief Gets report on the allocator state, combined for all banks
+             * @return Current state of the allocator
+             */
+            static const Report GetReport()
+            {
+                Report report = { 0, 0, 0, 0, 0, 0 };
+
+                for (uint8_t bank = 0; bank < CartRam::BankCount; bank++)
+                {
+                    const Report bankReport = CartRam::GetBankReport(bank);
+                    report.AllocationHeaders += bankReport.AllocationHeaders;
+                    report.FreeBlocks += bankReport.FreeBlocks;
+                    report.FreeSize += bankReport.FreeSize;
+                    report.TotalSize += bankReport.TotalSize;
+                    report.UsedBlocks += bankReport.UsedBlocks;
+                    report.LargestFreeSize = bankReport.LargestFreeSize > report.LargestFreeSize ? bankReport.LargestFreeSize : report.LargestFreeSize;
+                }
+
+                return report;
+            }
+
+            /** @brief Gets total size of the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetSize()
+            {
+                return CartRam::GetBankSize(0) + CartRam::GetBankSize(1);
+            }
+            
+            /** @brief Gets total size of the used space in the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetUsedSpace()
+            {
+                auto report = CartRam::GetReport();
+                return report.TotalSize - report.FreeSize;
+            }
+        };
+
+        /** @brief Double-buffered bump allocator for data that lives at most until the end of the next frame
+         * @details Arena is carved from one of the memory zones and split into two halves. Allocation is just a pointer increment in the current half.
+         * Halves are swapped after each Core::Synchronize(), which resets the half that is going to be used next,
+         * so memory allocated in one frame stays valid during the following frame as well.<br/>
+         * Freeing memory allocated in the arena does nothing, destructors are still called when using @c delete.
+         * @code {.cpp}
+         * // Reserve 2x16KB in low work RAM
+         * SRL::Memory::FrameArena::Initialize(16384, SRL::Memory::Zone::LWRam);
+         *
+         * while (1)
+         * {
+         *      // Temporary list, no need to delete it
+         *      SpriteEntry* entries = framenew SpriteEntry[count];
+         *
+         *      SRL::Core::Synchronize();
+         * }
+         * @endcode
+         */
+        class FrameArena
+        {
+        private:
+
+            /** @brief Memory class needs to be able to see private members
+             */
+            friend class Memory;
+
+            /** @brief Arena halves
+             */
+            inline static uint8_t* buffers[2] = { nullptr, nullptr };
+
+            /** @brief Size of one half of the arena
+             */
+            inline static size_t bufferSize = 0;
+
+            /** @brief Index of the half allocations are made from
+             */
+            inline static uint8_t current = 0;
+
+            /** @brief Number of bytes allocated in the current half
+             */
+            inline static size_t offset = 0;
+
+            /** @brief Number of allocations made in the current half
+             */
+            inline static size_t allocations = 0;
+
+            /** @brief Highest number of bytes allocated in a single frame
+             */
+            inline static size_t peak = 0;
+
+        public:
+
+            /** @brief Allocate the arena
+             * @param size Number of bytes available for allocations in a single frame (arena takes twice as much)
+             * @param zone Memory zone to take the arena from
+             * @return true if arena was allocated
+             */
+            inline static bool Initialize(const size_t size, const Zone zone = Zone::HWRam)
+            {
+                if (FrameArena::buffers[0] != nullptr || zone == Zone::Frame)
+                {
+                    return false;
+                }
+
+                const size_t length = (size + 3) & ~((size_t)3);
+                uint8_t* memory = reinterpret_cast<uint8_t*>(Memory::Malloc(length << 1, zone));
+
+                if (memory != nullptr)
+                {
+                    FrameArena::buffers[0] = memory;
+                    FrameArena::buffers[1] = memory + length;
+                    FrameArena::bufferSize = length;
+                    FrameArena::current = 0;
+                    FrameArena::offset = 0;
+                    FrameArena::allocations = 0;
+                    FrameArena::peak = 0;
+                    return true;
+                }
+
+                return false;
+            }
+
+            /** @brief Return arena memory back to its zone
+             * @warning All pointers to objects allocated in the arena become invalid
+             */
+            inline static void Release()
+            {
+                if (FrameArena::buffers[0] != nullptr)
+                {
+                    uint8_t* memory = FrameArena::buffers[0];
+                    FrameArena::buffers[0] = nullptr;
+                    FrameArena::buffers[1] = nullptr;
+                    FrameArena::bufferSize = 0;
+                    FrameArena::offset = 0;
+                    FrameArena::allocations = 0;
+                    Memory::Free(memory);
+                }
+            }
+
+            /** @brief Switch to the other half of the arena and reset it
+             * @note This is called automatically from Core::OnAfterSync
+             */
+            inline static void Swap()
+            {
+                FrameArena::current ^= 1;
+                FrameArena::offset = 0;
+                FrameArena::allocations = 0;
+            }
+
+            /** @brief Check whether pointer is in range of the arena
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the arena
+             */
+            inline static bool InRange(void* ptr)
+            {
+                return FrameArena::buffers[0] != nullptr &&
+                    ptr >= FrameArena::buffers[0] &&
+                    ptr < FrameArena::buffers[1] + FrameArena::bufferSize;
+            }
+
+            /** @brief Check whether pointer is in range of the arena
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the arena
+             */
+            inline static bool InRange(uint32_t ptr)
+            {
+                return FrameArena::InRange((void*)ptr);
+            }
+
+            /** @brief Allocate some memory valid until the end of the next frame
+             * @param size Number of bytes to allocate
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Malloc(size_t size)
+            {
+                const size_t length = (size + 3) & ~((size_t)3);
+
+                if (FrameArena::buffers[0] != nullptr && length <= FrameArena::bufferSize - FrameArena::offset)
+                {
+                    void* ptr = FrameArena::buffers[FrameArena::current] + FrameArena::offset;
+                    FrameArena::offset += length;
+                    FrameArena::allocations++;
+                    FrameArena::peak = FrameArena::offset > FrameArena::peak ? FrameArena::offset : FrameArena::peak;
+                    return ptr;
+                }
+
+                return nullptr;
+            }
+
+            /** @brief Gets total size of the free space left for the current frame
+             * @return Number of bytes
+             */
+            inline static size_t GetFreeSpace()
+            {
+                return FrameArena::bufferSize - FrameArena::offset;
+            }
+
+            /** @brief Gets number of bytes available for a single frame
+             * @return Number of bytes
+             */
+            inline static size_t GetSize()
+            {
+                return FrameArena::bufferSize;
+            }
+
+            /** @brief Gets number of bytes allocated in the current frame
+             * @return Number of bytes
+             */
+            inline static size_t GetUsedSpace()
+            {
+                return FrameArena::offset;
+            }
+
+            /** @brief Gets highest number of bytes allocated in a single frame since initialization
+             * @return Number of bytes
+             */
+            inline static size_t GetPeakUsedSpace()
+            {
+                return FrameArena::peak;
+            }
+
+            /** @brief Gets report on the current frame
+             * @return Current state of the allocator
+             */
+            static const Report GetReport()
+            {
+                const size_t freeSize = FrameArena::GetFreeSpace();
+                return Report { 0, freeSize > 0 ? 1U : 0U, freeSize, FrameArena::bufferSize, FrameArena::allocations, freeSize };
+            }
+        };
+
+        /** @brief Fixed-size pool of objects of the same type
+         * @details Storage for all objects is allocated at once in the specified memory zone. Free slots are chained through their own storage,
+         * so acquiring and releasing an object takes constant time and has no per-object header.<br/>
+         * Objects are referenced by handles, each handle carries generation of the slot it points to,
+         * so handle of a released object cannot be used to access another object that reused the same slot.
+         * @code {.cpp}
+         * SRL::Memory::Pool<Bullet, 256, SRL::Memory::Zone::LWRam> bullets;
+         *
+         * auto handle = bullets.Acquire(position, velocity);
+         *
+         * for (Bullet& bullet : bullets)
+         * {
+         *      bullet.Update();
+         * }
+         *
+         * bullets.Release(handle);
+         * @endcode
+         * @tparam Type Type of the stored object (alignment must not exceed 4 bytes)
+         * @tparam Capacity Maximal number of objects in the pool
+         * @tparam PoolZone Memory zone to allocate the pool storage in
+         */
+        template <typename Type, size_t Capacity, Zone PoolZone = Zone::HWRam>
+        class Pool
+        {
+            static_assert(Capacity > 0 && Capacity < 0xffff, "Pool capacity must be between 1 and 65534");
+            static_assert(alignof(Type) <= 4, "Pool storage is only 4 byte aligned");
+
+        public:
+
+            /** @brief Reference to an object in the pool
+             */
+            struct Handle
+            {
+                /** @brief Slot index
+                 */
+                uint16_t Index;
+
+                /** @brief Generation of the slot at the time object was acquired
+                 */
+                uint16_t Generation;
+
+                /** @brief Construct a null handle
+                 */
+                Handle() : Index(0xffff), Generation(0)
+                {
+                    // Do nothing
+                }
+
+                /** @brief Construct a new handle
+                 * @param index Slot index
+                 * @param generation Slot generation
+                 */
+                Handle(const uint16_t index, const uint16_t generation) : Index(index), Generation(generation)
+                {
+                    // Do nothing
+                }
+
+                /** @brief Check whether handle does not point to anything
+                 * @return true if handle is null
+                 */
+                bool IsNull() const
+                {
+                    return this->Index == 0xffff;
+                }
+
+                /** @brief Compare two handles
+                 * @param other Other handle
+                 * @return true if handles are equal
+                 */
+                bool operator==(const Handle& other) const
+                {
+                    return this->Index == other.Index && this->Generation == other.Generation;
+                }
+            };
+
+        private:
+
+            /** @brief Marks end of the free slot chain
+             */
+            static constexpr uint16_t EndOfList = 0xffff;
+
+            /** @brief Size of one slot (must be able to hold index of the next free slot)
+             */
+            static constexpr size_t SlotSize = ((sizeof(Type) > sizeof(uint32_t) ? sizeof(Type) : sizeof(uint32_t)) + 3) & ~((size_t)3);
+
+            /** @brief Object storage
+             */
+            uint8_t* slots;
+
+            /** @brief Slot generations, odd generation means slot holds a live object
+             */
+            uint16_t* generations;
+
+            /** @brief First free slot
+             */
+            uint16_t freeHead;
+
+            /** @brief Number of live objects
+             */
+            size_t count;
+
+            /** @brief Highest number of live objects at once
+             */
+            size_t peak;
+
+            /** @brief Get slot storage
+             * @param index Slot index
+             * @return Pointer to slot storage
+             */
+            uint8_t* GetSlot(const size_t index) const
+            {
+                return this->slots + (index * Pool::SlotSize);
+            }
+
+            /** @brief Get index of the next free slot stored inside free slot
+             * @param index Free slot index
+             * @return Reference to the next free slot index
+             */
+            uint16_t& NextFree(const size_t index) const
+            {
+                return *reinterpret_cast<uint16_t*>(this->GetSlot(index));
+            }
+
+            /** @brief Check whether slot holds a live object
+             * @param index Slot index
+             * @return true if slot is in use
+             */
+            bool IsLive(const size_t index) const
+            {
+                return (this->generations[index] & 1) != 0;
+            }
+
+        public:
+
+            /** @brief Iterator over live objects
+             */
+            class Iterator
+            {
+            private:
+
+                /** @brief Iterated pool
+                 */
+                const Pool* pool;
+
+                /** @brief Current slot
+                 */
+                size_t index;
+
+                /** @brief Move to the nearest live object
+                 */
+                void SkipFree()
+                {
+                    while (this->index < Capacity && !this->pool->IsLive(this->index))
+                    {
+                        this->index++;
+                    }
+                }
+
+            public:
+
+                /** @brief Construct a new iterator
+                 * @param pool Iterated pool
+                 * @param index Starting slot
+                 */
+                Iterator(const Pool* pool, const size_t index) : pool(pool), index(index)
+                {
+                    this->SkipFree();
+                }
+
+                /** @brief Get current object
+                 * @return Object reference
+                 */
+                Type& operator*() const
+                {
+                    return *reinterpret_cast<Type*>(this->pool->GetSlot(this->index));
+                }
+
+                /** @brief Get current object
+                 * @return Object pointer
+                 */
+                Type* operator->() const
+                {
+                    return reinterpret_cast<Type*>(this->pool->GetSlot(this->index));
+                }
+
+                /** @brief Move to the next live object
+                 * @return Iterator
+                 */
+                Iterator& operator++()
+                {
+                    this->index++;
+                    this->SkipFree();
+                    return *this;
+                }
+
+                /** @brief Compare iterators
+                 * @param other Other iterator
+                 * @return true if iterators point to different slots
+                 */
+                bool operator!=(const Iterator& other) const
+                {
+                    return this->index != other.index;
+                }
+
+                /** @brief Get handle of the current object
+                 * @return Object handle
+                 */
+                Handle GetHandle() const
+                {
+                    return Handle(this->index, this->pool->generations[this->index]);
+                }
+            };
+
+            /** @brief Construct a new pool, storage is allocated in the pool memory zone
+             */
+            Pool() : slots(nullptr), generations(nullptr), freeHead(Pool::EndOfList), count(0), peak(0)
+            {
+                this->slots = reinterpret_cast<uint8_t*>(Memory::Malloc((Pool::SlotSize * Capacity) + (sizeof(uint16_t) * Capacity), PoolZone));
+
+                if (this->slots != nullptr)
+                {
+                    this->generations = reinterpret_cast<uint16_t*>(this->slots + (Pool::SlotSize * Capacity));
+
+                    // Chain all slots together
+                    for (size_t index = 0; index < Capacity; index++)
+                    {
+                        this->generations[index] = 0;
+                        this->NextFree(index) = index + 1 < Capacity ? index + 1 : Pool::EndOfList;
+                    }
+
+                    this->freeHead = 0;
+                }
+            }
+
+            /** @brief Pool cannot be copied
+             */
+            Pool(const Pool&) = delete;
+
+            /** @brief Pool cannot be copied
+             */
+            Pool& operator=(const Pool&) = delete;
+
+            /** @brief Destroy all live objects and free the pool storage
+             */
+            ~Pool()
+            {
+                if (this->slots != nullptr)
+                {
+                    this->Clear();
+                    Memory::Free(this->slots);
+                }
+            }
+
+            /** @brief Construct a new object in the pool
+             * @param args Constructor arguments
+             * @return Handle of the new object, null handle if pool is full
+             */
+            template <typename ...Args>
+            Handle Acquire(Args&&... args)
+            {
+                if (this->freeHead == Pool::EndOfList)
+                {
+                    return Handle();
+                }
+
+                const uint16_t index = this->freeHead;
+                this->freeHead = this->NextFree(index);
+                this->generations[index]++;
+                this->count++;
+                this->peak = this->count > this->peak ? this->count : this->peak;
+
+                new (static_cast<void*>(this->GetSlot(index))) Type(static_cast<Args&&>(args)...);
+                return Handle(index, this->generations[index]);
+            }
+
+            /** @brief Get object from handle
+             * @param handle Object handle
+             * @return Pointer to object or nullptr if handle is not valid anymore
+             */
+            Type* Get(const Handle& handle) const
+            {
+                if (handle.Index < Capacity && this->slots != nullptr && this->generations[handle.Index] == handle.Generation && this->IsLive(handle.Index))
+                {
+                    return reinterpret_cast<Type*>(this->GetSlot(handle.Index));
+                }
+
+                return nullptr;
+            }
+
+            /** @brief Destroy object and return its slot back to the pool
+             * @param handle Object handle
+             * @return true if object was released, false if handle is not valid
+             */
+            bool Release(const Handle& handle)
+            {
+                Type* object = this->Get(handle);
+
+                if (object != nullptr)
+                {
+                    object->~Type();
+                    this->generations[handle.Index]++;
+                    this->NextFree(handle.Index) = this->freeHead;
+                    this->freeHead = handle.Index;
+                    this->count--;
+                    return true;
+                }
+
+                return false;
+            }
+
+            /** @brief Release all live objects
+             */
+            void Clear()
+            {
+                for (size_t index = 0; index < Capacity; index++)
+                {
+                    if (this->IsLive(index))
+                    {
+                        this->Release(Handle(index, this->generations[index]));
+                    }
+                }
+            }
+
+            /** @brief Check whether pool storage was allocated
+             * @return true if pool can be used
+             */
+            bool IsValid() const
+            {
+                return this->slots != nullptr;
+            }
+
+            /** @brief Get number of live objects
+             * @return Number of objects
+             */
+            size_t GetCount() const
+            {
+                return this->count;
+            }
+
+            /** @brief Get highest number of live objects at once
+             * @return Number of objects
+             */
+            size_t GetPeakCount() const
+            {
+                return this->peak;
+            }
+
+            /** @brief Get maximal number of objects in the pool
+             * @return Number of objects
+             */
+            static constexpr size_t GetCapacity()
+            {
+                return Capacity;
+            }
+
+            /** @brief Gets report on the pool occupancy
+             * @note Slot generations are counted as allocation headers, one block is one slot
+             * @return Current state of the pool
+             */
+            const Report GetReport() const
+            {
+                const size_t freeSlots = this->slots != nullptr ? Capacity - this->count : 0;
+
+                return Report {
+                    sizeof(uint16_t) * Capacity,
+                    freeSlots,
+                    freeSlots * Pool::SlotSize,
+                    (Pool::SlotSize + sizeof(uint16_t)) * Capacity,
+                    this->count,
+                    freeSlots > 0 ? Pool::SlotSize : 0
+                };
+            }
+
+            /** @brief Get iterator pointing to the first live object
+             * @return Iterator
+             */
+            Iterator begin() const
+            {
+                return Iterator(this, 0);
+            }
+
+            /** @brief Get iterator pointing past the last slot
+             * @return Iterator
+             */
+            Iterator end() const
+            {
+                return Iterator(this, Capacity);
+            }
+        };
+
+#if defined(SRL_MEMORY_PROFILER)
+        /** @brief Allocation profiler
+         * @details Enabled by setting @c SRL_MEMORY_PROFILER = 1 in the project makefile.
+         * Every allocation made in work RAM or cart RAM zones is recorded together with the currently active tag,
+         * so it is possible to tell which part of the game holds how much memory.<br/>
+         * Frame counters are rolled over after each Core::Synchronize().
+         * Use Debug::PrintMemoryProfile() or Logger::LogMemoryProfile() to output the collected data.
+         * @code {.cpp}
+         * {
+         *      SRL::Memory::Profiler::Scope scope("Level");
+         *
+         *      // Both allocations are counted under "Level" tag
+         *      level = new Level();
+         *      enemies = lwnew Enemy[20];
+         * }
+         * @endcode
+         * @note Profiler keeps a table of live allocations, its size is set by @c SRL_MEMORY_PROFILER_MAX_ALLOCATIONS (1024 by default).
+         * Allocations that do not fit into the table are only counted as untracked.
+         */
+        class Profiler
+        {
+        public:
+
+            /** @brief Statistics of one tag
+             */
+            struct TagStats
+            {
+                /** @brief Tag name
+                 */
+                const char* Name;
+
+                /** @brief Number of bytes currently allocated
+                 */
+                size_t Bytes;
+
+                /** @brief Highest number of bytes allocated at once
+                 */
+                size_t PeakBytes;
+
+                /** @brief Number of live allocations
+                 */
+                size_t Blocks;
+            };
+
+            /** @brief Statistics of one memory zone
+             */
+            struct ZoneStats
+            {
+                /** @brief Number of bytes currently allocated
+                 */
+                size_t Bytes;
+
+                /** @brief Highest number of bytes allocated at once
+                 */
+                size_t PeakBytes;
+
+                /** @brief Number of allocations in the last finished frame
+                 */
+                size_t FrameAllocations;
+
+                /** @brief Number of frees in the last finished frame
+                 */
+                size_t FrameFrees;
+
+                /** @brief Number of allocated bytes in the last finished frame
+                 */
+                size_t FrameBytes;
+
+                /** @brief Number of allocations that failed
+                 */
+                size_t Failures;
+            };
+
+            /** @brief Sets tag for the lifetime of the scope and restores previous one afterwards
+             */
+            class Scope
+            {
+            private:
+
+                /** @brief Tag that was active before
+                 */
+                uint8_t previous;
+
+            public:
+
+                /** @brief Activate tag
+                 * @param name Tag name (must stay valid, string literal is expected)
+                 */
+                Scope(const char* name) : previous(Profiler::currentTag)
+                {
+                    Profiler::SetTag(name);
+                }
+
+                /** @brief Restore previous tag
+                 */
+                ~Scope()
+                {
+                    Profiler::currentTag = this->previous;
+                }
+            };
+
+        private:
+
+            /** @brief Memory class needs to be able to record allocations
+             */
+            friend class Memory;
+
+            /** @brief Maximal number of tracked live allocations
+             */
+            static constexpr size_t MaxRecords = SRL_MEMORY_PROFILER_MAX_ALLOCATIONS;
+
+            /** @brief Maximal number of tags, first one is used for untagged allocations
+             */
+            static constexpr size_t MaxTags = SRL_MEMORY_PROFILER_MAX_TAGS;
+
+            /** @brief Number of profiled zones (frame arena is not profiled)
+             */
+            static constexpr size_t ZoneCount = 3;
+
+            static_assert((Profiler::MaxRecords & (Profiler::MaxRecords - 1)) == 0, "SRL_MEMORY_PROFILER_MAX_ALLOCATIONS must be power of two");
+            static_assert(Profiler::MaxTags > 1 && Profiler::MaxTags <= 256, "SRL_MEMORY_PROFILER_MAX_TAGS must be between 2 and 256");
+
+            /** @brief Live allocation record
+             */
+            struct Record
+            {
+                /** @brief Allocated memory, nullptr marks empty record
+                 */
+                void* Pointer;
+
+                /** @brief Requested size
+                 */
+                size_t Size;
+
+                /** @brief Tag index
+                 */
+                uint8_t Tag;
+
+                /** @brief Zone index
+                 */
+                uint8_t Zone;
+            };
+
+            /** @brief Live allocations, open addressing hash table
+             */
+            inline static Record records[Profiler::MaxRecords];
+
+            /** @brief Tag statistics
+             */
+            inline static TagStats tags[Profiler::MaxTags] = { { "Untagged", 0, 0, 0 } };
+
+            /** @brief Number of used tags
+             */
+            inline static size_t tagCount = 1;
+
+            /** @brief Currently active tag
+             */
+            inline static uint8_t currentTag = 0;
+
+            /** @brief Zone statistics
+             */
+            inline static ZoneStats zones[Profiler::ZoneCount];
+
+            /** @brief Zone statistics of the frame in progress
+             */
+            inline static ZoneStats frame[Profiler::ZoneCount];
+
+            /** @brief Number of allocations that did not fit into the record table
+             */
+            inline static size_t untracked = 0;
+
+            /** @brief Get home record of the pointer
+             * @param ptr Allocated memory
+             * @return Record index
+             */
+            inline static size_t GetHome(const void* ptr)
+            {
+                return ((reinterpret_cast<uint32_t>(ptr) >> 2) * 2654435761U) & (Profiler::MaxRecords - 1);
+            }
+
+            /** @brief Find record of the allocation
+             * @param ptr Allocated memory
+             * @return Record index or MaxRecords if not found
+             */
+            inline static size_t Find(const void* ptr)
+            {
+                size_t index = Profiler::GetHome(ptr);
+
+                for (size_t probe = 0; probe < Profiler::MaxRecords && Profiler::records[index].Pointer != nullptr; probe++)
+                {
+                    if (Profiler::records[index].Pointer == ptr)
+                    {
+                        return index;
+                    }
+
+                    index = (index + 1) & (Profiler::MaxRecords - 1);
+                }
+
+                return Profiler::MaxRecords;
+            }
+
+            /** @brief Remove record and move following records of the same probe chain to keep chain unbroken
+             * @param index Record index
+             */
+            inline static void RemoveRecord(size_t index)
+            {
+                size_t next = index;
+
+                for (size_t probe = 1; probe < Profiler::MaxRecords; probe++)
+                {
+                    next = (next + 1) & (Profiler::MaxRecords - 1);
+
+                    if (Profiler::records[next].Pointer == nullptr)
+                    {
+                        break;
+                    }
+
+                    // Record can fill the hole only if the hole is not in front of its home
+                    const size_t home = Profiler::GetHome(Profiler::records[next].Pointer);
+
+                    if (((next - home) & (Profiler::MaxRecords - 1)) >= ((next - index) & (Profiler::MaxRecords - 1)))
+                    {
+                        Profiler::records[index] = Profiler::records[next];
+                        index = next;
+                    }
+                }
+
+                Profiler::records[index].Pointer = nullptr;
+            }
+
+            /** @brief Record new allocation
+             * @param zone Memory zone
+             * @param ptr Allocated memory
+             * @param size Requested size
+             */
+            inline static void OnMalloc(const Memory::Zone zone, void* ptr, const size_t size)
+            {
+                ZoneStats& frameStats = Profiler::frame[static_cast<size_t>(zone)];
+
+                if (ptr == nullptr)
+                {
+                    frameStats.Failures++;
+                    return;
+                }
+
+                size_t index = Profiler::GetHome(ptr);
+
+                for (size_t probe = 0; Profiler::records[index].Pointer != nullptr; probe++)
+                {
+                    if (probe == Profiler::MaxRecords)
+                    {
+                        Profiler::untracked++;
+                        return;
+                    }
+
+                    index = (index + 1) & (Profiler::MaxRecords - 1);
+                }
+
+                Profiler::records[index] = Record { ptr, size, Profiler::currentTag, static_cast<uint8_t>(zone) };
+
+                TagStats& tag = Profiler::tags[Profiler::currentTag];
+                tag.Bytes += size;
+                tag.Blocks++;
+                tag.PeakBytes = tag.Bytes > tag.PeakBytes ? tag.Bytes : tag.PeakBytes;
+
+                ZoneStats& zoneStats = Profiler::zones[static_cast<size_t>(zone)];
+                zoneStats.Bytes += size;
+                zoneStats.PeakBytes = zoneStats.Bytes > zoneStats.PeakBytes ? zoneStats.Bytes : zoneStats.PeakBytes;
+
+                frameStats.FrameAllocations++;
+                frameStats.FrameBytes += size;
+            }
+
+            /** @brief Record freed allocation
+             * @param ptr Allocated memory
+             */
+            inline static void OnFree(void* ptr)
+            {
+                const size_t index = ptr != nullptr ? Profiler::Find(ptr) : Profiler::MaxRecords;
+
+                if (index == Profiler::MaxRecords)
+                {
+                    // Memory allocated before profiler had space for it or not allocated at all
+                    return;
+                }
+
+                const Record& record = Profiler::records[index];
+
+                TagStats& tag = Profiler::tags[record.Tag];
+                tag.Bytes -= record.Size;
+                tag.Blocks--;
+
+                Profiler::zones[record.Zone].Bytes -= record.Size;
+                Profiler::frame[record.Zone].FrameFrees++;
+                Profiler::RemoveRecord(index);
+            }
+
+            /** @brief Record reallocation
+             * @param zone Memory zone
+             * @param ptr Original allocation
+             * @param result Reallocated memory
+             * @param size Requested size
+             */
+            inline static void OnRealloc(const Memory::Zone zone, void* ptr, void* result, const size_t size)
+            {
+                // Reallocated memory keeps tag of the original allocation
+                const uint8_t activeTag = Profiler::currentTag;
+                const size_t index = ptr != nullptr ? Profiler::Find(ptr) : Profiler::MaxRecords;
+                const uint8_t tag = index != Profiler::MaxRecords ? Profiler::records[index].Tag : activeTag;
+
+                if (result != nullptr || size == 0)
+                {
+                    Profiler::OnFree(ptr);
+                }
+
+                if (result != nullptr || size != 0)
+                {
+                    Profiler::currentTag = tag;
+                    Profiler::OnMalloc(zone, result, size);
+                    Profiler::currentTag = activeTag;
+                }
+            }
+
+        public:
+
+            /** @brief Set tag for new allocations
+             * @param name Tag name (must stay valid, string literal is expected)
+             * @return Index of the tag
+             */
+            inline static uint8_t SetTag(const char* name)
+            {
+                for (size_t index = 0; index < Profiler::tagCount; index++)
+                {
+                    if (Profiler::tags[index].Name == name)
+                    {
+                        Profiler::currentTag = index;
+                        return index;
+                    }
+                }
+
+                if (Profiler::tagCount < Profiler::MaxTags)
+                {
+                    Profiler::tags[Profiler::tagCount] = TagStats { name, 0, 0, 0 };
+                    Profiler::currentTag = Profiler::tagCount++;
+                }
+                else
+                {
+                    // Out of tags, count it as untagged
+                    Profiler::currentTag = 0;
+                }
+
+                return Profiler::currentTag;
+            }
+
+            /** @brief Finish frame, frame counters of the current frame become available through GetZoneStats()
+             * @note This is called automatically after each Core::Synchronize()
+             */
+            inline static void EndFrame()
+            {
+                for (size_t zone = 0; zone < Profiler::ZoneCount; zone++)
+                {
+                    Profiler::zones[zone].FrameAllocations = Profiler::frame[zone].FrameAllocations;
+                    Profiler::zones[zone].FrameFrees = Profiler::frame[zone].FrameFrees;
+                    Profiler::zones[zone].FrameBytes = Profiler::frame[zone].FrameBytes;
+                    Profiler::zones[zone].Failures += Profiler::frame[zone].Failures;
+                    Profiler::frame[zone] = ZoneStats { 0, 0, 0, 0, 0, 0 };
+                }
+            }
+
+            /** @brief Get number of used tags
+             * @return Number of tags, including the untagged one
+             */
+            inline static size_t GetTagCount()
+            {
+                return Profiler::tagCount;
+            }
+
+            /** @brief Get tag statistics
+             * @param index Tag index (0 is untagged)
+             * @return Tag statistics
+             */
+            inline static const TagStats& GetTagStats(const size_t index)
+            {
+                return Profiler::tags[index < Profiler::tagCount ? index : 0];
+            }
+
+            /** @brief Get zone statistics
+             * @param zone Memory zone
+             * @return Zone statistics
+             */
+            inline static const ZoneStats GetZoneStats(const Memory::Zone zone)
+            {
+                if (static_cast<size_t>(zone) < Profiler::ZoneCount)
+                {
+                    ZoneStats stats = Profiler::zones[static_cast<size_t>(zone)];
+                    stats.Failures += Profiler::frame[static_cast<size_t>(zone)].Failures;
+                    return stats;
+                }
+
+                return ZoneStats { 0, 0, 0, 0, 0, 0 };
+            }
+
+            /** @brief Get fragmentation of the zone free space
+             * @param zone Memory zone
+             * @return Percentage of the free space that is not part of the largest free block
+             */
+            inline static uint32_t GetFragmentation(const Memory::Zone zone)
+            {
+                const Report report = Memory::GetReport(zone);
+
+                if (report.FreeSize == 0)
+                {
+                    return 0;
+                }
+
+                return 100 - ((report.LargestFreeSize * 100) / report.FreeSize);
+            }
+
+            /** @brief Get number of allocations that did not fit into the record table
+             * @return Number of allocations
+             */
+            inline static size_t GetUntrackedCount()
+            {
+                return Profiler::untracked;
+            }
+
+            /** @brief Reset peak values to current values
+             */
+            inline static void ResetPeaks()
+            {
+                for (size_t index = 0; index < Profiler::tagCount; index++)
+                {
+                    Profiler::tags[index].PeakBytes = Profiler::tags[index].Bytes;
+                }
+
+                for (size_t zone = 0; zone < Profiler::ZoneCount; zone++)
+                {
+                    Profiler::zones[zone].PeakBytes = Profiler::zones[zone].Bytes;
+                }
+            }
+        };
+#endif
+
+        /** @brief Set memory to some value
+         * @details Memory is filled by 32-bit words where possible, only unaligned start and end are filled by bytes.
+         * @param destination Destination to set
+         * @param value Value to set
+         * @param length Data length to set
+         */
+        inline static void MemSet(void* destination, const uint8_t value, const size_t length)
+        {
+            uint8_t* target = reinterpret_cast<uint8_t*>(destination);
+            uint8_t* end = target + length;
+
+            // Fill bytes until target is aligned to 4 bytes
+            while (target < end && (reinterpret_cast<uint32_t>(target) & 3) != 0)
+            {
+                *target++ = value;
+            }
+
+            const uint32_t word = value * 0x01010101U;
+            uint32_t* words = reinterpret_cast<uint32_t*>(target);
+            size_t count = (end - target) >> 2;
+
+            // Fill 16 bytes per iteration
+            for (; count >= 4; count -= 4)
+            {
+                words[0] = word;
+                words[1] = word;
+                words[2] = word;
+                words[3] = word;
+                words += 4;
+            }
+
+            while (count-- > 0)
+            {
+                *words++ = word;
+            }
+
+            // Fill remaining bytes
+            target = reinterpret_cast<uint8_t*>(words);
+
+            while (target < end)
+            {
+                *target++ = value;
+            }
+        }
+
+        /** @brief Copy memory from one location to another
+         * @details Data is copied by 32-bit words if source and destination have the same alignment, by 16-bit words if they are
+         * at least 2 byte aligned to each other, and by bytes otherwise. Memory areas must not overlap.
+         * @param destination Destination to copy data to
+         * @param source Source to copy data from
+         * @param length Number of bytes to copy
+         */
+        inline static void MemCopy(void* destination, const void* source, const size_t length)
+        {
+            uint8_t* target = reinterpret_cast<uint8_t*>(destination);
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(source);
+            const uint8_t* end = data + length;
+
+            if ((reinterpret_cast<uint32_t>(target) & 3) == (reinterpret_cast<uint32_t>(data) & 3))
+            {
+                // Copy bytes until both pointers are aligned to 4 bytes
+                while (data < end && (reinterpret_cast<uint32_t>(data) & 3) != 0)
+                {
+                    *target++ = *data++;
+                }
+
+                uint32_t* targetWords = reinterpret_cast<uint32_t*>(target);
+                const uint32_t* dataWords = reinterpret_cast<const uint32_t*>(data);
+                size_t count = (end - data) >> 2;
+
+                // Copy 16 bytes per iteration
+                for (; count >= 4; count -= 4)
+                {
+                    targetWords[0] = dataWords[0];
+                    targetWords[1] = dataWords[1];
+                    targetWords[2] = dataWords[2];
+                    targetWords[3] = dataWords[3];
+                    targetWords += 4;
+                    dataWords += 4;
+                }
+
+                while (count-- > 0)
+                {
+                    *targetWords++ = *dataWords++;
+                }
+
+                target = reinterpret_cast<uint8_t*>(targetWords);
+                data = reinterpret_cast<const uint8_t*>(dataWords);
+            }
+            else if ((reinterpret_cast<uint32_t>(target) & 1) == (reinterpret_cast<uint32_t>(data) & 1))
+            {
+                // Copy byte until both pointers are aligned to 2 bytes
+                if (data < end && (reinterpret_cast<uint32_t>(data) & 1) != 0)
+                {
+                    *target++ = *data++;
+                }
+
+                uint16_t* targetHalfWords = reinterpret_cast<uint16_t*>(target);
+                const uint16_t* dataHalfWords = reinterpret_cast<const uint16_t*>(data);
+                size_t count = (end - data) >> 1;
+
+                while (count-- > 0)
+                {
+                    *targetHalfWords++ = *dataHalfWords++;
+                }
+
+                target = reinterpret_cast<uint8_t*>(targetHalfWords);
+                data = reinterpret_cast<const uint8_t*>(dataHalfWords);
+            }
+
+            // Copy remaining bytes
+            while (data < end)
+            {
+                *target++ = *data++;
+            }
+        }
+
+        /** @brief Asynchronous memory copy using DMA
+         * @details Transfer runs in the background while CPU continues, use IsFinished() to check whether data arrived or Wait() to block until it does.
+         * Only one transfer per channel can be in flight, starting new one waits for the previous one to finish.<br/>
+         * CPU DMA can copy between any memory locations, SCU DMA requires source, destination and length to be aligned to 4 bytes
+         * and is meant mainly for uploads into VDP1/VDP2 VRAM. SCU DMA cannot access low work RAM, such transfers are done by CPU DMA instead.<br/>
+         * Copies that are too small to benefit from DMA or are not aligned are done by Memory::MemCopy() right away.
+         * @code {.cpp}
+         * auto channel = SRL::Memory::Dma::Copy(vram, cells, cellsSize, SRL::Memory::Dma::Channel::Scu);
+         *
+         * // Do something else in the meantime...
+         *
+         * SRL::Memory::Dma::Wait(channel);
+         * @endcode
+         * @warning DMA does not go through CPU cache, data copied into cached work RAM may need the cache to be purged before CPU reads it.
+         */
+        class Dma
+        {
+        public:
+
+            /** @brief DMA channel
+             */
+            enum class Channel : uint8_t
+            {
+                /** @brief SH-2 CPU DMA (SGL slDMACopy)
+                 */
+                Cpu = 0,
+
+                /** @brief SCU DMA
+                 */
+                Scu = 1
+            };
+
+        private:
+
+            /** @brief Copies smaller than this are done by CPU
+             */
+            static constexpr size_t MinimalLength = 64;
+
+            /** @brief Value returned by DMA_ScuResult() while transfer is running
+             */
+            static constexpr uint32_t ScuBusy = 1;
+
+            /** @brief Whether channel has transfer in flight
+             */
+            inline static bool pending[2] = { false, false };
+
+            /** @brief Check whether SCU DMA can access the address
+             * @param ptr Address to check
+             * @return true if address is not in low work RAM
+             */
+            inline static bool IsScuAccessible(const void* ptr)
+            {
+                return (reinterpret_cast<uint32_t>(ptr) & 0x0ff00000) != 0x00200000;
+            }
+
+        public:
+
+            /** @brief Start copying memory in the background
+             * @param destination Destination to copy data to
+             * @param source Source to copy data from
+             * @param length Number of bytes to copy
+             * @param channel DMA channel to use
+             * @return Channel that carries the transfer (SCU transfers can fall back to CPU DMA)
+             */
+            inline static Channel Copy(void* destination, const void* source, const size_t length, const Channel channel = Channel::Cpu)
+            {
+                if (channel == Channel::Scu && (!Dma::IsScuAccessible(destination) || !Dma::IsScuAccessible(source)))
+                {
+                    return Dma::Copy(destination, source, length, Channel::Cpu);
+                }
+
+                Dma::Wait(channel);
+
+                if (length < Dma::MinimalLength)
+                {
+                    Memory::MemCopy(destination, source, length);
+                    return channel;
+                }
+
+                if (channel == Channel::Scu)
+                {
+                    if (((reinterpret_cast<uint32_t>(destination) | reinterpret_cast<uint32_t>(source) | length) & 3) != 0)
+                    {
+                        Memory::MemCopy(destination, source, length);
+                        return channel;
+                    }
+
+                    DMA_ScuMemCopy(destination, const_cast<void*>(source), length);
+                }
+                else
+                {
+                    slDMACopy(const_cast<void*>(source), destination, length);
+                }
+
+                Dma::pending[static_cast<size_t>(channel)] = true;
+                return channel;
+            }
+
+            /** @brief Check whether transfer on the channel finished
+             * @param channel DMA channel
+             * @return true if there is no transfer in flight
+             */
+            inline static bool IsFinished(const Channel channel = Channel::Cpu)
+            {
+                bool& pending = Dma::pending[static_cast<size_t>(channel)];
+
+                if (pending)
+                {
+                    pending = channel == Channel::Scu ? DMA_ScuResult() == Dma::ScuBusy : slDMAStatus();
+                }
+
+                return !pending;
+            }
+
+            /** @brief Wait until transfer on the channel finishes
+             * @param channel DMA channel
+             */
+            inline static void Wait(const Channel channel = Channel::Cpu)
+            {
+                if (Dma::pending[static_cast<size_t>(channel)] && channel == Channel::Cpu)
+                {
+                    slDMAWait();
+                    Dma::pending[static_cast<size_t>(channel)] = false;
+                }
+
+                while (!Dma::IsFinished(channel));
+            }
+        };
+
+        /** @brief Heap of relocatable blocks referenced by handles
+         * @details Blocks do not have fixed address, they can be slid together by the compactor so free space never stays fragmented.
+         * Block has to be locked to get pointer to its data, locked blocks are never moved. Pointer is valid only until the block is unlocked.
+         * Compactor runs incrementally from Core::OnAfterSync and moves at most Memory::MovableHeap::SetCompactBudget() bytes per frame.
+         * When allocation does not fit into any free block but there is enough free space in total, heap is compacted right away.
+         * @code {.cpp}
+         * SRL::Memory::MovableHeap::Initialize(512 * 1024, SRL::Memory::Zone::LWRam);
+         *
+         * auto handle = SRL::Memory::MovableHeap::Malloc(size);
+         *
+         * // Data can be accessed only while locked
+         * uint8_t* data = reinterpret_cast<uint8_t*>(SRL::Memory::MovableHeap::Lock(handle));
+         * file.Read(size, data);
+         * SRL::Memory::MovableHeap::Unlock(handle);
+         *
+         * // ...
+         *
+         * SRL::Memory::MovableHeap::Free(handle);
+         * @endcode
+         */
+        class MovableHeap
+        {
+        public:
+
+            /** @brief Movable block identifier
+             * @details Handle carries generation of the handle table entry it points to,
+             * so handle of a freed block cannot be used to access another block that reused the same entry.
+             */
+            struct Handle
+            {
+                /** @brief Handle table index
+                 */
+                uint16_t Index;
+
+                /** @brief Generation of the table entry at the time block was allocated
+                 */
+                uint16_t Generation;
+
+                /** @brief Construct a handle that does not reference any block
+                 */
+                constexpr Handle() : Index(0xffff), Generation(0)
+                {
+                    // Do nothing
+                }
+
+                /** @brief Construct a new handle
+                 * @param index Handle table index
+                 * @param generation Table entry generation
+                 */
+                constexpr Handle(const uint16_t index, const uint16_t generation) : Index(index), Generation(generation)
+                {
+                    // Do nothing
+                }
+
+                /** @brief Compare two handles
+                 * @param other Other handle
+                 * @return true if handles are equal
+                 */
+                constexpr bool operator==(const Handle& other) const
+                {
+                    return this->Index == other.Index && this->Generation == other.Generation;
+                }
+
+                /** @brief Compare two handles
+                 * @param other Other handle
+                 * @return true if handles are not equal
+                 */
+                constexpr bool operator!=(const Handle& other) const
+                {
+                    return !(*this == other);
+                }
+            };
+
+            /** @brief Handle value that does not reference any block
+             */
+            inline static const Handle InvalidHandle = Handle();
+
+        private:
+
+            /** @brief Owner of a free block, also the largest number of handles
+             */
+            inline static const uint16_t NoOwner = 0xffff;
+
+            /** @brief Header in front of each block, free blocks have owner set to MovableHeap::NoOwner
+             */
+            struct Block
+            {
+                /** @brief Size of the block including this header
+                 */
+                uint32_t Size;
+
+                /** @brief Index of the handle owning the block
+                 */
+                uint16_t Owner;
+
+                /** @brief Unused, keeps block data aligned
+                 */
+                uint16_t Reserved;
+            };
+
+            /** @brief Handle table entry
+             */
+            struct Entry
+            {
+                /** @brief Current location of the block referenced by the handle, nullptr if handle is not in use
+                 */
+                Block* Location;
+
+                /** @brief Number of times block was locked
+                 */
+                uint16_t Locks;
+
+                /** @brief Incremented every time block referenced by the entry is freed
+                 */
+                uint16_t Generation;
+            };
+
+            /** @brief Block size granularity (also alignment of the block data)
+             */
+            inline static const size_t Granularity = 8;
+
+            /** @brief Start of the heap
+             */
+            inline static uint8_t* memory = nullptr;
+
+            /** @brief Size of the heap
+             */
+            inline static size_t memorySize = 0;
+
+            /** @brief Handle table
+             */
+            inline static Entry* entries = nullptr;
+
+            /** @brief Number of handles in the table
+             */
+            inline static uint16_t entryCount = 0;
+
+            /** @brief Number of free bytes including headers of free blocks
+             */
+            inline static size_t freeSize = 0;
+
+            /** @brief Number of bytes compactor can move in a single frame
+             */
+            inline static size_t compactBudget = 16384;
+
+            /** @brief Get block following specified block
+             * @param block Current block
+             * @return Next block
+             */
+            inline static Block* Next(Block* block)
+            {
+                return reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(block) + block->Size);
+            }
+
+            /** @brief Check whether block is last one in the heap
+             * @param block Block to check
+             * @return true if block is at the end of the heap
+             */
+            inline static bool IsEnd(Block* block)
+            {
+                return reinterpret_cast<uint8_t*>(block) >= MovableHeap::memory + MovableHeap::memorySize;
+            }
+
+            /** @brief Merge free block with free blocks following it
+             * @param block Free block
+             */
+            inline static void Coalesce(Block* block)
+            {
+                Block* next = MovableHeap::Next(block);
+
+                while (!MovableHeap::IsEnd(next) && next->Owner == MovableHeap::NoOwner)
+                {
+                    block->Size += next->Size;
+                    next = MovableHeap::Next(block);
+                }
+            }
+
+            /** @brief Find first free block large enough
+             * @param size Size of the block including header
+             * @return Found block or nullptr
+             */
+            inline static Block* FindFree(const size_t size)
+            {
+                for (Block* block = reinterpret_cast<Block*>(MovableHeap::memory); !MovableHeap::IsEnd(block); block = MovableHeap::Next(block))
+                {
+                    if (block->Owner == MovableHeap::NoOwner)
+                    {
+                        MovableHeap::Coalesce(block);
+
+                        if (block->Size >= size)
+                        {
+                            return block;
+                        }
+                    }
+                }
+
+                return nullptr;
+            }
+
+            /** @brief Slide block down into the free block right in front of it
+             * @details Data is copied by CPU in pieces no larger than the free block, so no piece overlaps its own source.
+             * Copy goes through the cache, so moved headers can be followed right away (DMA would leave stale headers in the cache).
+             * @param hole Free block
+             * @param block Block to move
+             * @return Moved block
+             */
+            inline static Block* Slide(Block* hole, Block* block)
+            {
+                const size_t holeSize = hole->Size;
+                const size_t blockSize = block->Size;
+                const uint16_t owner = block->Owner;
+                uint8_t* target = reinterpret_cast<uint8_t*>(hole);
+                const uint8_t* source = reinterpret_cast<const uint8_t*>(block);
+
+                for (size_t offset = 0; offset < blockSize; offset += holeSize)
+                {
+                    const size_t length = blockSize - offset < holeSize ? blockSize - offset : holeSize;
+                    Memory::MemCopy(target + offset, source + offset, length);
+                }
+
+                MovableHeap::entries[owner].Location = hole;
+
+                Block* freed = reinterpret_cast<Block*>(target + blockSize);
+                freed->Size = holeSize;
+                freed->Owner = MovableHeap::NoOwner;
+                return hole;
+            }
+
+        public:
+
+            /** @brief Allocate the heap
+             * @param size Size of the heap in bytes
+             * @param zone Memory zone to take the heap from
+             * @param handles Maximal number of blocks heap can hold
+             * @return true if heap was allocated
+             */
+            inline static bool Initialize(const size_t size, const Zone zone = Zone::HWRam, const uint16_t handles = 256)
+            {
+                const size_t length = size & ~(MovableHeap::Granularity - 1);
+
+                if (MovableHeap::memory != nullptr ||
+                    zone == Zone::Frame ||
+                    length < sizeof(Block) + MovableHeap::Granularity ||
+                    handles == 0 ||
+                    handles == MovableHeap::NoOwner)
+                {
+                    return false;
+                }
+
+                uint8_t* heap = reinterpret_cast<uint8_t*>(Memory::Malloc(length, zone));
+                Entry* table = reinterpret_cast<Entry*>(Memory::Malloc(sizeof(Entry) * handles, zone));
+
+                if (heap == nullptr || table == nullptr)
+                {
+                    Memory::Free(heap);
+                    Memory::Free(table);
+                    return false;
+                }
+
+                for (uint16_t index = 0; index < handles; index++)
+                {
+                    table[index] = { nullptr, 0, 0 };
+                }
+
+                Block* block = reinterpret_cast<Block*>(heap);
+                block->Size = length;
+                block->Owner = MovableHeap::NoOwner;
+
+                MovableHeap::memory = heap;
+                MovableHeap::memorySize = length;
+                MovableHeap::entries = table;
+                MovableHeap::entryCount = handles;
+                MovableHeap::freeSize = length;
+                return true;
+            }
+
+            /** @brief Check whether heap was allocated
+             * @return true if heap can be used
+             */
+            inline static bool IsInitialized()
+            {
+                return MovableHeap::memory != nullptr;
+            }
+
+            /** @brief Allocate movable block
+             * @param size Number of bytes to allocate
+             * @return Handle of the block, MovableHeap::InvalidHandle if there is not enough space
+             */
+            inline static Handle Malloc(const size_t size)
+            {
+                if (MovableHeap::memory == nullptr || size == 0 || size > MovableHeap::memorySize)
+                {
+                    return MovableHeap::InvalidHandle;
+                }
+
+                uint16_t index = 0;
+
+                while (index < MovableHeap::entryCount && MovableHeap::entries[index].Location != nullptr)
+                {
+                    index++;
+                }
+
+                const size_t length = sizeof(Block) + ((size + MovableHeap::Granularity - 1) & ~(MovableHeap::Granularity - 1));
+
+                if (index >= MovableHeap::entryCount || length > MovableHeap::freeSize)
+                {
+                    return MovableHeap::InvalidHandle;
+                }
+
+                Block* block = MovableHeap::FindFree(length);
+
+                if (block == nullptr)
+                {
+                    // There is enough free space, it is just scattered
+                    MovableHeap::Compact(MovableHeap::memorySize);
+                    block = MovableHeap::FindFree(length);
+
+                    if (block == nullptr)
+                    {
+                        return MovableHeap::InvalidHandle;
+                    }
+                }
+
+                // Split the rest into new free block
+                if (block->Size - length >= sizeof(Block) + MovableHeap::Granularity)
+                {
+                    Block* rest = reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(block) + length);
+                    rest->Size = block->Size - length;
+                    rest->Owner = MovableHeap::NoOwner;
+                    block->Size = length;
+                }
+
+                block->Owner = index;
+                MovableHeap::freeSize -= block->Size;
+                MovableHeap::entries[index].Location = block;
+                MovableHeap::entries[index].Locks = 0;
+                return Handle(index, MovableHeap::entries[index].Generation);
+            }
+
+            /** @brief Free movable block
+             * @param handle Handle of the block
+             */
+            inline static void Free(const Handle handle)
+            {
+                if (MovableHeap::IsValid(handle))
+                {
+                    Entry& entry = MovableHeap::entries[handle.Index];
+                    entry.Location->Owner = MovableHeap::NoOwner;
+                    MovableHeap::freeSize += entry.Location->Size;
+                    entry.Location = nullptr;
+                    entry.Locks = 0;
+                    entry.Generation++;
+                }
+            }
+
+            /** @brief Check whether handle references allocated block
+             * @param handle Handle to check
+             * @return true if handle is valid, false if it is null or its block was freed
+             */
+            inline static bool IsValid(const Handle handle)
+            {
+                return handle.Index < MovableHeap::entryCount &&
+                    MovableHeap::entries[handle.Index].Location != nullptr &&
+                    MovableHeap::entries[handle.Index].Generation == handle.Generation;
+            }
+
+            /** @brief Lock block in place and get its data
+             * @note Each call must be paired with MovableHeap::Unlock()
+             * @param handle Handle of the block
+             * @return Pointer to the block data, nullptr if handle is not valid
+             */
+            inline static void* Lock(const Handle handle)
+            {
+                if (!MovableHeap::IsValid(handle))
+                {
+                    return nullptr;
+                }
+
+                MovableHeap::entries[handle.Index].Locks++;
+                return MovableHeap::entries[handle.Index].Location + 1;
+            }
+
+            /** @brief Allow block to be moved again
+             * @param handle Handle of the block
+             */
+            inline static void Unlock(const Handle handle)
+            {
+                if (MovableHeap::IsValid(handle) && MovableHeap::entries[handle.Index].Locks > 0)
+                {
+                    MovableHeap::entries[handle.Index].Locks--;
+                }
+            }
+
+            /** @brief Check whether block is locked
+             * @param handle Handle of the block
+             * @return true if block cannot be moved
+             */
+            inline static bool IsLocked(const Handle handle)
+            {
+                return MovableHeap::IsValid(handle) && MovableHeap::entries[handle.Index].Locks > 0;
+            }
+
+            /** @brief Get usable size of the block
+             * @param handle Handle of the block
+             * @return Number of bytes, 0 if handle is not valid
+             */
+            inline static size_t GetBlockSize(const Handle handle)
+            {
+                return MovableHeap::IsValid(handle) ? MovableHeap::entries[handle.Index].Location->Size - sizeof(Block) : 0;
+            }
+
+            /** @brief Slide unlocked blocks towards start of the heap to merge free space
+             * @param budget Maximal number of bytes to move, compaction stops after the block that exceeds it
+             * @return Number of bytes moved
+             */
+            inline static size_t Compact(const size_t budget)
+            {
+                size_t moved = 0;
+                Block* block = reinterpret_cast<Block*>(MovableHeap::memory);
+
+                while (block != nullptr && !MovableHeap::IsEnd(block) && moved < budget)
+                {
+                    if (block->Owner != MovableHeap::NoOwner)
+                    {
+                        block = MovableHeap::Next(block);
+                        continue;
+                    }
+
+                    MovableHeap::Coalesce(block);
+                    Block* next = MovableHeap::Next(block);
+
+                    if (MovableHeap::IsEnd(next))
+                    {
+                        break;
+                    }
+
+                    if (MovableHeap::entries[next->Owner].Locks > 0)
+                    {
+                        // Locked block pins the hole in place
+                        block = MovableHeap::Next(next);
+                        continue;
+                    }
+
+                    moved += next->Size;
+                    block = MovableHeap::Next(MovableHeap::Slide(block, next));
+                }
+
+                return moved;
             }
 
-            /** @brief Gets report on the allocator state
-             * @return Current state of the allocator
+            /** @brief Set number of bytes compactor can move in a single frame
+             * @param budget Number of bytes, 0 disables background compaction
              */
-            static const Report GetReport()
+            inline static void SetCompactBudget(const size_t budget)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return Report { 0, 0, 0, LowWorkRam::Zone.Size, 0};
-                #else
-                return Memory::SimpleMalloc::GetReport(LowWorkRam::zone);
-                #endif
+                MovableHeap::compactBudget = budget;
             }
 
-            /** @brief Gets total size of the memory zone
+            /** @brief Run one step of background compaction
+             * @note This is called automatically from Core::OnAfterSync
+             */
+            inline static void Update()
+            {
+                if (MovableHeap::memory != nullptr && MovableHeap::compactBudget > 0)
+                {
+                    MovableHeap::Compact(MovableHeap::compactBudget);
+                }
+            }
+
+            /** @brief Gets total size of the free space
              * @return Number of bytes
              */
-            inline static size_t GetSize()
+            inline static size_t GetFreeSpace()
             {
-                return LowWorkRam::zone.Size;
+                return MovableHeap::freeSize;
             }
-            
-            /** @brief Gets total size of the used space in the memory zone
+
+            /** @brief Gets total size of the used space
              * @return Number of bytes
              */
-            static size_t GetUsedSpace()
+            inline static size_t GetUsedSpace()
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                auto report = Memory::SimpleMalloc::GetReport(LowWorkRam::zone);
-                return report.TotalSize - report.FreeSize;
-                #endif
+                return MovableHeap::memorySize - MovableHeap::freeSize;
+            }
+
+            /** @brief Gets total size of the heap
+             * @return Number of bytes
+             */
+            inline static size_t GetSize()
+            {
+                return MovableHeap::memorySize;
+            }
+
+            /** @brief Gets report on the heap state
+             * @return Current state of the heap
+             */
+            inline static const Report GetReport()
+            {
+                Report report = { 0, 0, MovableHeap::freeSize, MovableHeap::memorySize, 0, 0 };
+
+                if (MovableHeap::memory == nullptr)
+                {
+                    return report;
+                }
+
+                for (Block* block = reinterpret_cast<Block*>(MovableHeap::memory); !MovableHeap::IsEnd(block); block = MovableHeap::Next(block))
+                {
+                    report.AllocationHeaders += sizeof(Block);
+
+                    if (block->Owner == MovableHeap::NoOwner)
+                    {
+                        MovableHeap::Coalesce(block);
+                        report.FreeBlocks++;
+                        report.LargestFreeSize = block->Size > report.LargestFreeSize ? block->Size : report.LargestFreeSize;
+                    }
+                    else
+                    {
+                        report.UsedBlocks++;
+                    }
+                }
+
+                return report;
             }
         };
 
-        /** @brief Malloc for expansion cart RAM
+        /** @brief Placement policy deciding which memory zones allocation classes use
+         * @details Each allocation class has an ordered list of zones, allocation is made from the first zone that has enough space.
+         * When an allocation ends up in other than the first zone it counts as a spill, counters of each class can be used to tune the policy.
+         * By default hot and default allocations (plain @c new) stay in high work RAM, bulk allocations spill over to low work RAM and cart RAM.
+         * @note Allocations into explicit zone (@c lwnew, @c cartnew, Memory::Malloc(size, zone), etc...) never spill.
+         * @code {.cpp}
+         * // Level data can be anywhere, prefer low work RAM to keep high work RAM for code and hot data
+         * SRL::Memory::Placement::SetPolicy(SRL::Memory::AllocationClass::Bulk, { SRL::Memory::Zone::LWRam, SRL::Memory::Zone::CartRam, SRL::Memory::Zone::HWRam });
+         *
+         * uint8_t* level = bulknew uint8_t[size];
+         *
+         * // How often did we end up in slower memory?
+         * const SRL::Memory::Placement::Stats& stats = SRL::Memory::Placement::GetStats(SRL::Memory::AllocationClass::Bulk);
+         * @endcode
          */
-        class CartRam
+        class Placement
         {
-        private:
+        public:
 
-            /** @brief Memory class needs to be able to see private members to initialize zones
+            /** @brief Maximal number of zones in a policy
              */
-            friend class Memory;
+            inline static const uint8_t MaxZones = 3;
 
-            /** @brief Memory zone
+            /** @brief Number of allocation classes
              */
-            inline static Memory::MemoryZone zone;
+            inline static const uint8_t ClassCount = 3;
 
-            /** @brief Initialize memory zone
+            /** @brief Ordered list of zones allocation class can use
              */
-            inline static void Initialize()
+            struct Policy
             {
-                // TODO: Implement
-            }
-            
-        public:
+                /** @brief Zones in order of preference
+                 */
+                Zone Zones[Placement::MaxZones];
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+                /** @brief Number of valid zones
+                 */
+                uint8_t Count;
+            };
+
+            /** @brief Counters of one allocation class
              */
-            inline static bool InRange(void* ptr)
+            struct Stats
             {
-                return CartRam::InRange(reinterpret_cast<uint32_t>(ptr));
-            }
+                /** @brief Number of allocation attempts
+                 */
+                size_t Allocations;
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param zoneAddress Address in the memory zone where object should be allocated
-             * @return true if pointer belongs to the current memory zone
+                /** @brief Number of allocations that did not fit into the preferred zone
+                 */
+                size_t Spills;
+
+                /** @brief Number of bytes allocated outside of the preferred zone
+                 */
+                size_t SpilledBytes;
+
+                /** @brief Number of allocations that did not fit into any zone
+                 */
+                size_t Failures;
+            };
+
+        private:
+
+            /** @brief Policy of each allocation class
              */
-            inline static bool InRange(uint32_t zoneAddress)
-            {
-                return false;
-            }
+            inline static Policy policies[Placement::ClassCount] = {
+                { { Zone::HWRam }, 1 },
+                { { Zone::HWRam }, 1 },
+                { { Zone::HWRam, Zone::LWRam, Zone::CartRam }, 3 }
+            };
 
-            /** @brief Free allocated memory
-             * @param ptr Pointer to allocated memory
+            /** @brief Counters of each allocation class
              */
-            inline static void Free(void* ptr)
-            {
-                // TODO implement
-            }
+            inline static Stats stats[Placement::ClassCount] = { };
 
-            /** @brief Allocate some memory
-             * @param size Number of bytes to allocate
-             * @return Pointer to the allocated space in memory
+        public:
+
+            /** @brief Set zones allocation class can use
+             * @param allocationClass Allocation class
+             * @param zones Zones in order of preference, frame arena cannot be used
+             * @param count Number of zones
+             * @return true if policy was changed
              */
-            inline static void* Malloc(size_t size)
+            inline static bool SetPolicy(const AllocationClass allocationClass, const Zone* zones, const uint8_t count)
             {
-                return nullptr;
+                if (zones == nullptr || count == 0 || count > Placement::MaxZones)
+                {
+                    return false;
+                }
+
+                for (uint8_t zone = 0; zone < count; zone++)
+                {
+                    if (zones[zone] == Zone::Frame)
+                    {
+                        return false;
+                    }
+                }
+
+                Policy& policy = Placement::policies[static_cast<uint8_t>(allocationClass)];
+
+                for (uint8_t zone = 0; zone < count; zone++)
+                {
+                    policy.Zones[zone] = zones[zone];
+                }
+
+                policy.Count = count;
+                return true;
             }
 
-            /** @brief Reallocate existing memory
-             * @param ptr Pointer to the existing allocated memory
-             * @param size New size in number of bytes that should be allocated
-             * @return Pointer to the allocated space in memory
+            /** @brief Set zones allocation class can use
+             * @param allocationClass Allocation class
+             * @param zones Zones in order of preference, frame arena cannot be used
+             * @return true if policy was changed
              */
-            inline static void* Realloc(void* ptr, size_t size)
+            inline static bool SetPolicy(const AllocationClass allocationClass, std::initializer_list<Zone> zones)
             {
-                return nullptr;
+                return Placement::SetPolicy(allocationClass, zones.begin(), zones.size());
             }
 
-            /** @brief Gets total size of the free space in the memory zone
-             * @return Number of bytes
+            /** @brief Get zones allocation class can use
+             * @param allocationClass Allocation class
+             * @return Current policy
              */
-            inline static size_t GetFreeSpace()
+            inline static const Policy& GetPolicy(const AllocationClass allocationClass)
             {
-                return 0;
+                return Placement::policies[static_cast<uint8_t>(allocationClass)];
             }
 
-            /** @brief Gets report on the allocator state
-             * @return Current state of the allocator
+            /** @brief Get counters of allocation class
+             * @param allocationClass Allocation class
+             * @return Counters since start or last Placement::ResetStats()
              */
-            static const Report GetReport()
+            inline static const Stats& GetStats(const AllocationClass allocationClass)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return Report { 0, 0, 0, 0, 0};
-                #else
-                return Report { 0, 0, 0, 0, 0};
-                #endif
+                return Placement::stats[static_cast<uint8_t>(allocationClass)];
             }
 
-            /** @brief Gets total size of the memory zone
-             * @return Number of bytes
+            /** @brief Reset counters of all allocation classes
              */
-            inline static size_t GetSize()
+            inline static void ResetStats()
             {
-                return 0;
+                for (uint8_t allocationClass = 0; allocationClass < Placement::ClassCount; allocationClass++)
+                {
+                    Placement::stats[allocationClass] = { 0, 0, 0, 0 };
+                }
             }
-            
-            /** @brief Gets total size of the used space in the memory zone
-             * @return Number of bytes
+
+            /** @brief Allocate memory for allocation class
+             * @param size Number of bytes to allocate
+             * @param allocationClass Allocation class
+             * @return Pointer to the allocated space in memory
              */
-            inline static size_t GetUsedSpace()
+            inline static void* Malloc(size_t size, const AllocationClass allocationClass)
             {
-                return 0;
+                return Placement::Malloc(size, allocationClass, Placement::GetPolicy(allocationClass).Zones[0]);
             }
-        };
 
-        /** @brief Set memory to some value by 1 byte
-         * @param destination Destination to set
-         * @param value Value to set
-         * @param length Data length to set
-         */
-        inline static void MemSet(void* destination, const uint8_t value, const size_t length)
-        {
-            for (size_t i = 0; i < length; i++)
+            /** @brief Allocate memory for allocation class starting with specific zone
+             * @details Preferred zone is tried first, other zones of the policy are tried after it in order.
+             * @param size Number of bytes to allocate
+             * @param allocationClass Allocation class
+             * @param preferred Zone to try first
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Malloc(size_t size, const AllocationClass allocationClass, const Zone preferred)
             {
-                *(((uint8_t*)destination) + i) = value;
+                const Policy& policy = Placement::GetPolicy(allocationClass);
+                Stats& counters = Placement::stats[static_cast<uint8_t>(allocationClass)];
+                void* ptr = Memory::Malloc(size, preferred);
+                counters.Allocations++;
+
+                for (uint8_t zone = 0; zone < policy.Count && ptr == nullptr; zone++)
+                {
+                    if (policy.Zones[zone] != preferred)
+                    {
+                        ptr = Memory::Malloc(size, policy.Zones[zone]);
+
+                        if (ptr != nullptr)
+                        {
+                            counters.Spills++;
+                            counters.SpilledBytes += size;
+                        }
+                    }
+                }
+
+                if (ptr == nullptr)
+                {
+                    counters.Failures++;
+                }
+
+                return ptr;
             }
-        }
+        };
 
         /** @brief Initialize memory
          * @warning SGL is not yet initialized at this point
@@ -818,6 +3687,9 @@ namespace SRL
             case Zone::CartRam:
                 return CartRam::GetUsedSpace();
 
+            case Zone::Frame:
+                return FrameArena::GetUsedSpace();
+
             default:
                 return 0;
             }
@@ -840,6 +3712,9 @@ namespace SRL
             case Zone::CartRam:
                 return CartRam::GetFreeSpace();
 
+            case Zone::Frame:
+                return FrameArena::GetFreeSpace();
+
             default:
                 return 0;
             }
@@ -862,17 +3737,50 @@ namespace SRL
             case Zone::CartRam:
                 return CartRam::GetSize();
 
+            case Zone::Frame:
+                return FrameArena::GetSize();
+
             default:
                 return 0;
             }
         }
 
+        /** @brief Gets report on the allocator state of the memory zone
+         * @param zone Memory zone
+         * @return Current state of the allocator
+         */
+        inline static const Report GetReport(const Zone zone)
+        {
+            switch (zone)
+            {
+            case Zone::HWRam:
+                return HighWorkRam::GetReport();
+
+            case Zone::LWRam:
+                return LowWorkRam::GetReport();
+
+            case Zone::CartRam:
+                return CartRam::GetReport();
+
+            case Zone::Frame:
+                return FrameArena::GetReport();
+
+            default:
+                return Report { 0, 0, 0, 0, 0, 0 };
+            }
+        }
+
         /** @brief Free allocated memory from any memory zone
          * @param ptr Pointer to allocated memory
          */
         inline static void Free(void* ptr)
         {
-            if (HighWorkRam::InRange(ptr))
+            if (FrameArena::InRange(ptr))
+            {
+                // Arena memory is reclaimed all at once on frame swap
+                return;
+            }
+            else if (HighWorkRam::InRange(ptr))
             {
                 HighWorkRam::Free(ptr);
             }
@@ -898,6 +3806,9 @@ namespace SRL
             case SRL::Memory::Zone::CartRam:
                 return SRL::Memory::CartRam::Malloc(size);
 
+            case SRL::Memory::Zone::Frame:
+                return SRL::Memory::FrameArena::Malloc(size);
+
             case SRL::Memory::Zone::LWRam:
                 return SRL::Memory::LowWorkRam::Malloc(size);
 
@@ -906,7 +3817,19 @@ namespace SRL
             }
         }
 
+        /** @brief Allocate some memory for allocation class
+         * @details Zone is chosen by Memory::Placement policy of the class
+         * @param size Number of bytes to allocate
+         * @param allocationClass Allocation class
+         * @return Pointer to the allocated space in memory
+         */
+        inline static void* Malloc(size_t size, const SRL::Memory::AllocationClass allocationClass)
+        {
+            return SRL::Memory::Placement::Malloc(size, allocationClass);
+        }
+
         /** @brief Allocate some memory in zone containing specified address
+         * @details If the zone is full, allocation spills over to other zones of AllocationClass::Default policy, frame arena never spills
          * @param size Number of bytes to allocate
          * @param address Address in the memory where object should be allocated
          * @return Pointer to the allocated space in memory
@@ -914,23 +3837,28 @@ namespace SRL
         inline static void* PlacementMalloc(size_t size, uint32_t address)
         {
             // Figure out what malloc we have to use
-            if (SRL::Memory::HighWorkRam::InRange(address))
+            if (SRL::Memory::FrameArena::InRange(address))
             {
-                return SRL::Memory::HighWorkRam::Malloc(size);
+                return SRL::Memory::FrameArena::Malloc(size);
+            }
+            else if (SRL::Memory::HighWorkRam::InRange(address))
+            {
+                return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default, SRL::Memory::Zone::HWRam);
             }
             else if (SRL::Memory::LowWorkRam::InRange(address))
             {
-                return SRL::Memory::LowWorkRam::Malloc(size);
+                return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default, SRL::Memory::Zone::LWRam);
             }
             else if (SRL::Memory::CartRam::InRange(address))
             {
-                return SRL::Memory::CartRam::Malloc(size);
+                return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default, SRL::Memory::Zone::CartRam);
             }
 
             return NULL;
         }
 
         /** @brief Allocate some memory in zone containing specified address
+         * @details If the zone is full, allocation spills over to other zones of AllocationClass::Default policy, frame arena never spills
          * @param size Number of bytes to allocate
          * @param address Address in the memory where object should be allocated
          * @return Pointer to the allocated space in memory
@@ -938,17 +3866,21 @@ namespace SRL
         inline static void* PlacementMalloc(size_t size, void* address)
         {
             // Figure out what malloc we have to use
-            if (SRL::Memory::HighWorkRam::InRange(address))
+            if (SRL::Memory::FrameArena::InRange(address))
             {
-                return SRL::Memory::HighWorkRam::Malloc(size);
+                return SRL::Memory::FrameArena::Malloc(size);
+            }
+            else if (SRL::Memory::HighWorkRam::InRange(address))
+            {
+                return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default, SRL::Memory::Zone::HWRam);
             }
             else if (SRL::Memory::LowWorkRam::InRange(address))
             {
-                return SRL::Memory::LowWorkRam::Malloc(size);
+                return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default, SRL::Memory::Zone::LWRam);
             }
             else if (SRL::Memory::CartRam::InRange(address))
             {
-                return SRL::Memory::CartRam::Malloc(size);
+                return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default, SRL::Memory::Zone::CartRam);
             }
 
             return NULL;
@@ -984,6 +3916,21 @@ namespace SRL
  */
 #define lwnew new (SRL::Memory::Zone::LWRam)
 
+/** @relates SRL::Memory
+ * @brief @c new keyword for per-frame arena
+ * @note Memory is valid until the end of the next frame, see SRL::Memory::FrameArena
+ * @code {.cpp}
+ * class MyFirstThing { }
+ * 
+ * void main()
+ * {
+ *      // Allocates MyFirstThing in the frame arena
+ *      MyFirstThing* second = framenew MyFirstThing();
+ * }
+ * @endcode
+ */
+#define framenew new (SRL::Memory::Zone::Frame)
+
 /** @relates SRL::Memory
  * @brief @c new keyword for high work RAM 
  * @code {.cpp}
@@ -1001,9 +3948,38 @@ namespace SRL
  */
 #define hwnew new
 
+/** @relates SRL::Memory
+ * @brief @c new keyword for bulk data that can spill over to slower memory zones
+ * @note Zones are chosen by SRL::Memory::Placement policy of SRL::Memory::AllocationClass::Bulk
+ * @code {.cpp}
+ * void main()
+ * {
+ *      // Allocates level data in high RAM, or in low RAM or cart RAM if high RAM is full
+ *      uint8_t* level = bulknew uint8_t[size];
+ * }
+ * @endcode
+ */
+#define bulknew new (SRL::Memory::AllocationClass::Bulk)
+
+/** @relates SRL::Memory
+ * @brief @c new keyword for hot data that should stay in fast memory
+ * @note Zones are chosen by SRL::Memory::Placement policy of SRL::Memory::AllocationClass::Hot
+ * @code {.cpp}
+ * class MyFirstThing { }
+ * 
+ * void main()
+ * {
+ *      // Allocates MyFirstThing in the high RAM, fails rather than spilling over to slower RAM
+ *      MyFirstThing* first = hotnew MyFirstThing();
+ * }
+ * @endcode
+ */
+#define hotnew new (SRL::Memory::AllocationClass::Hot)
+
 /** @relates SRL::Memory
  * @brief Allocates memory in the same zone as current context
  * @warning <b>Extreme cation is required</b>.<br/> This will allocate new object in the same zone as the @c this keyword is present in.
+ * @note If the zone is full, object is allocated in other zone of SRL::Memory::AllocationClass::Default policy (see SRL::Memory::Placement)
  * @code {.cpp}
  * class MyFirstThing { }
  * 
@@ -1058,7 +4034,17 @@ inline void* operator new[](size_t size, uint32_t zoneAddress)
  */
 inline void* operator new(size_t size)
 {
-    return SRL::Memory::HighWorkRam::Malloc(size);
+    return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default);
+}
+
+/** @brief Allocate some memory
+ * @param size Number of bytes to allocate
+ * @param allocationClass Allocation class deciding memory zone (see SRL::Memory::Placement)
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new(size_t size, const SRL::Memory::AllocationClass allocationClass)
+{
+    return SRL::Memory::Placement::Malloc(size, allocationClass);
 }
 
 /** @brief Allocate some memory
@@ -1073,6 +4059,9 @@ inline void* operator new(size_t size, const SRL::Memory::Zone zone)
     case SRL::Memory::Zone::CartRam:
         return SRL::Memory::CartRam::Malloc(size);
 
+    case SRL::Memory::Zone::Frame:
+        return SRL::Memory::FrameArena::Malloc(size);
+
     case SRL::Memory::Zone::LWRam:
         return SRL::Memory::LowWorkRam::Malloc(size);
 
@@ -1104,7 +4093,17 @@ inline void operator delete(void* ptr, size_t size)
  */
 inline void* operator new[](size_t size)
 {
-    return SRL::Memory::HighWorkRam::Malloc(size);
+    return SRL::Memory::Placement::Malloc(size, SRL::Memory::AllocationClass::Default);
+}
+
+/** @brief Allocate some memory for array
+ * @param size Number of bytes to allocate
+ * @param allocationClass Allocation class deciding memory zone (see SRL::Memory::Placement)
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new[](size_t size, const SRL::Memory::AllocationClass allocationClass)
+{
+    return SRL::Memory::Placement::Malloc(size, allocationClass);
 }
 
 /** @brief Allocate some memory
@@ -1118,6 +4117,9 @@ inline void* operator new[](size_t size, const SRL::Memory::Zone zone)
     case SRL::Memory::Zone::CartRam:
         return SRL::Memory::CartRam::Malloc(size);
 
+    case SRL::Memory::Zone::Frame:
+        return SRL::Memory::FrameArena::Malloc(size);
+
     case SRL::Memory::Zone::LWRam:
         return SRL::Memory::LowWorkRam::Malloc(size);
 
@@ -3,6 +3,7 @@
 #include "srl_base.hpp"
 #include "srl_memory.hpp"
 #include "srl_cd.hpp"
+#include "srl_lz.hpp"
 
 extern "C" { 
     #include <sega_snd.h>
@@ -500,6 +501,7 @@ namespace SRL::Sound
 
         /** @brief Raw PCM sound
          * @details Data format should be either pcm_s16be or pcm_s8. To do stereo, right channel must occupy first half of the file and left channel second half.
+         * File can be compressed with tools/scripts/srl_lz.py.
          */
         class RawPcm : public Pcm::IPcmFile
         {
@@ -519,8 +521,11 @@ namespace SRL::Sound
                     return;
                 }
 
+                const int32_t compressedSize = Lz::GetSize(file);
+                const int32_t size = compressedSize >= 0 ? compressedSize : file->Size.Bytes;
+
                 // slPCMOn won't play samples shorter than 0x900
-                size_t clampedLength = SRL::Math::Max<uint32_t>(file->Size.Bytes, 0x900);
+                size_t clampedLength = SRL::Math::Max<uint32_t>(size, 0x900);
                 
                 this->data = autonew int8_t[clampedLength];
                 this->dataSize = clampedLength;
@@ -528,12 +533,12 @@ namespace SRL::Sound
                 this->depth = (uint8_t)depth;
                 this->sampleRate = sampleRate;
 
-                for (size_t byte = file->Size.Bytes; byte < clampedLength; byte++) this->data[byte] = 0x00;
-                int32_t loaded = file->LoadBytes(0, file->Size.Bytes, this->data);
+                for (size_t byte = size; byte < clampedLength; byte++) this->data[byte] = 0x00;
+                int32_t loaded = compressedSize >= 0 ? Lz::Load(file, this->data, size) : file->LoadBytes(0, size, this->data);
 
-                if (loaded != file->Size.Bytes)
+                if (loaded != size)
                 {
-                    Debug::Assert("Reached end of a file! Got %dbytes instead of %dbytes", loaded, file->Size.Bytes);
+                    Debug::Assert("Reached end of a file! Got %dbytes instead of %dbytes", loaded, size);
                 }
             }
 
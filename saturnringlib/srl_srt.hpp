@@ -0,0 +1,452 @@
+#pragma once
+
+#include "srl_debug.hpp"
+#include "srl_bitmap.hpp"
+#include "srl_cd.hpp"
+#include "srl_lz.hpp"
+
+namespace SRL::Bitmap
+{
+    /** @brief Native SRL texture
+     * @details Texture file holds pixels already in VDP1 layout (width padded to 8, RGB555 or color indexes) and palette in color RAM format,
+     * loading it is just a copy or LZ decompression, there is no per pixel processing nor byte swapping.<br/>
+     * File starts with SRT::Header, followed by palette padded to 4 bytes and pixel data (optionally compressed as SRL::Lz asset), all numbers are big endian.
+     * Files are created from TGA images by tools/scripts/srl_texture.py.
+     * @code {.cpp}
+     * SRL::VDP1::TextureTarget texture(paletteHandler);
+     * SRL::Bitmap::SRT image("TREE.SRT", &texture);
+     * int32_t id = texture.GetId();
+     * @endcode
+     */
+    struct SRT : IBitmap
+    {
+    public:
+        /** @brief Texture file header (all numbers are big endian)
+         */
+        struct Header
+        {
+            /** @brief Texture identifier, must be "SRLT"
+             */
+            char Magic[4];
+
+            /** @brief Format version
+             */
+            uint16_t Version;
+
+            /** @brief Texture width in pixels, always multiple of 8
+             */
+            uint16_t Width;
+
+            /** @brief Texture height in pixels
+             */
+            uint16_t Height;
+
+            /** @brief Color mode (value of CRAM::TextureColorMode)
+             */
+            uint16_t ColorMode;
+
+            /** @brief Number of colors in the palette (0 for RGB555 texture)
+             */
+            uint16_t PaletteCount;
+
+            /** @brief Texture flags (see SRT::CompressedFlag)
+             */
+            uint16_t Flags;
+
+            /** @brief Size of pixel data stored in the file in bytes
+             */
+            uint32_t DataSize;
+
+            /** @brief Check whether pixel data are compressed
+             * @return true if pixel data are SRL::Lz asset
+             */
+            constexpr bool IsCompressed() const
+            {
+                return (this->Flags & SRT::CompressedFlag) != 0;
+            }
+
+            /** @brief Get offset of pixel data from start of the file
+             * @return Offset in bytes
+             */
+            constexpr uint32_t GetDataOffset() const
+            {
+                return sizeof(Header) + (((this->PaletteCount << 1) + 3) & ~3);
+            }
+
+            /** @brief Get size of pixels in VDP1 layout
+             * @return Size in bytes
+             */
+            constexpr uint32_t GetPixelSize() const
+            {
+                const uint32_t pixels = this->Width * this->Height;
+
+                switch (static_cast<CRAM::TextureColorMode>(this->ColorMode))
+                {
+                case CRAM::TextureColorMode::RGB555:
+                    return pixels << 1;
+
+                case CRAM::TextureColorMode::Paletted16:
+                    return pixels >> 1;
+
+                default:
+                    return pixels;
+                }
+            }
+
+            /** @brief Check whether header is valid
+             * @return true if header belongs to supported texture
+             */
+            constexpr bool IsValid() const
+            {
+                if (this->Magic[0] != 'S' || this->Magic[1] != 'R' || this->Magic[2] != 'L' || this->Magic[3] != 'T' ||
+                    this->Version != SRT::FormatVersion ||
+                    this->Width == 0 || (this->Width & 7) != 0 || this->Height == 0 ||
+                    (!this->IsCompressed() && this->DataSize != this->GetPixelSize()))
+                {
+                    return false;
+                }
+
+                switch (static_cast<CRAM::TextureColorMode>(this->ColorMode))
+                {
+                case CRAM::TextureColorMode::RGB555:
+                    return this->PaletteCount == 0;
+
+                case CRAM::TextureColorMode::Paletted16:
+                    return this->PaletteCount > 0 && this->PaletteCount <= 16;
+
+                case CRAM::TextureColorMode::Paletted64:
+                    return this->PaletteCount > 0 && this->PaletteCount <= 64;
+
+                case CRAM::TextureColorMode::Paletted128:
+                    return this->PaletteCount > 0 && this->PaletteCount <= 128;
+
+                case CRAM::TextureColorMode::Paletted256:
+                    return this->PaletteCount > 0 && this->PaletteCount <= 256;
+
+                default:
+                    return false;
+                }
+            }
+        };
+
+        /** @brief Supported format version
+         */
+        inline static const uint16_t FormatVersion = 1;
+
+        /** @brief Pixel data are compressed
+         */
+        inline static const uint16_t CompressedFlag = 0x0001;
+
+    private:
+        /** @brief Texture header
+         */
+        Header header;
+
+        /** @brief Color palette, nullptr for RGB555 texture
+         */
+        Bitmap::Palette* palette;
+
+        /** @brief Pixel data
+         */
+        uint8_t* imageData;
+
+        /** @brief Pixel data were allocated by the texture
+         */
+        bool ownsData;
+
+        /** @brief Pixel data as stored in the file when texture is constructed from memory
+         */
+        const uint8_t* storedData;
+
+        /** @brief Copy texture rows into decode target
+         * @param pixels Pixels in VDP1 layout
+         * @param target Where to copy rows to
+         */
+        void CopyRows(const uint8_t* pixels, Bitmap::IDecodeTarget* target)
+        {
+            const uint32_t rowBytes = this->header.GetPixelSize() / this->header.Height;
+
+            for (uint16_t y = 0; y < this->header.Height; y++, pixels += rowBytes)
+            {
+                Memory::MemCopy(target->GetRow(y), pixels, rowBytes);
+            }
+        }
+
+        /** @brief Decompress pixels into decode target
+         * @param compressed Compressed pixel data
+         * @param target Where to write rows to
+         * @return true on success
+         */
+        bool DecompressRows(const void* compressed, Bitmap::IDecodeTarget* target)
+        {
+            // Rows of a target do not have to follow each other, decompressor needs whole output as its history
+            const int32_t size = this->header.GetPixelSize();
+            uint8_t* pixels = new uint8_t[size];
+            const bool valid = Lz::Decompress(compressed, pixels, size) == size;
+
+            if (valid)
+            {
+                this->CopyRows(pixels, target);
+            }
+
+            delete[] pixels;
+            return valid;
+        }
+
+        /** @brief Copy header out of data in memory
+         * @note Data do not need to be aligned, header is copied byte by byte if they are not
+         * @param data Data starting with header
+         * @return Copy of the header
+         */
+        inline static Header ReadHeader(const void* data)
+        {
+            Header header;
+            Memory::MemCopy(&header, data, sizeof(Header));
+            return header;
+        }
+
+        /** @brief Create palette
+         * @return Palette to fill with colors, nullptr for RGB555 texture
+         */
+        Bitmap::Palette* CreatePalette()
+        {
+            return this->header.PaletteCount > 0 ? autonew Bitmap::Palette(this->header.PaletteCount) : nullptr;
+        }
+
+        /** @brief Load texture from memory
+         * @param stream Whole texture file
+         * @param size Size of the file data in bytes
+         * @param target Where to write pixels to, nullptr to keep them in the texture
+         * @param loadPixels Whether to transfer pixels
+         */
+        void LoadData(uint8_t* stream, int32_t size, Bitmap::IDecodeTarget* target, bool loadPixels)
+        {
+            if (stream == nullptr || size < static_cast<int32_t>(sizeof(Header)))
+            {
+                SRL::Debug::Assert("File is not valid SRL texture!");
+                return;
+            }
+
+            const Header header = SRT::ReadHeader(stream);
+
+            if (!header.IsValid() || size < static_cast<int32_t>(header.GetDataOffset() + header.DataSize))
+            {
+                SRL::Debug::Assert("File is not valid SRL texture!");
+                return;
+            }
+
+            this->header = header;
+            this->palette = this->CreatePalette();
+
+            if (this->palette != nullptr)
+            {
+                Memory::MemCopy(this->palette->Colors, stream + sizeof(Header), this->header.PaletteCount << 1);
+            }
+
+            this->storedData = stream + this->header.GetDataOffset();
+
+            if (target != nullptr)
+            {
+                if (!target->Begin(this->GetInfo()) || !loadPixels)
+                {
+                    return;
+                }
+
+                if (!this->header.IsCompressed())
+                {
+                    this->CopyRows(this->storedData, target);
+                }
+                else if (!this->DecompressRows(this->storedData, target))
+                {
+                    SRL::Debug::Assert("Texture data are corrupted!");
+                }
+
+                target->End();
+            }
+            else if (this->header.IsCompressed())
+            {
+                if (loadPixels)
+                {
+                    this->imageData = autonew uint8_t[this->header.GetPixelSize()];
+                    this->ownsData = true;
+
+                    if (Lz::Decompress(this->storedData, this->imageData, this->header.GetPixelSize()) != static_cast<int32_t>(this->header.GetPixelSize()))
+                    {
+                        SRL::Debug::Assert("Texture data are corrupted!");
+                    }
+                }
+            }
+            else
+            {
+                // Pixels are used right where they are
+                this->imageData = const_cast<uint8_t*>(this->storedData);
+            }
+        }
+
+        /** @brief Load texture from file
+         * @note File is left in the same open state it was in
+         * @param file Texture file
+         * @param target Where to write pixels to, nullptr to keep them in the texture
+         */
+        void LoadData(Cd::File* file, Bitmap::IDecodeTarget* target)
+        {
+            const bool wasOpen = file->IsOpen();
+
+            if (file->Open() &&
+                file->Seek(0) == 0 &&
+                file->Read(sizeof(Header), &this->header) == sizeof(Header) &&
+                this->header.IsValid())
+            {
+                const int32_t size = this->header.GetPixelSize();
+                this->palette = this->CreatePalette();
+
+                bool valid = (this->palette == nullptr || file->Read(this->header.PaletteCount << 1, this->palette->Colors) == (this->header.PaletteCount << 1)) &&
+                    file->Seek(this->header.GetDataOffset()) == static_cast<int32_t>(this->header.GetDataOffset());
+
+                if (valid && target != nullptr)
+                {
+                    if (target->Begin(this->GetInfo()))
+                    {
+                        if (this->header.IsCompressed())
+                        {
+                            uint8_t* compressed = new uint8_t[this->header.DataSize];
+                            valid = file->Read(this->header.DataSize, compressed) == static_cast<int32_t>(this->header.DataSize) && this->DecompressRows(compressed, target);
+                            delete[] compressed;
+                        }
+                        else
+                        {
+                            const int32_t rowBytes = size / this->header.Height;
+
+                            for (uint16_t y = 0; valid && y < this->header.Height; y++)
+                            {
+                                valid = file->Read(rowBytes, target->GetRow(y)) == rowBytes;
+                            }
+                        }
+
+                        target->End();
+                    }
+                }
+                else if (valid)
+                {
+                    this->imageData = autonew uint8_t[size];
+                    this->ownsData = true;
+                    valid = (this->header.IsCompressed() ? Lz::DecompressStream(file, this->imageData, size) : file->Read(size, this->imageData)) == size;
+                }
+
+                if (!valid)
+                {
+                    SRL::Debug::Assert("Texture data are corrupted!");
+                }
+            }
+            else
+            {
+                SRL::Debug::Assert("File is not valid SRL texture!");
+            }
+
+            if (!wasOpen)
+            {
+                file->Close();
+            }
+        }
+
+    public:
+        /** @brief Check whether data in memory are native texture
+         * @param data Data to check, do not need to be aligned
+         * @return true if data start with valid header
+         */
+        inline static bool IsNative(const void* data)
+        {
+            return data != nullptr && SRT::ReadHeader(data).IsValid();
+        }
+
+        /** @brief Load texture from file
+         * @param file Texture file
+         * @param target Where to write pixels to (e.g. VDP1::TextureTarget), nullptr to keep them in the texture
+         */
+        SRT(Cd::File* file, Bitmap::IDecodeTarget* target = nullptr) : header(), palette(nullptr), imageData(nullptr), ownsData(false), storedData(nullptr)
+        {
+            this->LoadData(file, target);
+        }
+
+        /** @brief Load texture from file
+         * @param filename Texture file name
+         * @param target Where to write pixels to (e.g. VDP1::TextureTarget), nullptr to keep them in the texture
+         */
+        SRT(const char* filename, Bitmap::IDecodeTarget* target = nullptr) : header(), palette(nullptr), imageData(nullptr), ownsData(false), storedData(nullptr)
+        {
+            Cd::File file = Cd::File(filename);
+
+            if (file.Exists())
+            {
+                this->LoadData(&file, target);
+            }
+            else
+            {
+                SRL::Debug::Assert("File '%s' is missing!", filename);
+            }
+        }
+
+        /** @brief Load texture from file data in memory
+         * @details Uncompressed pixels are not copied, image data point into the stream, which must then stay valid while the texture is used.
+         * @param stream Whole texture file (aligned to 4 bytes)
+         * @param size Size of the file data in bytes
+         * @param target Where to write pixels to (e.g. VDP1::TextureTarget), nullptr to keep them in the texture
+         * @param loadPixels When false, only header and palette are processed (and target is prepared), caller transfers pixels from GetStoredData() itself
+         */
+        SRT(uint8_t* stream, int32_t size, Bitmap::IDecodeTarget* target = nullptr, bool loadPixels = true) :
+            header(),
+            palette(nullptr),
+            imageData(nullptr),
+            ownsData(false),
+            storedData(nullptr)
+        {
+            this->LoadData(stream, size, target, loadPixels);
+        }
+
+        /** @brief Destroy the texture
+         */
+        ~SRT()
+        {
+            if (this->ownsData)
+            {
+                delete[] this->imageData;
+            }
+
+            delete this->palette;
+        }
+
+        /** @brief Get texture header
+         * @return Texture header, not valid if texture failed to load
+         */
+        const Header& GetHeader() const
+        {
+            return this->header;
+        }
+
+        /** @brief Get pixel data as they are stored in the file
+         * @return Pixels in VDP1 layout or SRL::Lz asset if texture is compressed, nullptr if texture was not constructed from memory
+         */
+        const uint8_t* GetStoredData() const
+        {
+            return this->storedData;
+        }
+
+        /** @brief Get image data
+         * @return Pointer to pixels in VDP1 layout, nullptr if pixels were written to target
+         */
+        uint8_t* GetData() override
+        {
+            return this->imageData;
+        }
+
+        /** @brief Get image info
+         * @return image info
+         */
+        BitmapInfo GetInfo() override
+        {
+            BitmapInfo info = BitmapInfo(this->header.Width, this->header.Height, this->palette);
+            info.ColorMode = static_cast<CRAM::TextureColorMode>(this->header.ColorMode);
+            return info;
+        }
+    };
+}
@@ -4,6 +4,7 @@
 #include "srl_bitmap.hpp"
 #include "srl_cd.hpp"
 #include "srl_endian.hpp"
+#include "srl_slave.hpp"
 
 /*
  * This TGA loader is loosely based on TGA loader from yaul by:
@@ -69,23 +70,6 @@ namespace SRL::Bitmap
             int8_t Reserved;
         };
 
-        /** @brief For loop range
-         */
-        struct ForRange
-        {
-            /** @brief Loop start
-             */
-            int32_t Start;
-
-            /** @brief Loop end
-             */
-            int32_t End;
-
-            /** @brief Loop step
-             */
-            int32_t Step;
-        };
-
         /** @brief
          */
         enum TgaOrigin
@@ -170,32 +154,6 @@ namespace SRL::Bitmap
         };
 #pragma pack(pop)
 
-#pragma pack(push, 1)
-        /** @brief Run length encoding packet
-         */
-        struct TgaRlePacket
-        {
-            enum class PacketType : uint8_t
-            {
-                /** @brief Count contains number of pixels after the packet
-                 */
-                RawPacket = 0,
-
-                /** @brief Count contains number of repetitions of a color specified after the packet
-                 */
-                RlePacket = 1
-            };
-
-            /** @brief Type of the packet
-             */
-            PacketType Type:1;
-
-            /** @brief Number of pixels or repetitions
-             */
-            uint8_t Count:7;
-        };
-#pragma pack(pop)
-
         /** @brief Color palette
          */
         Bitmap::Palette* palette;
@@ -208,22 +166,273 @@ namespace SRL::Bitmap
          */
         size_t height;
 
-        /** @brief Image data
+        /** @brief Image data, nullptr when image is decoded into a target
          */
         uint8_t* imageData;
 
-        /** @brief Get color from ARGB value
-         * @param argb ARGB value
-         * @return Color value
+        /** @brief Where pixels are decoded to, nullptr to decode them into image data
+         */
+        Bitmap::IDecodeTarget* target;
+
+        /** @brief Number of bytes read from file at once
+         */
+        inline static const int32_t StreamChunkSize = 2048;
+
+        /** @brief Largest number of bytes single pixel or palette entry takes
+         */
+        inline static const int32_t MaxPixelBytes = 4;
+
+        /** @brief Returned in place of pixels once input is exhausted, truncated image is filled with transparent color
+         */
+        inline static const uint8_t Padding[TGA::MaxPixelBytes] = { 0 };
+
+        /** @brief Image data in memory
+         */
+        struct MemoryInput
+        {
+            /** @brief Current input byte
+             */
+            const uint8_t* current;
+
+            /** @brief End of the input
+             */
+            const uint8_t* end;
+
+            /** @brief Set when data were requested past the end of the input
+             */
+            bool exhausted;
+
+            /** @brief Get run of values stored one after another
+             * @param count Number of wanted values, changed to number of values actually returned
+             * @param size Size of single value in bytes
+             * @return Pointer to the values
+             */
+            const uint8_t* Fetch(int32_t& count, const uint8_t size)
+            {
+                const int32_t available = (this->end - this->current) / size;
+
+                if (available == 0)
+                {
+                    this->exhausted = true;
+                    count = 1;
+                    return TGA::Padding;
+                }
+
+                count = count < available ? count : available;
+                const uint8_t* data = this->current;
+                this->current += count * size;
+                return data;
+            }
+
+            /** @brief Copy bytes from the input
+             * @param destination Where to copy bytes
+             * @param count Number of bytes to copy
+             * @return false if input is exhausted
+             */
+            bool Take(uint8_t* destination, int32_t count)
+            {
+                if (this->end - this->current < count)
+                {
+                    this->exhausted = true;
+                    return false;
+                }
+
+                Memory::MemCopy(destination, this->current, count);
+                this->current += count;
+                return true;
+            }
+
+            /** @brief Skip bytes of the input
+             * @param count Number of bytes to skip
+             * @return false if input is exhausted
+             */
+            bool Skip(int32_t count)
+            {
+                if (this->end - this->current < count)
+                {
+                    this->exhausted = true;
+                    return false;
+                }
+
+                this->current += count;
+                return true;
+            }
+        };
+
+        /** @brief Image data read from a stream through small window
+         * @details Bytes of a value split between two chunks are moved in front of the next chunk, so every value can be read directly from the window.
+         * Chunk itself is kept aligned, so whole sectors can be read straight into it.
+         * @tparam Source Type with Cd::File like Read(size, destination) function
+         */
+        template<typename Source>
+        struct StreamInput
+        {
+            /** @brief Stream image data are read from
+             */
+            Source* source;
+
+            /** @brief Number of bytes not yet read from the stream
+             */
+            int32_t remaining;
+
+            /** @brief Read window, room for unread bytes of previous chunk followed by the chunk
+             */
+            uint8_t* buffer;
+
+            /** @brief Current byte in read window
+             */
+            const uint8_t* current;
+
+            /** @brief End of valid data in read window
+             */
+            const uint8_t* end;
+
+            /** @brief Set when data were requested past the end of the input or stream failed
+             */
+            bool exhausted;
+
+            /** @brief Load next chunk of the stream into the read window
+             * @param size Number of bytes that must be available after refill
+             * @return false if stream is exhausted or failed
+             */
+            bool Refill(const int32_t size)
+            {
+                uint8_t* chunk = this->buffer + TGA::MaxPixelBytes;
+                const int32_t left = this->end - this->current;
+                const int32_t count = SRL::Math::Min<int32_t>(this->remaining, TGA::StreamChunkSize);
+
+                if (count <= 0 || left + count < size)
+                {
+                    return false;
+                }
+
+                // Unread bytes of the last value are always fewer than bytes of single value, so they fit in front of the chunk
+                for (int32_t index = 0; index < left; index++)
+                {
+                    chunk[index - left] = this->current[index];
+                }
+
+                if (this->source->Read(count, chunk) != count)
+                {
+                    this->remaining = 0;
+                    return false;
+                }
+
+                this->remaining -= count;
+                this->current = chunk - left;
+                this->end = chunk + count;
+                return true;
+            }
+
+            /** @brief Get run of values stored one after another
+             * @param count Number of wanted values, changed to number of values actually returned
+             * @param size Size of single value in bytes
+             * @return Pointer to the values
+             */
+            const uint8_t* Fetch(int32_t& count, const uint8_t size)
+            {
+                if (this->end - this->current < size && !this->Refill(size))
+                {
+                    this->exhausted = true;
+                    count = 1;
+                    return TGA::Padding;
+                }
+
+                const int32_t available = (this->end - this->current) / size;
+                count = count < available ? count : available;
+                const uint8_t* data = this->current;
+                this->current += count * size;
+                return data;
+            }
+
+            /** @brief Copy bytes from the input
+             * @param destination Where to copy bytes, nullptr to skip them
+             * @param count Number of bytes to copy
+             * @return false if input is exhausted
+             */
+            bool Take(uint8_t* destination, int32_t count)
+            {
+                while (count > 0)
+                {
+                    if (this->current >= this->end && !this->Refill(1))
+                    {
+                        this->exhausted = true;
+                        return false;
+                    }
+
+                    const int32_t available = SRL::Math::Min<int32_t>(this->end - this->current, count);
+
+                    if (destination != nullptr)
+                    {
+                        Memory::MemCopy(destination, this->current, available);
+                        destination += available;
+                    }
+
+                    this->current += available;
+                    count -= available;
+                }
+
+                return true;
+            }
+
+            /** @brief Skip bytes of the input
+             * @param count Number of bytes to skip
+             * @return false if input is exhausted
+             */
+            bool Skip(int32_t count)
+            {
+                return this->Take(nullptr, count);
+            }
+        };
+
+        /** @brief Read pixel and convert it to Saturn ABGR555
+         * @details Channels are moved into place by shifting and masking the whole value, there is no per channel conversion.
+         * 15 bit colors are always opaque, 16 bit colors are transparent when their alpha bit is clear and 32 bit colors are transparent when black with alpha below 128.
+         * @tparam Bits Color depth of the pixel (15, 16, 24 or 32)
+         * @param data Pixel data (little endian ARGB1555, BGR888 or BGRA8888)
+         * @param transparent Color that should be changed to be transparent
+         * @return Color in ABGR555
          */
-        constexpr inline static SRL::Types::HighColor ParseArgb(uint32_t argb)
+        template<uint8_t Bits>
+        inline static uint16_t ReadColor(const uint8_t* data, const uint16_t transparent)
         {
-            if (((argb >> 24) & 0xff) < 128 && (argb & 0x00ffffff) == 0)
+            uint16_t color;
+
+            if constexpr (Bits <= 16)
             {
-                return SRL::Types::HighColor();
+                // Swap red and blue of xRRRRRGGGGGBBBBB
+                const uint16_t value = data[0] | (data[1] << 8);
+                color = ((value & 0x001f) << 10) | (value & 0x03e0) | ((value >> 10) & 0x001f);
+
+                if (Bits == 15 || (value & 0x8000) != 0)
+                {
+                    color |= 0x8000;
+                }
+                else
+                {
+                    color = 0;
+                }
+            }
+            else
+            {
+                color = 0x8000 | ((data[0] & 0xf8) << 7) | ((data[1] & 0xf8) << 2) | (data[2] >> 3);
+
+                if (Bits == 32 && data[3] < 128 && (data[0] | data[1] | data[2]) == 0)
+                {
+                    color = 0;
+                }
             }
 
-            return SRL::Types::HighColor::FromARGB32(argb | 0xff000000);
+            return color != transparent ? color : 0;
+        }
+
+        /** @brief Get number of bytes pixel takes
+         * @param bits Color depth of the pixel
+         * @return Number of bytes
+         */
+        constexpr inline static uint8_t GetPixelBytes(const uint8_t bits)
+        {
+            return (bits + 7) >> 3;
         }
 
         /** @brief Check if format is wrong or not
@@ -271,384 +480,239 @@ namespace SRL::Bitmap
             return true;
         }
 
-        /** @brief Get offset to data block
-         * @param header TGA header
-         * @return Offset to the data block
+        /** @brief Decode palette colors
+         * @tparam Bits Color depth of palette entry
+         * @tparam Input Input type
+         * @param input Image data positioned at the palette
+         * @param palette Palette to fill
+         * @param transparentColor Index of color that should be changed to be transparent
          */
-        constexpr inline static uint32_t ImageDataOffset(const TGA::TgaHeader* header)
+        template<uint8_t Bits, typename Input>
+        inline static void DecodePaletteColors(Input& input, Bitmap::Palette* palette, int32_t transparentColor)
         {
-            return TGA::HeaderSize + header->ImageIdLength + (header->Palette.PaletteLength * (header->Palette.PaletteColorDepth >> 3));
-        }
+            for (int32_t index = 0; index < static_cast<int32_t>(palette->Count);)
+            {
+                int32_t count = palette->Count - index;
+                const uint8_t* data = input.Fetch(count, TGA::GetPixelBytes(Bits));
 
-        /** @brief Get offset to palette block
-         * @param header TGA header
-         * @return Offset to the palette block
-         */
-        constexpr inline static uint32_t ImagePaletteOffset(const TGA::TgaHeader* header)
-        {
-            return TGA::HeaderSize + header->ImageIdLength;
+                for (; count > 0; count--, index++, data += TGA::GetPixelBytes(Bits))
+                {
+                    palette->Colors[index] = index != transparentColor ? SRL::Types::HighColor(TGA::ReadColor<Bits>(data, 0)) : SRL::Types::HighColor();
+                }
+            }
         }
 
-        /** @brief Decode image header
-         * @param stream File stream
+        /** @brief Decode image palette
+         * @tparam Input Input type
+         * @param input Image data positioned at the palette
          * @param header File header
          * @param transparentColor defines a color that should be changed to be transparent
          */
-        Bitmap::Palette* DecodePalette(uint8_t* stream, const TGA::TgaHeader* header, int32_t transparentColor)
+        template<typename Input>
+        Bitmap::Palette* DecodePalette(Input& input, const TGA::TgaHeader* header, int32_t transparentColor)
         {
-            uint8_t* buffer = (stream + TGA::ImagePaletteOffset(header));
             Bitmap::Palette* palette = autonew Bitmap::Palette(header->Palette.PaletteLength);
-            uint8_t depth = header->Palette.PaletteColorDepth >> 3;
-            uint8_t* pixelData = buffer;
 
-            for (int32_t index = 0; index < header->Palette.PaletteLength; index++)
+            switch (header->Palette.PaletteColorDepth)
             {
-                if (index != transparentColor)
-                {
-                    SRL::Types::HighColor color = SRL::Types::HighColor();
+            case 15:
+                TGA::DecodePaletteColors<15>(input, palette, transparentColor);
+                break;
 
-                    switch (depth)
-                    {
-                    case 2:
-                        color = SRL::Types::HighColor::FromARGB15(SRL::Endian::DeserializeUint16(pixelData));
-                        break;
-
-                    case 3:
-                        color = SRL::Types::HighColor::FromRGB24(SRL::Endian::DeserializeUint24(pixelData));
-                        break;
-
-                    default:
-                    case 4:
-                        color = TGA::ParseArgb(SRL::Endian::DeserializeUint32(pixelData));
-                        break;
-                    }
+            case 16:
+                TGA::DecodePaletteColors<16>(input, palette, transparentColor);
+                break;
 
-                    palette->Colors[index] = color;
-                }
-                else
-                {
-                    palette->Colors[index] = SRL::Types::HighColor();
-                }
+            case 24:
+                TGA::DecodePaletteColors<24>(input, palette, transparentColor);
+                break;
 
-                pixelData += depth;
+            default:
+                TGA::DecodePaletteColors<32>(input, palette, transparentColor);
+                break;
             }
 
             return palette;
         }
 
-        /** @brief Decode paletted image
-         * @param stream File stream
-         * @param header File header
-         * @param xLoop Range of width loop
-         * @param yLoop Range of height loop
+        /** @brief Get start of the row decoded pixels are written to
+         * @param y Image row
+         * @param bits Number of bits per pixel
+         * @return Byte holding first pixel of the row
          */
-        inline void DecodePaletted(uint8_t* stream, const TGA::TgaHeader* header, ForRange& xLoop, ForRange& yLoop)
+        uint8_t* GetRow(const int32_t y, const uint8_t bits)
         {
-            // Allocated space for image data
-            uint8_t* buffer = (stream + TGA::ImageDataOffset(header));
-            int32_t xLocation = xLoop.Start;
-            int32_t yLocation = yLoop.Start;
-
-            // Read palette data
-            if (header->Palette.PaletteLength <= 16)
+            if (this->target != nullptr)
             {
-                uint32_t pixels = (this->width * this->height) >> 1;
-                this->imageData = autonew uint8_t[pixels];
-
-                // 16 color palette
-                for (uint32_t index = 0; index < pixels; index++)
-                {
-                    uint32_t location = (yLocation * this->width) + xLocation;
-                    xLocation += xLoop.Step;
-                    uint32_t location2 = (yLocation * this->width) + xLocation;
-                    xLocation += xLoop.Step;
-
-                    this->imageData[index] = ((buffer[location] & 0x0f) << 4) | (buffer[location2] & 0x0f);
-
-                    if (xLocation == xLoop.End)
-                    {
-                        xLocation = xLoop.Start;
-                        yLocation += yLoop.Step;
-                    }
-                }
+                return this->target->GetRow(y);
             }
-            else
-            {
-                uint32_t pixels = this->width * this->height;
-                this->imageData = autonew uint8_t[pixels];
-
-                // 256 color palette
-                for (uint32_t index = 0; index < pixels; index++)
-                {
-                    uint32_t location = (yLocation * this->width) + xLocation;
-                    this->imageData[location] = buffer[index];
-                    xLocation += xLoop.Step;
 
-                    if (xLocation == xLoop.End)
-                    {
-                        xLocation = xLoop.Start;
-                        yLocation += yLoop.Step;
-                    }
-                }
-            }
+            return this->imageData + (((y * this->width) * bits) >> 3);
         }
 
-        /** @brief Decode paletted image
-         * @param stream File stream
-         * @param header File header
-         * @param xLoop Range of width loop
-         * @param yLoop Range of height loop
+        /** @brief Decode true color pixels row by row
+         * @details Each combination of color depth, horizontal direction and compression gets its own loop,
+         * rows are filled by moving a pointer, run length packets can continue on the next row and across input chunks.
+         * @tparam Bits Color depth of the pixel
+         * @tparam RightToLeft Pixels of a row are stored from right to left
+         * @tparam Rle Pixels are run length encoded
+         * @tparam Input Input type
+         * @param input Image data positioned at the first pixel
+         * @param transparent Color that should be changed to be transparent
+         * @param firstRow Image row first decoded row is stored to
+         * @param rowStep Direction of rows (1 top to bottom, -1 bottom to top)
          */
-        inline void DecodeRlePaletted(uint8_t* stream, const TGA::TgaHeader* header, ForRange& xLoop, ForRange& yLoop)
+        template<uint8_t Bits, bool RightToLeft, bool Rle, typename Input>
+        void DecodeTrueColorRows(Input& input, const uint16_t transparent, const int32_t firstRow, const int32_t rowStep)
         {
-            // Allocated space for image data
-            size_t size = this->width * this->height;
-            this->imageData = autonew uint8_t[size];
-            uint8_t* buffer = (stream + TGA::ImageDataOffset(header));
-            int32_t xLocation = xLoop.Start;
-            int32_t yLocation = yLoop.Start;
-            size_t fill = 0;
-
-            // Read image data
-            for (uint32_t pixel = 0; pixel < size;)
+            constexpr uint8_t bytes = TGA::GetPixelBytes(Bits);
+            constexpr int32_t step = RightToLeft ? -1 : 1;
+            const int32_t width = this->width;
+            int32_t y = firstRow;
+            int32_t packetLeft = 0;
+            bool repeat = false;
+            uint16_t fill = 0;
+
+            for (size_t line = 0; line < this->height; line++, y += rowStep)
             {
-                TgaRlePacket* packet = (TgaRlePacket*)(buffer++);
+                uint16_t* pixel = reinterpret_cast<uint16_t*>(this->GetRow(y, 16)) + (RightToLeft ? width - 1 : 0);
+                int32_t left = width;
 
-                switch (packet->Type)
+                while (left > 0)
                 {
+                    int32_t count = left;
 
-                // Decompress pixel colors
-                case TgaRlePacket::PacketType::RawPacket:
-                    for (int packed = 0; packed <= packet->Count; packed++)
+                    if constexpr (Rle)
                     {
-                        if (header->Palette.PaletteLength <= 16)
-                        {
-                            xLocation += xLoop.Step;
-                            uint32_t location = (yLocation * this->width) + xLocation;
-                            xLocation += xLoop.Step;
-
-                            // 16 color palette
-                            this->imageData[location >> 1] = ((buffer[0] & 0x0f) << 4) | (buffer[1] & 0x0f);
-                            buffer+=2;
-                        }
-                        else
+                        if (packetLeft == 0)
                         {
-                            uint32_t location = (yLocation * this->width) + xLocation;
-                            xLocation += xLoop.Step;
-
-                            // 256 color palette
-                            this->imageData[location] = *(buffer++);
+                            // Highest bit tells whether packet repeats single pixel, rest is number of pixels - 1
+                            int32_t one = 1;
+                            const uint8_t packet = *input.Fetch(one, 1);
+                            packetLeft = (packet & 0x7f) + 1;
+                            repeat = (packet & 0x80) != 0;
+
+                            if (repeat)
+                            {
+                                fill = TGA::ReadColor<Bits>(input.Fetch(one, bytes), transparent);
+                            }
                         }
 
-                        pixel++;
-
-                        if (xLocation == xLoop.End)
-                        {
-                            xLocation = xLoop.Start;
-                            yLocation += yLoop.Step;
-                        }
+                        count = packetLeft < left ? packetLeft : left;
+                        packetLeft -= count;
                     }
 
-                    break;
+                    left -= count;
 
-                // Repeat the pixel color
-                default:
-                case TgaRlePacket::PacketType::RlePacket:
-                    for (int repeater = 0; repeater <= packet->Count; repeater++)
+                    if (Rle && repeat)
                     {
-                        if (header->Palette.PaletteLength <= 16)
-                        {
-                            xLocation += xLoop.Step;
-                            uint32_t location = (yLocation * this->width) + xLocation;
-                            xLocation += xLoop.Step;
-
-                            // 16 color palette
-                            this->imageData[location >> 1] = ((buffer[0] & 0x0f) << 4) | (buffer[1] & 0x0f);
-                        }
-                        else
+                        for (; count > 0; count--, pixel += step)
                         {
-                            uint32_t location = (yLocation * this->width) + xLocation;
-                            xLocation += xLoop.Step;
-
-                            // 256 color palette
-                            this->imageData[location] = *buffer;
+                            *pixel = fill;
                         }
-
-                        pixel++;
-
-                        if (xLocation == xLoop.End)
+                    }
+                    else
+                    {
+                        while (count > 0)
                         {
-                            xLocation = xLoop.Start;
-                            yLocation += yLoop.Step;
+                            // Input returns as many pixels as it has at hand
+                            int32_t run = count;
+                            const uint8_t* data = input.Fetch(run, bytes);
+                            count -= run;
+
+                            for (; run > 0; run--, pixel += step, data += bytes)
+                            {
+                                *pixel = TGA::ReadColor<Bits>(data, transparent);
+                            }
                         }
                     }
-
-                    // Move to next pixel data
-                    buffer++;
-                    break;
                 }
             }
         }
 
-        /** @brief Decode true color image
-         * @param data Image data
-         * @param header File header
-         * @param xLoop Range of width loop
-         * @param yLoop Range of height loop
-         * @param transparentColor defines a color that should be changed to be transparent
+        /** @brief Decode color indexes row by row
+         * @details Same as DecodeTrueColorRows(), uncompressed rows stored from left to right are copied as they are.
+         * @tparam Packed Two indexes are packed into single byte (16 color palette)
+         * @tparam RightToLeft Pixels of a row are stored from right to left
+         * @tparam Rle Pixels are run length encoded
+         * @tparam Input Input type
+         * @param input Image data positioned at the first pixel
+         * @param firstRow Image row first decoded row is stored to
+         * @param rowStep Direction of rows (1 top to bottom, -1 bottom to top)
          */
-        inline void DecodeTrueColor(uint8_t* stream, const TGA::TgaHeader* header, ForRange& xLoop, ForRange& yLoop, SRL::Types::HighColor transparentColor)
+        template<bool Packed, bool RightToLeft, bool Rle, typename Input>
+        void DecodePalettedRows(Input& input, const int32_t firstRow, const int32_t rowStep)
         {
-            // Allocated space for image data
-            uint32_t size = this->width * this->height;
-            this->imageData = (uint8_t*)autonew SRL::Types::HighColor[size];
-            uint8_t* buffer = (stream + TGA::ImageDataOffset(header));
-            uint8_t depth = header->Image.PixelColorDepth >> 3;
-            int32_t xLocation = xLoop.Start;
-            int32_t yLocation = yLoop.Start;
-
-            // Read image data
-            for (uint32_t index = 0; index < size; index++)
+            constexpr int32_t step = RightToLeft ? -1 : 1;
+            const int32_t width = this->width;
+            int32_t y = firstRow;
+            int32_t packetLeft = 0;
+            bool repeat = false;
+            uint8_t fill = 0;
+
+            for (size_t line = 0; line < this->height; line++, y += rowStep)
             {
-                uint8_t* pixelData = buffer + (depth * index);
-                SRL::Types::HighColor color;
+                uint8_t* row = this->GetRow(y, Packed ? 4 : 8);
 
-                switch (depth)
+                if constexpr (!Packed && !RightToLeft && !Rle)
                 {
-                case 2:
-                    color = SRL::Types::HighColor::FromARGB15(SRL::Endian::DeserializeUint16(pixelData));
-                    break;
-
-                case 3:
-                    color = SRL::Types::HighColor::FromRGB24(SRL::Endian::DeserializeUint24(pixelData));
-                    break;
-
-                default:
-                case 4:
-                    color = TGA::ParseArgb(SRL::Endian::DeserializeUint32(pixelData));
-                    break;
+                    input.Take(row, width);
+                    continue;
                 }
 
-                uint32_t location = (yLocation * this->width) + xLocation;
-                ((SRL::Types::HighColor*)this->imageData)[location] = color != transparentColor ? color : SRL::Types::HighColor();
-
-                xLocation += xLoop.Step;
+                // Packed rows of odd width image in own buffer can start at the low nibble
+                int32_t pixel = (Packed && this->target == nullptr ? (y * width) & 1 : 0) + (RightToLeft ? width - 1 : 0);
+                int32_t left = width;
 
-                if (xLocation == xLoop.End)
+                while (left > 0)
                 {
-                    xLocation = xLoop.Start;
-                    yLocation += yLoop.Step;
-                }
-            }
-        }
+                    int32_t count = left;
 
-        /** @brief Decode true color image with RLE compression
-         * @param data Image data
-         * @param header File header
-         * @param xLoop Range of width loop
-         * @param yLoop Range of height loop
-         * @param transparentColor defines a color that should be changed to be transparent
-         */
-        inline void DecodeTrueColorRle(uint8_t* stream, const TGA::TgaHeader* header, ForRange& xLoop, ForRange& yLoop, SRL::Types::HighColor transparentColor)
-        {
-            // Allocated space for image data
-            uint32_t size = this->width * this->height;
-            this->imageData = (uint8_t*)autonew SRL::Types::HighColor[size];
-            uint8_t* buffer = (stream + TGA::ImageDataOffset(header));
-            uint8_t depth = header->Image.PixelColorDepth >> 3;
-            SRL::Types::HighColor fill;
-            int32_t xLocation = xLoop.Start;
-            int32_t yLocation = yLoop.Start;
-
-            for (uint32_t pixel = 0; pixel < size;)
-            {
-                TgaRlePacket* packet = (TgaRlePacket*)(buffer++);
-
-                switch (packet->Type)
-                {
-                case TgaRlePacket::PacketType::RawPacket:
-                    for (int packed = 0; packed <= packet->Count; packed++)
+                    if constexpr (Rle)
                     {
-                        SRL::Types::HighColor color;
-
-                        // Read pixel
-                        switch (depth)
-                        {
-                        case 2:
-                            color = SRL::Types::HighColor::FromARGB15(SRL::Endian::DeserializeUint16(buffer));
-                            break;
-
-                        case 3:
-                            color = SRL::Types::HighColor::FromRGB24(SRL::Endian::DeserializeUint24(buffer));
-                            break;
-
-                        default:
-                        case 4:
-                            color = TGA::ParseArgb(SRL::Endian::DeserializeUint32(buffer));
-                            break;
-                        }
-
-                        uint32_t location = (yLocation * this->width) + xLocation;
-                        ((SRL::Types::HighColor*)this->imageData)[location] = color != transparentColor ? color : SRL::Types::HighColor();
-
-                        // Move to next pixel data
-                        buffer += depth;
-
-                        xLocation += xLoop.Step;
-
-                        if (xLocation == xLoop.End)
+                        if (packetLeft == 0)
                         {
-                            xLocation = xLoop.Start;
-                            yLocation += yLoop.Step;
+                            // Repeated index follows the packet header
+                            int32_t one = 1;
+                            const uint8_t packet = *input.Fetch(one, 1);
+                            packetLeft = (packet & 0x7f) + 1;
+                            repeat = (packet & 0x80) != 0;
+
+                            if (repeat)
+                            {
+                                fill = *input.Fetch(one, 1);
+                            }
                         }
 
-                        // Move to next pixel
-                        pixel++;
+                        count = packetLeft < left ? packetLeft : left;
+                        packetLeft -= count;
                     }
 
-                    break;
+                    left -= count;
 
-                default:
-                case TgaRlePacket::PacketType::RlePacket:
-                    // Read pixel color
-                    switch (depth)
-                    {
-                    case 2:
-                        fill = SRL::Types::HighColor::FromARGB15(SRL::Endian::DeserializeUint16(buffer));
-                        break;
-
-                    case 3:
-                        fill = SRL::Types::HighColor::FromRGB24(SRL::Endian::DeserializeUint24(buffer));
-                        break;
-
-                    default:
-                    case 4:
-                        fill= TGA::ParseArgb(SRL::Endian::DeserializeUint32(buffer));
-                        break;
-                    }
-
-                    fill = fill != transparentColor ? fill : SRL::Types::HighColor();
-
-                    // Repeat the pixel color
-                    for (int repeater = 0; repeater <= packet->Count; repeater++)
+                    while (count > 0)
                     {
-                        uint32_t location = (yLocation * this->width) + xLocation;
-                        ((SRL::Types::HighColor*)this->imageData)[location] = fill;
-
-                        xLocation += xLoop.Step;
+                        int32_t run = count;
+                        const uint8_t* data = Rle && repeat ? &fill : input.Fetch(run, 1);
+                        const int32_t next = Rle && repeat ? 0 : 1;
+                        count -= run;
 
-                        if (xLocation == xLoop.End)
+                        for (; run > 0; run--, pixel += step, data += next)
                         {
-                            xLocation = xLoop.Start;
-                            yLocation += yLoop.Step;
+                            const uint8_t value = *data;
+
+                            if constexpr (Packed)
+                            {
+                                // Even pixel goes to the high nibble
+                                uint8_t* pair = row + (pixel >> 1);
+                                *pair = (pixel & 1) != 0 ? (*pair & 0xf0) | (value & 0x0f) : (*pair & 0x0f) | (value << 4);
+                            }
+                            else
+                            {
+                                row[pixel] = value;
+                            }
                         }
-
-                        pixel++;
                     }
-
-                    // Move to next pixel data
-                    buffer += depth;
-                    break;
                 }
             }
         }
@@ -679,130 +743,395 @@ namespace SRL::Bitmap
 
     private:
 
-        /** @brief Load image data
-         * @param file Image file
+        /** @brief Pick row decoder for true color image
+         * @tparam Rle Pixels are run length encoded
+         * @tparam Input Input type
+         * @param input Image data positioned at the first pixel
+         * @param bits Color depth of the pixel
+         * @param transparent Color that should be changed to be transparent
+         * @param rightToLeft Pixels of a row are stored from right to left
+         * @param firstRow Image row first decoded row is stored to
+         * @param rowStep Direction of rows
+         */
+        template<bool Rle, typename Input>
+        void DecodeTrueColor(Input& input, const uint8_t bits, const uint16_t transparent, const bool rightToLeft, const int32_t firstRow, const int32_t rowStep)
+        {
+            switch (bits)
+            {
+            case 16:
+                if (rightToLeft) this->DecodeTrueColorRows<16, true, Rle>(input, transparent, firstRow, rowStep);
+                else this->DecodeTrueColorRows<16, false, Rle>(input, transparent, firstRow, rowStep);
+                break;
+
+            case 24:
+                if (rightToLeft) this->DecodeTrueColorRows<24, true, Rle>(input, transparent, firstRow, rowStep);
+                else this->DecodeTrueColorRows<24, false, Rle>(input, transparent, firstRow, rowStep);
+                break;
+
+            default:
+                if (rightToLeft) this->DecodeTrueColorRows<32, true, Rle>(input, transparent, firstRow, rowStep);
+                else this->DecodeTrueColorRows<32, false, Rle>(input, transparent, firstRow, rowStep);
+                break;
+            }
+        }
+
+        /** @brief Pick row decoder for paletted image
+         * @tparam Rle Pixels are run length encoded
+         * @tparam Input Input type
+         * @param input Image data positioned at the first pixel
+         * @param packed Two indexes are packed into single byte (16 color palette)
+         * @param rightToLeft Pixels of a row are stored from right to left
+         * @param firstRow Image row first decoded row is stored to
+         * @param rowStep Direction of rows
+         */
+        template<bool Rle, typename Input>
+        void DecodePaletted(Input& input, const bool packed, const bool rightToLeft, const int32_t firstRow, const int32_t rowStep)
+        {
+            if (packed)
+            {
+                if (rightToLeft) this->DecodePalettedRows<true, true, Rle>(input, firstRow, rowStep);
+                else this->DecodePalettedRows<true, false, Rle>(input, firstRow, rowStep);
+            }
+            else
+            {
+                if (rightToLeft) this->DecodePalettedRows<false, true, Rle>(input, firstRow, rowStep);
+                else this->DecodePalettedRows<false, false, Rle>(input, firstRow, rowStep);
+            }
+        }
+
+        /** @brief Read image header
+         * @param data File data
+         * @param header Parsed header
+         */
+        static void ReadHeader(const uint8_t* data, TGA::TgaHeader* header)
+        {
+            // This is a bit complicated since the header not only is not aligned, but is also little endian
+            header->ImageIdLength = *(data);
+            header->HasPalette = *(data + 1);
+            header->ImageType = *(data + 2);
+            header->Palette.PaletteStart = SRL::Endian::DeserializeUint16(data + 3);
+            header->Palette.PaletteLength = SRL::Endian::DeserializeUint16(data + 5);
+            header->Palette.PaletteColorDepth = *(data + 7);
+            header->Image.Origin.X = SRL::Endian::DeserializeUint16(data + 8);
+            header->Image.Origin.Y = SRL::Endian::DeserializeUint16(data + 10);
+            header->Image.Size.X = SRL::Endian::DeserializeUint16(data + 12);
+            header->Image.Size.Y = SRL::Endian::DeserializeUint16(data + 14);
+            header->Image.PixelColorDepth = *(data + 16);
+            header->Image.Descriptor.Value = *(data + 17);
+        }
+
+        /** @brief Parse header, decode palette and allocate space for image data
+         * @tparam Input Input type
+         * @param input Image data positioned at the start of the file, left at the first pixel
          * @param settings Loader settings
+         * @param header Parsed header
+         * @return true if pixels can be decoded
          */
-        void LoadData(Cd::File* file, LoaderSettings* settings)
+        template<typename Input>
+        bool Prepare(Input& input, LoaderSettings* settings, TGA::TgaHeader* header)
         {
-            uint8_t* stream = autonew uint8_t[file->Size.Bytes + 1];
-            int32_t read = file->LoadBytes(0, file->Size.Bytes, stream);
+            uint8_t data[TGA::HeaderSize];
 
-            // Open file
-            if (read == file->Size.Bytes)
+            if (!input.Take(data, TGA::HeaderSize))
             {
-                // Load file
-                uint8_t* data = stream;
+                SRL::Debug::Assert("File size does not match!.");
+                return false;
+            }
 
-                // Load header, this is a bit complicated since the header not only is not aligned, but is also little endian
-                TgaHeader header;
-                header.ImageIdLength = *(data);
-                header.HasPalette = *(data + 1);
-                header.ImageType = *(data + 2);
-                header.Palette.PaletteStart = SRL::Endian::DeserializeUint16(data + 3);
-                header.Palette.PaletteLength = SRL::Endian::DeserializeUint16(data + 5);
-                header.Palette.PaletteColorDepth = *(data + 7);
-                header.Image.Origin.X = SRL::Endian::DeserializeUint16(data + 8);
-                header.Image.Origin.Y = SRL::Endian::DeserializeUint16(data + 10);
-                header.Image.Size.X = SRL::Endian::DeserializeUint16(data + 12);
-                header.Image.Size.Y = SRL::Endian::DeserializeUint16(data + 14);
-                header.Image.PixelColorDepth = *(data + 16);
-                header.Image.Descriptor.Value = *(data + 17);
-
-                // Lets check whether the header makes sense
-                if (header.Image.Size.X == 0 || header.Image.Size.Y == 0)
+            TGA::ReadHeader(data, header);
+
+            // Lets check whether the header makes sense
+            if (header->Image.Size.X == 0 || header->Image.Size.Y == 0)
+            {
+                // Image has no size or is too big
+                SRL::Debug::Assert("Image has no size or is too big!\nWidth=%d\nHeight=%d", header->Image.Size.X, header->Image.Size.Y);
+                return false;
+            }
+
+            // Check format
+            if (!TGA::IsFormatValid(header))
+            {
+                // We do not know how to read this type
+                SRL::Debug::Assert("Image is of unsupported type!");
+                return false;
+            }
+
+            // Set TGA object stuff
+            this->width = (size_t)header->Image.Size.X;
+            this->height = (size_t)header->Image.Size.Y;
+
+            // Image identifier is not used
+            input.Skip(static_cast<uint8_t>(header->ImageIdLength));
+
+            // Allocate space for image data, decoders only fill it
+            switch (static_cast<TgaTypes>(header->ImageType))
+            {
+            case TGA::TgaTypes::TgaPaletted:
+            case TGA::TgaTypes::TgaRlePaletted:
+                this->palette = this->DecodePalette(input, header, settings->TransparentColorIndex);
+
+                if (this->target == nullptr)
                 {
-                    // Image has no size or is too big
-                    SRL::Debug::Assert("Image has no size or is too big!\nWidth=%d\nHeight=%d", header.Image.Size.X, header.Image.Size.Y);
+                    this->imageData = autonew uint8_t[header->Palette.PaletteLength <= 16 ? ((this->width * this->height) + 1) >> 1 : this->width * this->height];
                 }
 
-                // Check format
-                if (!TGA::IsFormatValid(&header))
+                break;
+
+            case TGA::TgaTypes::TgaTrueColor:
+            case TGA::TgaTypes::TgaRleTrueColor:
+                input.Skip(static_cast<uint16_t>(header->Palette.PaletteLength) * TGA::GetPixelBytes(header->Palette.PaletteColorDepth));
+
+                if (this->target == nullptr)
                 {
-                    // We do not know how to read this type
-                    SRL::Debug::Assert("Image is of unsupported type!");
+                    this->imageData = (uint8_t*)autonew SRL::Types::HighColor[this->width * this->height];
                 }
 
-                // Set TGA object stuff
-                this->width = (size_t)header.Image.Size.X;
-                this->height = (size_t)header.Image.Size.Y;
-
-                // Pixel read order
-                uint8_t origin = header.Image.Descriptor.Data.Origin;
-                ForRange xLoop = { 0, 0, 0 };
-                ForRange yLoop = { 0, 0, 0 };
-
-                if (origin == TgaOrigin::TopLeft || origin == TgaOrigin::TopRight) {
-                    yLoop.Start = 0; // start bottom, step upward
-                    yLoop.Step = 1;
-                    yLoop.End = this->height;
-                } else {
-                    yLoop.Start = this->height - 1; // start at top, step downward
-                    yLoop.Step = -1;
-                    yLoop.End = -1;
-                }
+                break;
 
-                if (origin == TgaOrigin::TopLeft || origin == TgaOrigin::BottomLeft) {
-                    xLoop.Start = 0;
-                    xLoop.Step = 1;
-                    xLoop.End = this->width;
-                } else {
-                    xLoop.Start = this->width - 1;
-                    xLoop.Step = -1;
-                    xLoop.End = -1;
-                }
+            default:
+                SRL::Debug::Assert("Image is of unsupported type '%d'!\nCould not decode the image.", header->ImageType);
+                return false;
+            }
 
-                // Data stream should now be pointing to after the header
-                switch (static_cast<TgaTypes>(header.ImageType))
-                {
-                case TGA::TgaTypes::TgaPaletted:
-                    this->palette = this->DecodePalette(stream, &header, settings->TransparentColorIndex);
-                    this->DecodePaletted(stream, &header, xLoop, yLoop);
-                    break;
+            // Target can refuse the image (e.g. there is no space left for it)
+            return this->target == nullptr || this->target->Begin(this->GetInfo());
+        }
 
-                case TGA::TgaTypes::TgaRlePaletted:
-                    this->palette = this->DecodePalette(stream, &header, settings->TransparentColorIndex);
-                    this->DecodeRlePaletted(stream, &header, xLoop, yLoop);
-                    break;
+        /** @brief Decode pixels into image data allocated by Prepare()
+         * @note Does not allocate any memory, so it can run on slave CPU while master uses the heap
+         * @tparam Input Input type
+         * @param input Image data positioned at the first pixel
+         * @param header Parsed header
+         * @param settings Loader settings
+         */
+        template<typename Input>
+        void DecodePixels(Input& input, const TGA::TgaHeader* header, LoaderSettings* settings)
+        {
+            // Bit 4 of descriptor is set when rows are stored from right to left, bit 5 when rows are stored from top to bottom
+            const uint8_t origin = (header->Image.Descriptor.Value >> 4) & 0x03;
+            const bool rightToLeft = origin == TgaOrigin::BottomRight || origin == TgaOrigin::TopRight;
+            const int32_t firstRow = origin == TgaOrigin::TopLeft || origin == TgaOrigin::TopRight ? 0 : this->height - 1;
+            const int32_t rowStep = firstRow == 0 ? 1 : -1;
+            const bool packed = header->Palette.PaletteLength <= 16;
+            const uint16_t transparent = settings->TransparentColor;
 
-                case TGA::TgaTypes::TgaTrueColor:
-                    this->DecodeTrueColor(stream, &header, xLoop, yLoop, settings->TransparentColor);
-                    break;
+            switch (static_cast<TgaTypes>(header->ImageType))
+            {
+            case TGA::TgaTypes::TgaPaletted:
+                this->DecodePaletted<false>(input, packed, rightToLeft, firstRow, rowStep);
+                break;
 
-                case TGA::TgaTypes::TgaRleTrueColor:
-                    this->DecodeTrueColorRle(stream, &header, xLoop, yLoop, settings->TransparentColor);
-                    break;
+            case TGA::TgaTypes::TgaRlePaletted:
+                this->DecodePaletted<true>(input, packed, rightToLeft, firstRow, rowStep);
+                break;
 
-                default:
-                    SRL::Debug::Assert("Image is of unsupported type '%d'!\nCould not decode the image.", header.ImageType);
-                    break;
+            case TGA::TgaTypes::TgaTrueColor:
+                this->DecodeTrueColor<false>(input, header->Image.PixelColorDepth, transparent, rightToLeft, firstRow, rowStep);
+                break;
+
+            case TGA::TgaTypes::TgaRleTrueColor:
+                this->DecodeTrueColor<true>(input, header->Image.PixelColorDepth, transparent, rightToLeft, firstRow, rowStep);
+                break;
+
+            default:
+                break;
+            }
+
+            if (this->target != nullptr)
+            {
+                this->target->End();
+            }
+        }
+
+        /** @brief Load image data
+         * @details File is decoded while it is being read, only small read window is allocated next to the image data.
+         * @note File is left in the same open state it was in
+         * @param file Image file
+         * @param settings Loader settings
+         */
+        void LoadData(Cd::File* file, LoaderSettings* settings)
+        {
+            const bool wasOpen = file->IsOpen();
+
+            if (file->Open() && file->Seek(0) == 0)
+            {
+                StreamInput<Cd::File> input = { file, file->Size.Bytes, new uint8_t[TGA::MaxPixelBytes + TGA::StreamChunkSize], nullptr, nullptr, false };
+                input.current = input.end = input.buffer + TGA::MaxPixelBytes;
+
+                TgaHeader header;
+
+                if (this->Prepare(input, settings, &header))
+                {
+                    this->DecodePixels(input, &header, settings);
+
+                    if (input.exhausted)
+                    {
+                        SRL::Debug::Assert("File size does not match!.");
+                    }
                 }
+
+                delete[] input.buffer;
             }
             else
             {
-                SRL::Debug::Assert("File size does not match!.");
+                SRL::Debug::Assert("File could not be opened!");
             }
 
-            // Clear allocated memory
-            delete stream;
+            if (!wasOpen)
+            {
+                file->Close();
+            }
         }
 
     public:
 
+        /** @brief Decodes pixels of an image on slave CPU
+         * @details Image constructed from memory with a task has only its header and palette processed, pixels are decoded once the task runs.
+         * Task does not allocate any memory, so master can keep on using the heap while slave decodes.
+         * @code {.cpp}
+         * SRL::Bitmap::TGA::DecodeTask task;
+         * SRL::Bitmap::TGA* image = new SRL::Bitmap::TGA(data, size, SRL::Bitmap::TGA::LoaderSettings(), &task);
+         * SRL::Slave::ExecuteOnSlave(task);
+         *
+         * // Do something else
+         *
+         * while (!task.IsDone());
+         * @endcode
+         * @note File data must stay valid until the task is done
+         */
+        class DecodeTask : public Types::ITask
+        {
+        private:
+            /** @brief Image sets up the task
+             */
+            friend struct TGA;
+
+            /** @brief Image to decode, nullptr if image is not valid
+             */
+            TGA* image;
+
+            /** @brief File data positioned at the first pixel
+             */
+            MemoryInput input;
+
+            /** @brief Parsed header
+             */
+            TgaHeader header;
+
+            /** @brief Loader settings
+             */
+            LoaderSettings settings;
+
+            /** @brief Whole image was decoded
+             */
+            volatile bool decoded;
+
+        protected:
+            /** @brief Decode image pixels
+             */
+            void Do() override
+            {
+                // File data were written by CD or DMA behind cache of this CPU, buffer address could have been cached before
+                slCashPurge();
+
+                if (this->image != nullptr)
+                {
+                    this->image->DecodePixels(this->input, &this->header, &this->settings);
+                    this->decoded = !this->input.exhausted;
+                }
+            }
+
+        public:
+            /** @brief Construct a new decode task
+             */
+            DecodeTask() : image(nullptr), input({ nullptr, nullptr, false }), decoded(false)
+            {
+            }
+
+            /** @brief Get result of the decoding
+             * @return true if task is done and image was decoded, false if image is not valid or file data ended before all pixels were decoded
+             */
+            bool GetResult()
+            {
+                return this->IsDone() && this->decoded;
+            }
+        };
+
         /** @brief Construct RGB555 TGA image from file
+         * @details File is decoded while it is being read, it is never loaded into memory as a whole
+         * @param data TGA file
+         * @param settings TGA loader settings
+         */
+        TGA(Cd::File* data, TGA::LoaderSettings settings = TGA::LoaderSettings()) : TGA(data, nullptr, settings)
+        {
+            // Do nothing
+        }
+
+        /** @brief Construct TGA image from file and decode its pixels straight into a target
+         * @details Image keeps only its palette, GetData() returns nullptr when target is used.
+         * @code {.cpp}
+         * SRL::VDP1::TextureTarget texture(paletteHandler);
+         * SRL::Bitmap::TGA image(&file, &texture);
+         *
+         * if (texture.GetId() >= 0)
+         * {
+         *      // Texture is ready in VDP1 VRAM
+         * }
+         * @endcode
          * @param data TGA file
+         * @param target Where to decode pixels to, nullptr to decode them into image data
          * @param settings TGA loader settings
          */
-        TGA(Cd::File* data, TGA::LoaderSettings settings = TGA::LoaderSettings()) : imageData(nullptr), palette(nullptr)
+        TGA(Cd::File* data, Bitmap::IDecodeTarget* target, TGA::LoaderSettings settings = TGA::LoaderSettings()) : imageData(nullptr), target(target), palette(nullptr)
         {
             this->LoadData(data, &settings);
         }
 
+        /** @brief Construct TGA image from file data in memory
+         * @param stream Whole TGA file
+         * @param size Size of the file data in bytes
+         * @param settings TGA loader settings
+         * @param task When set, pixels are not decoded right away but by the task (see TGA::DecodeTask)
+         * @param target Where to decode pixels to, nullptr to decode them into image data
+         */
+        TGA(uint8_t* stream, int32_t size, TGA::LoaderSettings settings = TGA::LoaderSettings(), DecodeTask* task = nullptr, Bitmap::IDecodeTarget* target = nullptr) :
+            imageData(nullptr),
+            target(target),
+            palette(nullptr)
+        {
+            MemoryInput input = { stream, stream + size, false };
+            TgaHeader header;
+            const bool prepared = stream != nullptr && this->Prepare(input, &settings, &header);
+
+            if (task != nullptr)
+            {
+                task->image = prepared ? this : nullptr;
+                task->decoded = false;
+                task->input = input;
+                task->header = header;
+                task->settings = settings;
+            }
+            else if (prepared)
+            {
+                this->DecodePixels(input, &header, &settings);
+            }
+        }
+
         /** @brief Construct RGB555 TGA image from file
          * @param filename TGA file name
          * @param settings TGA loader settings
          */
-        TGA(const char* filename, TGA::LoaderSettings settings = TGA::LoaderSettings()) : imageData(nullptr), palette(nullptr)
+        TGA(const char* filename, TGA::LoaderSettings settings = TGA::LoaderSettings()) : TGA(filename, nullptr, settings)
+        {
+            // Do nothing
+        }
+
+        /** @brief Construct TGA image from file and decode its pixels straight into a target
+         * @param filename TGA file name
+         * @param target Where to decode pixels to, nullptr to decode them into image data
+         * @param settings TGA loader settings
+         */
+        TGA(const char* filename, Bitmap::IDecodeTarget* target, TGA::LoaderSettings settings = TGA::LoaderSettings()) : imageData(nullptr), target(target), palette(nullptr)
         {
             Cd::File file = Cd::File(filename);
 
@@ -2,6 +2,7 @@
 
 #include "srl_tilemap.hpp"
 #include "srl_cd.hpp"
+#include "srl_lz.hpp"
 #include "srl_bitmap.hpp"
 
 namespace SRL::Tilemap::Interfaces
@@ -480,10 +481,12 @@ namespace SRL::Tilemap::Interfaces
          */
         void LoadData(SRL::Cd::File* file)
         {
-            uint8_t* stream = new uint8_t[file->Size.Bytes + 1];
-            int32_t read = file->LoadBytes(0, file->Size.Bytes, stream);
+            const int32_t compressedSize = Lz::GetSize(file);
+            const int32_t size = compressedSize >= 0 ? compressedSize : file->Size.Bytes;
+            uint8_t* stream = new uint8_t[size + 1];
+            int32_t read = compressedSize >= 0 ? Lz::Load(file, stream, size) : file->LoadBytes(0, size, stream);
 
-            if (read == file->Size.Bytes)
+            if (read == size)
             {
                 // Load file
                 uint8_t* imageData = (uint8_t*)(stream + 32);
@@ -699,4 +702,207 @@ namespace SRL::Tilemap::Interfaces
             return this->info;
         }
     };
+
+    /** @brief Decode target writing image rows straight into VDP2 cells
+     * @details Rows are gathered in a band of one character row (8 or 16 pixel lines), once band is complete it is split into cells written directly to VRAM.
+     * Cells are stored in the same order as Bmp2Tile stores them, but none are removed, so map of the image is just a sequence of its characters.
+     * Only the band is allocated, there is no buffer of the whole image nor a copy of the whole tileset.
+     * @code {.cpp}
+     * SRL::Tilemap::Interfaces::CellTarget cells(SRL::VDP2::VRAM::Allocate(0x8000, 32, SRL::VDP2::VramBank::A1), 0x8000);
+     * SRL::Bitmap::TGA image("TILES.TGA", &cells);
+     * @endcode
+     * @note Image width and height must be multiple of character size, paletted images with 64 or 128 colors are stored as 256 color cells
+     */
+    struct CellTarget : public SRL::Bitmap::IDecodeTarget
+    {
+    private:
+        /** @brief Where cells are written to
+         */
+        uint8_t* cellAddress;
+
+        /** @brief Size of the cell area in bytes
+         */
+        int32_t size;
+
+        /** @brief Character size (CHAR_SIZE_1x1 or CHAR_SIZE_2x2)
+         */
+        uint16_t charSize;
+
+        /** @brief Rows of one character row of the image
+         */
+        uint8_t* band;
+
+        /** @brief Index of the band being filled, -1 if none
+         */
+        int32_t current;
+
+        /** @brief Number of bytes single image row takes
+         */
+        int32_t rowBytes;
+
+        /** @brief Number of bytes single cell line takes (8 pixels)
+         */
+        int32_t cellRowBytes;
+
+        /** @brief Number of cells written
+         */
+        int32_t cellCount;
+
+        /** @brief Get number of pixel lines in a band
+         * @return 8 for 8x8 characters, 16 for 16x16 characters
+         */
+        int32_t GetBandHeight() const
+        {
+            return this->charSize == CHAR_SIZE_1x1 ? 8 : 16;
+        }
+
+        /** @brief Split complete band into cells and write them to VRAM
+         */
+        void Flush()
+        {
+            const int32_t bandHeight = this->GetBandHeight();
+            const int32_t charCells = bandHeight >> 3;
+            const int32_t rowWords = this->rowBytes >> 2;
+            const int32_t cellWords = this->cellRowBytes >> 2;
+            uint32_t* cell = reinterpret_cast<uint32_t*>(this->cellAddress + (this->current * this->rowBytes * bandHeight));
+
+            // Cells of 16x16 character go top left, top right, bottom left, bottom right
+            for (int32_t column = 0; column < this->rowBytes; column += this->cellRowBytes * charCells)
+            {
+                for (int32_t cellY = 0; cellY < bandHeight; cellY += 8)
+                {
+                    for (int32_t cellX = 0; cellX < charCells; cellX++)
+                    {
+                        const uint32_t* line = reinterpret_cast<const uint32_t*>(this->band + (cellY * this->rowBytes) + column + (cellX * this->cellRowBytes));
+
+                        for (int32_t y = 0; y < 8; y++, line += rowWords)
+                        {
+                            for (int32_t word = 0; word < cellWords; word++)
+                            {
+                                *cell++ = line[word];
+                            }
+                        }
+
+                        this->cellCount++;
+                    }
+                }
+            }
+        }
+
+    public:
+        /** @brief Construct a new cell target
+         * @param cellAddress Cell area in VDP2 VRAM (e.g. from VDP2::VRAM::Allocate())
+         * @param size Size of the cell area in bytes
+         * @param charSize Character size (CHAR_SIZE_1x1 or CHAR_SIZE_2x2)
+         */
+        CellTarget(void* cellAddress, int32_t size, uint16_t charSize = CHAR_SIZE_1x1) :
+            cellAddress(reinterpret_cast<uint8_t*>(cellAddress)),
+            size(size),
+            charSize(charSize),
+            band(nullptr),
+            current(-1),
+            rowBytes(0),
+            cellRowBytes(0),
+            cellCount(0)
+        {
+            // Do nothing
+        }
+
+        /** @brief Free band buffer and destroy the cell target
+         */
+        ~CellTarget()
+        {
+            delete[] this->band;
+        }
+
+        /** @brief Check image fits the cell area and allocate band buffer
+         * @param info Decoded image info
+         * @return false if image dimensions are not supported or image does not fit
+         */
+        bool Begin(SRL::Bitmap::BitmapInfo info) override
+        {
+            const int32_t bandHeight = this->GetBandHeight();
+
+            // Number of bytes 8 pixels take is same as number of bits per pixel
+            switch (info.ColorMode)
+            {
+            case CRAM::TextureColorMode::Paletted16:
+                this->cellRowBytes = 4;
+                break;
+
+            case CRAM::TextureColorMode::RGB555:
+                this->cellRowBytes = 16;
+                break;
+
+            default:
+                this->cellRowBytes = 8;
+                break;
+            }
+
+            this->rowBytes = (info.Width >> 3) * this->cellRowBytes;
+            this->current = -1;
+            this->cellCount = 0;
+
+            if ((info.Width % bandHeight) != 0 ||
+                (info.Height % bandHeight) != 0 ||
+                this->rowBytes * info.Height > this->size)
+            {
+                SRL::Debug::Assert("Cell conversion failed- Image Dimensions Not supported");
+                return false;
+            }
+
+            delete[] this->band;
+            this->band = new uint8_t[this->rowBytes * bandHeight];
+            return this->band != nullptr;
+        }
+
+        /** @brief Get row in band buffer, band is written to VRAM once rows of another band are requested
+         * @param y Image row
+         * @return Start of the row
+         */
+        uint8_t* GetRow(uint16_t y) override
+        {
+            const int32_t bandHeight = this->GetBandHeight();
+            const int32_t index = y / bandHeight;
+
+            if (index != this->current)
+            {
+                if (this->current >= 0)
+                {
+                    this->Flush();
+                }
+
+                this->current = index;
+            }
+
+            return this->band + ((y % bandHeight) * this->rowBytes);
+        }
+
+        /** @brief Write last band to VRAM
+         */
+        void End() override
+        {
+            if (this->current >= 0)
+            {
+                this->Flush();
+                this->current = -1;
+            }
+        }
+
+        /** @brief Get number of written cells
+         * @return Number of 8x8 cells
+         */
+        int32_t GetCellCount() const
+        {
+            return this->cellCount;
+        }
+
+        /** @brief Get number of bytes written cells take
+         * @return Size of cell data in bytes
+         */
+        int32_t GetCellByteSize() const
+        {
+            return this->cellCount * (this->cellRowBytes << 3);
+        }
+    };
 }
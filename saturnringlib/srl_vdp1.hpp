@@ -12,9 +12,116 @@ namespace SRL
     {
     private:
 
-        /** @brief Pointer to the last free space in the heap
+        /** @brief Free block of texture VRAM
          */
-        inline static uint16_t HeapPointer = 0;
+        struct FreeBlock
+        {
+            /** @brief Start of the block (in 8 byte units, same as Texture::Address)
+             */
+            uint16_t Address;
+
+            /** @brief Size of the block (in 8 byte units), 0 if entry is not in use
+             */
+            uint16_t Size;
+
+            /** @brief Previous block in the same free list, -1 if this is the first one
+             */
+            int16_t Previous;
+
+            /** @brief Next block in the same free list, -1 if this is the last one
+             */
+            int16_t Next;
+        };
+
+        /** @brief Number of free lists
+         * @details List N holds blocks of 2^N to 2^(N+1)-1 AdjCG steps (32 bytes), user area has less than 2^14 of them.
+         */
+        inline static const uint8_t FreeListCount = 14;
+
+        /** @brief Free blocks, each free block lies between two allocated textures so there can never be more of them than textures plus one
+         */
+        inline static FreeBlock FreeBlocks[SRL_MAX_TEXTURES + 1];
+
+        /** @brief First block of each free list, -1 if list is empty
+         */
+        inline static int16_t FreeLists[VDP1::FreeListCount];
+
+        /** @brief Size of VRAM taken by each texture (in 8 byte units), 0 if texture slot is free
+         */
+        inline static uint16_t AllocatedSizes[SRL_MAX_TEXTURES] = { 0 };
+
+        /** @brief Number of allocated textures
+         */
+        inline static uint16_t TextureCount = 0;
+
+        /** @brief Free lists were set up
+         */
+        inline static bool IsHeapReady = false;
+
+        /** @brief Get free list blocks of given size belong to
+         * @param size Block size (in 8 byte units)
+         * @return Index of the free list
+         */
+        inline static uint8_t GetFreeListIndex(const uint16_t size)
+        {
+            uint8_t index = 0;
+
+            for (uint16_t steps = size >> 2; steps > 1 && index < VDP1::FreeListCount - 1; steps >>= 1)
+            {
+                index++;
+            }
+
+            return index;
+        }
+
+        /** @brief Put block into free list matching its size
+         * @param block Index of the block
+         */
+        inline static void LinkFreeBlock(const int16_t block)
+        {
+            const uint8_t list = VDP1::GetFreeListIndex(VDP1::FreeBlocks[block].Size);
+            VDP1::FreeBlocks[block].Previous = -1;
+            VDP1::FreeBlocks[block].Next = VDP1::FreeLists[list];
+
+            if (VDP1::FreeLists[list] >= 0)
+            {
+                VDP1::FreeBlocks[VDP1::FreeLists[list]].Previous = block;
+            }
+
+            VDP1::FreeLists[list] = block;
+        }
+
+        /** @brief Remove block from its free list
+         * @param block Index of the block
+         */
+        inline static void UnlinkFreeBlock(const int16_t block)
+        {
+            const FreeBlock& entry = VDP1::FreeBlocks[block];
+
+            if (entry.Previous >= 0)
+            {
+                VDP1::FreeBlocks[entry.Previous].Next = entry.Next;
+            }
+            else
+            {
+                VDP1::FreeLists[VDP1::GetFreeListIndex(entry.Size)] = entry.Next;
+            }
+
+            if (entry.Next >= 0)
+            {
+                VDP1::FreeBlocks[entry.Next].Previous = entry.Previous;
+            }
+        }
+
+        /** @brief Set up free lists if it was not done yet
+         */
+        inline static void PrepareHeap()
+        {
+            if (!VDP1::IsHeapReady)
+            {
+                VDP1::ResetTextureHeap();
+            }
+        }
 
         /** @brief Get the number of bits to shift to the right
          * @param colorMode Color mode
@@ -139,17 +246,40 @@ namespace SRL
         inline static TextureMetadata Metadata[SRL_MAX_TEXTURES] = { TextureMetadata() };
 
         /** @brief Get free available memory left for textures on VDP1
-         * @return Number of bytes left 
+         * @details Free memory can be split into several blocks by textures around them, texture larger than the largest block cannot be allocated
+         * even if there is enough free memory in total.
+         * @param largestBlock Receives size of the largest continuous free block in bytes (optional)
+         * @return Number of bytes left
          */
-        inline static size_t GetAvailableMemory()
+        inline static size_t GetAvailableMemory(size_t* largestBlock = nullptr)
         {
-            if (VDP1::HeapPointer == 0)
+            VDP1::PrepareHeap();
+            size_t available = 0;
+            uint16_t largest = 0;
+
+            for (const FreeBlock& block : VDP1::FreeBlocks)
+            {
+                available += block.Size;
+                largest = block.Size > largest ? block.Size : largest;
+            }
+
+            if (largestBlock != nullptr)
             {
-                return VDP1::UserAreaEnd - (SpriteVRAM + (CGADDRESS << 3));
+                *largestBlock = largest << 3;
             }
 
-            VDP1::Texture current = VDP1::Textures[VDP1::HeapPointer - 1];
-            return VDP1::UserAreaEnd - (SpriteVRAM + AdjCG(current.Address << 3, current.Width, current.Height, VDP1::GetSizeShifter(VDP1::Metadata[VDP1::HeapPointer - 1].ColorMode)));
+            return available << 3;
+        }
+
+        /** @brief Get size of texture data
+         * @param width Texture width
+         * @param height Texture height
+         * @param colorMode Color mode
+         * @return Number of bytes texture data take in VRAM
+         */
+        inline static size_t GetTextureDataSize(const uint16_t width, const uint16_t height, const CRAM::TextureColorMode colorMode)
+        {
+            return (uint32_t)(((width * height) << 2) >> VDP1::GetSizeShifter(colorMode));
         }
 
         /** @brief Get the start location of the gouraud table
@@ -161,6 +291,8 @@ namespace SRL
         }
 
         /** @brief Try to allocate a texture
+         * @details Texture gets the lowest free index, which stays valid until the texture is freed by FreeTexture().
+         * VRAM is taken from the smallest free list that has a large enough block, best fitting block of that list is used.
          * @param width Texture width
          * @param height Texture height
          * @param colorMode Color mode
@@ -169,35 +301,106 @@ namespace SRL
          */
         inline static int32_t TryAllocateTexture(const uint16_t width, const uint16_t height, const CRAM::TextureColorMode colorMode, const uint16_t palette)
         {
-            if (VDP1::HeapPointer < SRL_MAX_TEXTURES)
+            VDP1::PrepareHeap();
+
+            if (VDP1::TextureCount >= SRL_MAX_TEXTURES)
+            {
+                // There is no free texture slot left
+                return -1;
+            }
+
+            // Texture takes whole AdjCG steps, even empty one so it has an address of its own
+            const uint32_t bytes = AdjCG(0, width, height, VDP1::GetSizeShifter(colorMode));
+            const uint16_t size = bytes > 0 ? bytes >> 3 : 4;
+            int16_t found = -1;
+
+            for (uint8_t list = VDP1::GetFreeListIndex(size); found < 0 && list < VDP1::FreeListCount; list++)
             {
-                uint32_t address = CGADDRESS;
-                
-                // If more than one exist, move CG to next address from previous
-                if (VDP1::HeapPointer > 0)
+                for (int16_t block = VDP1::FreeLists[list]; block >= 0; block = VDP1::FreeBlocks[block].Next)
                 {
-                    const VDP1::Texture previous = VDP1::Textures[VDP1::HeapPointer - 1];
-                    address = AdjCG(previous.Address << 3, previous.Width, previous.Height, VDP1::GetSizeShifter(VDP1::Metadata[VDP1::HeapPointer - 1].ColorMode));
+                    const uint16_t blockSize = VDP1::FreeBlocks[block].Size;
+
+                    if (blockSize >= size && (found < 0 || blockSize < VDP1::FreeBlocks[found].Size))
+                    {
+                        found = block;
+                    }
                 }
-    
-                const VDP1::Texture newTexture = VDP1::Texture(width, height, address >> 3);
-                const uint32_t nextAddr = AdjCG(newTexture.Address << 3, newTexture.Width, newTexture.Height, VDP1::GetSizeShifter(colorMode));
-                
-                if (VDP1::HeapPointer < SRL_MAX_TEXTURES && SpriteVRAM + nextAddr < VDP1::UserAreaEnd)
+            }
+
+            if (found < 0)
+            {
+                // There is no free space left
+                return -1;
+            }
+
+            int32_t id = 0;
+
+            while (VDP1::AllocatedSizes[id] != 0)
+            {
+                id++;
+            }
+
+            // Texture takes start of the block, rest of the block stays free
+            FreeBlock& block = VDP1::FreeBlocks[found];
+            VDP1::UnlinkFreeBlock(found);
+            VDP1::Textures[id] = VDP1::Texture(width, height, block.Address);
+            VDP1::Metadata[id] = VDP1::TextureMetadata(colorMode, palette);
+            VDP1::AllocatedSizes[id] = size;
+            VDP1::TextureCount++;
+
+            block.Address += size;
+            block.Size -= size;
+
+            if (block.Size > 0)
+            {
+                VDP1::LinkFreeBlock(found);
+            }
+
+            return id;
+        }
+
+        /** @brief Free texture
+         * @details Texture memory is merged with free blocks around it, indexes of other textures do not change.
+         * @param id Index of the texture
+         */
+        inline static void FreeTexture(const int32_t id)
+        {
+            if (id < 0 || id >= SRL_MAX_TEXTURES || VDP1::AllocatedSizes[id] == 0)
+            {
+                return;
+            }
+
+            uint16_t address = VDP1::Textures[id].Address;
+            uint16_t size = VDP1::AllocatedSizes[id];
+            int16_t unused = -1;
+
+            VDP1::AllocatedSizes[id] = 0;
+            VDP1::Textures[id] = VDP1::Texture();
+            VDP1::Metadata[id] = VDP1::TextureMetadata();
+            VDP1::TextureCount--;
+
+            // Merge with free blocks right before and right after the texture
+            for (int16_t block = 0; block <= SRL_MAX_TEXTURES; block++)
+            {
+                FreeBlock& entry = VDP1::FreeBlocks[block];
+
+                if (entry.Size == 0)
+                {
+                    unused = unused < 0 ? block : unused;
+                }
+                else if (entry.Address + entry.Size == address || address + size == entry.Address)
                 {
-                    // Create texture entry
-                    VDP1::Textures[VDP1::HeapPointer] = newTexture;
-    
-                    // Create metadata entry 
-                    VDP1::Metadata[VDP1::HeapPointer] = VDP1::TextureMetadata(colorMode, palette);
-    
-                    // Increase heap pointer
-                    return VDP1::HeapPointer++;
+                    VDP1::UnlinkFreeBlock(block);
+                    address = entry.Address < address ? entry.Address : address;
+                    size += entry.Size;
+                    entry.Size = 0;
+                    unused = unused < 0 ? block : unused;
                 }
             }
 
-            // There is no free space left
-            return -1;
+            VDP1::FreeBlocks[unused].Address = address;
+            VDP1::FreeBlocks[unused].Size = size;
+            VDP1::LinkFreeBlock(unused);
         }
 
         /** @brief Try to load a texture
@@ -210,7 +413,7 @@ namespace SRL
          */
         inline static int32_t TryLoadTexture(const uint16_t width, const uint16_t height, const CRAM::TextureColorMode colorMode, const uint16_t palette, void* data)
         {
-            const size_t dataSize = (uint32_t)(((width * height) << 2) >> VDP1::GetSizeShifter(colorMode));
+            const size_t dataSize = VDP1::GetTextureDataSize(width, height, colorMode);
             const int32_t id = VDP1::TryAllocateTexture(width, height, colorMode, palette);
 
             if (id >= 0)
@@ -232,7 +435,7 @@ namespace SRL
          */
         inline static int32_t TryLoadTexture(SRL::Bitmap::IBitmap* bitmap, int16_t (*paletteHandler)(SRL::Bitmap::BitmapInfo*) = nullptr)
         {
-            if (VDP1::HeapPointer < SRL_MAX_TEXTURES)
+            if (VDP1::TextureCount < SRL_MAX_TEXTURES)
             {
                 int16_t palette = 0;
                 SRL::Bitmap::BitmapInfo info = bitmap->GetInfo();
@@ -269,7 +472,7 @@ namespace SRL
          */
         inline static int32_t TryLoadTexture(SRL::Bitmap::IBitmap* bitmap, const int16_t& palette)
         {
-            if (VDP1::HeapPointer < SRL_MAX_TEXTURES)
+            if (VDP1::TextureCount < SRL_MAX_TEXTURES)
             {
                 SRL::Bitmap::BitmapInfo info = bitmap->GetInfo();
                 return VDP1::TryLoadTexture(info.Width, info.Height, (CRAM::TextureColorMode)info.ColorMode, palette, bitmap->GetData());
@@ -279,27 +482,140 @@ namespace SRL
             return -1;
         }
 
+        /** @brief Decode target writing image rows straight into newly allocated texture
+         * @details Texture is allocated once image size and palette are known, there is no intermediate buffer nor copy.
+         * @code {.cpp}
+         * SRL::VDP1::TextureTarget texture(paletteHandler);
+         * SRL::Bitmap::TGA image("SPRITE.TGA", &texture);
+         * int32_t id = texture.GetId();
+         * @endcode
+         */
+        class TextureTarget : public SRL::Bitmap::IDecodeTarget
+        {
+        private:
+            /** @brief Palette loader handling (only needed for loading paletted image)
+             */
+            int16_t (*paletteHandler)(SRL::Bitmap::BitmapInfo*);
+
+            /** @brief Palette number used when there is no palette handler
+             */
+            int16_t palette;
+
+            /** @brief Index of the allocated texture
+             */
+            int32_t id;
+
+            /** @brief Number of bytes single texture row takes
+             */
+            size_t rowBytes;
+
+        public:
+            /** @brief Construct a new texture target
+             * @param paletteHandler Palette loader handling (expects index of the palette in CRAM as result, only needed for loading paletted image)
+             */
+            TextureTarget(int16_t (*paletteHandler)(SRL::Bitmap::BitmapInfo*) = nullptr) : paletteHandler(paletteHandler), palette(-1), id(-1), rowBytes(0)
+            {
+                // Do nothing
+            }
+
+            /** @brief Construct a new texture target
+             * @param palette Color palette number
+             */
+            TextureTarget(const int16_t& palette) : paletteHandler(nullptr), palette(palette), id(-1), rowBytes(0)
+            {
+                // Do nothing
+            }
+
+            /** @brief Allocate texture for the image
+             * @param info Decoded image info
+             * @return false if there is no space left or palette could not be loaded
+             */
+            bool Begin(SRL::Bitmap::BitmapInfo info) override
+            {
+                int16_t palette = 0;
+                this->id = -1;
+
+                if (info.Palette != nullptr)
+                {
+                    palette = this->paletteHandler != nullptr ? this->paletteHandler(&info) : this->palette;
+
+                    if (palette < 0)
+                    {
+                        // Palette loader not specified or it failed
+                        return false;
+                    }
+                }
+
+                this->id = VDP1::TryAllocateTexture(info.Width, info.Height, info.ColorMode, palette);
+                this->rowBytes = VDP1::GetTextureDataSize(info.Width, 1, info.ColorMode);
+                return this->id >= 0;
+            }
+
+            /** @brief Get row of the texture
+             * @param y Texture row
+             * @return Start of the row in VRAM
+             */
+            uint8_t* GetRow(uint16_t y) override
+            {
+                return reinterpret_cast<uint8_t*>(VDP1::Textures[this->id].GetData()) + (y * this->rowBytes);
+            }
+
+            /** @brief Get index of the texture
+             * @return Index of the texture, -1 if no texture was allocated
+             */
+            int32_t GetId() const
+            {
+                return this->id;
+            }
+        };
+
         /** @brief Get the number of currently loaded textures
-         *  @return Number of currently loaded textures
+         * @note As long as no texture was freed, textures have indexes from 0 to count - 1
+         * @return Number of currently loaded textures
          */
         inline static uint16_t GetTextureCount()
         {
-            return VDP1::HeapPointer;
+            return VDP1::TextureCount;
         }
 
         /** @brief Fully reset texture heap
          */
         inline static void ResetTextureHeap()
         {
-            VDP1::HeapPointer = 0;
+            for (int32_t id = 0; id < SRL_MAX_TEXTURES; id++)
+            {
+                VDP1::AllocatedSizes[id] = 0;
+                VDP1::Textures[id] = VDP1::Texture();
+                VDP1::Metadata[id] = VDP1::TextureMetadata();
+            }
+
+            for (FreeBlock& block : VDP1::FreeBlocks)
+            {
+                block.Size = 0;
+            }
+
+            for (int16_t& list : VDP1::FreeLists)
+            {
+                list = -1;
+            }
+
+            // Whole texture area is one free block, its end is aligned down to AdjCG step
+            VDP1::FreeBlocks[0].Address = CGADDRESS >> 3;
+            VDP1::FreeBlocks[0].Size = (((VDP1::UserAreaEnd - SpriteVRAM) & ~0x1f) - CGADDRESS) >> 3;
+            VDP1::LinkFreeBlock(0);
+            VDP1::TextureCount = 0;
+            VDP1::IsHeapReady = true;
         }
-        
-        /** @brief Reset texture heap to specified index
-         * @param index Index to reset to (texture on this index will be overwritten on next TryLoadTexture(); call)
+
+        /** @brief Free all textures from specified index up
+         * @param index First index to free (it will be reused by next TryLoadTexture(); call)
          */
         inline static void ResetTextureHeap(const uint16_t index)
         {
-            VDP1::HeapPointer = VDP1::HeapPointer > index ? index : VDP1::HeapPointer;
+            for (int32_t id = index; id < SRL_MAX_TEXTURES; id++)
+            {
+                VDP1::FreeTexture(id);
+            }
         }
     };
 }
@@ -675,10 +675,7 @@ namespace SRL
             */
             inline static void Cell2VRAM(uint8_t* cellData, void* cellAdr, uint32_t size)
             {
-                uint8_t* VRAM = (uint8_t*)cellAdr;
-
-                // Note: Consider DMA
-                for (uint32_t i = 0; i < size; i++) *(VRAM++) = *(cellData++);
+                SRL::Memory::Dma::Wait(SRL::Memory::Dma::Copy(cellAdr, cellData, size, SRL::Memory::Dma::Channel::Scu));
             }
 
             /** @brief Copies map data to VRAM and applies necessary offsets (adapted from SGL Samples).
@@ -0,0 +1,176 @@
+import struct
+import argparse
+
+# Must match SRL::Lz
+MAGIC = b'SRLZ'
+HEADER_FORMAT = '>4sII'
+MIN_MATCH = 4
+MAX_OFFSET = 0xffff
+LAST_LITERALS = 5   # LZ4 block rules, last bytes are always literals
+MATCH_LIMIT = 12    # No match can start this close to the end
+HASH_BITS = 16
+
+def encode_length(output, length):
+    while length >= 255:
+        output.append(255)
+        length -= 255
+    output.append(length)
+
+def write_sequence(output, literals, offset, match_length):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+
+    if match_length is not None:
+        token |= min(match_length - MIN_MATCH, 15)
+
+    output.append(token)
+
+    if literal_length >= 15:
+        encode_length(output, literal_length - 15)
+
+    output.extend(literals)
+
+    if match_length is not None:
+        output.extend(struct.pack('<H', offset))
+
+        if match_length - MIN_MATCH >= 15:
+            encode_length(output, match_length - MIN_MATCH - 15)
+
+def compress_block(data, depth):
+    size = len(data)
+    output = bytearray()
+    head = {}
+    chain = [-1] * size
+    anchor = 0
+    position = 0
+    match_end_limit = size - LAST_LITERALS
+
+    def insert(index):
+        key = data[index:index + MIN_MATCH]
+        chain[index] = head.get(key, -1)
+        head[key] = index
+
+    while position < size - MATCH_LIMIT:
+        best_length = 0
+        best_offset = 0
+        candidate = head.get(data[position:position + MIN_MATCH], -1)
+        tries = depth
+
+        # Walk hash chain looking for the longest match
+        while candidate >= 0 and position - candidate <= MAX_OFFSET and tries > 0:
+            length = 0
+            limit = match_end_limit - position
+
+            while length < limit and data[candidate + length] == data[position + length]:
+                length += 1
+
+            if length > best_length:
+                best_length = length
+                best_offset = position - candidate
+
+                if length == limit:
+                    break
+
+            candidate = chain[candidate]
+            tries -= 1
+
+        if best_length >= MIN_MATCH:
+            write_sequence(output, data[anchor:position], best_offset, best_length)
+
+            for index in range(position, min(position + best_length, size - MIN_MATCH + 1)):
+                insert(index)
+
+            position += best_length
+            anchor = position
+        else:
+            insert(position)
+            position += 1
+
+    write_sequence(output, data[anchor:], 0, None)
+    return bytes(output)
+
+def decompress_block(block, size):
+    output = bytearray()
+    position = 0
+
+    while len(output) < size:
+        token = block[position]
+        position += 1
+        length = token >> 4
+
+        if length == 15:
+            while True:
+                value = block[position]
+                position += 1
+                length += value
+                if value != 255:
+                    break
+
+        output.extend(block[position:position + length])
+        position += length
+
+        if len(output) >= size:
+            break
+
+        offset = block[position] | (block[position + 1] << 8)
+        position += 2
+        length = (token & 15)
+
+        if length == 15:
+            while True:
+                value = block[position]
+                position += 1
+                length += value
+                if value != 255:
+                    break
+
+        length += MIN_MATCH
+
+        if offset == 0 or offset > len(output):
+            raise ValueError('Corrupted data')
+
+        for _ in range(length):
+            output.append(output[-offset])
+
+    return bytes(output)
+
+def compress(data, depth):
+    block = compress_block(data, depth)
+    return struct.pack(HEADER_FORMAT, MAGIC, len(data), len(block)) + block
+
+def decompress(data):
+    magic, size, compressed_size = struct.unpack_from(HEADER_FORMAT, data, 0)
+
+    if magic != MAGIC:
+        raise ValueError('Not an SRL compressed file')
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    return decompress_block(data[header_size:header_size + compressed_size], size)
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress files for SRL::Lz')
+    parser.add_argument('input', help='File to process')
+    parser.add_argument('output', help='Output file')
+    parser.add_argument('-d', '--decompress', action='store_true', help='Decompress instead of compress')
+    parser.add_argument('--depth', type=int, default=64, help='Number of match candidates to try, higher is slower but compresses better')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as file:
+        data = file.read()
+
+    if args.decompress:
+        result = decompress(data)
+    else:
+        result = compress(data, max(args.depth, 1))
+
+        # Never produce a file that does not decompress back to the input
+        if decompress(result) != data:
+            raise RuntimeError('Compression verification failed')
+
+        print(f"{args.input}: {len(data)} -> {len(result)} bytes")
+
+    with open(args.output, 'wb') as file:
+        file.write(result)
+
+if __name__ == "__main__":
+    main()
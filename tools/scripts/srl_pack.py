@@ -0,0 +1,133 @@
+import os
+import struct
+import argparse
+
+# Must match SRL::Cd::Archive
+MAGIC = b'SRLA'
+VERSION = 1
+SECTOR_SIZE = 2048
+HEADER_FORMAT = '>4sHHII'
+ENTRY_FORMAT = '>III20s'
+MAX_NAME_LENGTH = 19
+MAX_ENTRIES = 0xffff
+
+def hash_name(name):
+    # 32-bit FNV-1a of upper case name, same as SRL::Cd::HashName
+    value = 2166136261
+    for character in name.upper().encode('ascii'):
+        value ^= character
+        value = (value * 16777619) & 0xffffffff
+    return value
+
+def align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+def collect_files(inputs):
+    files = []
+    for path in inputs:
+        if os.path.isdir(path):
+            for name in sorted(os.listdir(path)):
+                full_path = os.path.join(path, name)
+                if os.path.isfile(full_path):
+                    files.append(full_path)
+        else:
+            files.append(path)
+    return files
+
+def pack(output, inputs, alignment):
+    entries = []
+    names = set()
+
+    for path in collect_files(inputs):
+        name = os.path.basename(path).upper()
+
+        if len(name) > MAX_NAME_LENGTH:
+            raise ValueError(f"Asset name '{name}' is longer than {MAX_NAME_LENGTH} characters")
+        if name in names:
+            raise ValueError(f"Asset name '{name}' is used more than once")
+
+        names.add(name)
+
+        with open(path, 'rb') as file:
+            entries.append((name, file.read()))
+
+    if len(entries) > MAX_ENTRIES:
+        raise ValueError(f"Archive can hold at most {MAX_ENTRIES} assets")
+
+    # Table of contents is padded to whole sectors so asset data starts on a sector boundary
+    data_offset = align(struct.calcsize(HEADER_FORMAT) + len(entries) * struct.calcsize(ENTRY_FORMAT), SECTOR_SIZE)
+
+    toc = bytearray()
+    data = bytearray()
+
+    for name, content in entries:
+        data.extend(b'\0' * (align(len(data), alignment) - len(data)))
+        toc.extend(struct.pack(ENTRY_FORMAT, hash_name(name), len(data), len(content), name.encode('ascii')))
+        data.extend(content)
+
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(entries), data_offset, len(data))
+    archive = bytearray(header + toc)
+    archive.extend(b'\0' * (data_offset - len(archive)))
+    archive.extend(data)
+    archive.extend(b'\0' * (align(len(archive), SECTOR_SIZE) - len(archive)))
+
+    with open(output, 'wb') as file:
+        file.write(archive)
+
+    return entries
+
+def write_header(path, archive_name, entries):
+    identifier = os.path.splitext(os.path.basename(archive_name))[0].upper()
+
+    with open(path, 'w') as file:
+        file.write('#pragma once\n\n')
+        file.write(f'// Generated by srl_pack.py from {os.path.basename(archive_name)}, do not edit\n')
+        file.write(f'enum class {identifier.capitalize()}Assets : uint16_t\n{{\n')
+
+        for index, (name, _) in enumerate(entries):
+            symbol = ''.join(c if c.isalnum() else '_' for c in name)
+            file.write(f'    {symbol} = {index},\n')
+
+        file.write('};\n')
+
+def list_archive(path):
+    with open(path, 'rb') as file:
+        content = file.read()
+
+    magic, version, count, data_offset, data_size = struct.unpack_from(HEADER_FORMAT, content, 0)
+
+    if magic != MAGIC or version != VERSION:
+        raise ValueError(f"'{path}' is not a version {VERSION} SRL archive")
+
+    print(f"{count} assets, data at {data_offset}, {data_size} bytes")
+
+    for index in range(count):
+        offset = struct.calcsize(HEADER_FORMAT) + index * struct.calcsize(ENTRY_FORMAT)
+        _, start, size, name = struct.unpack_from(ENTRY_FORMAT, content, offset)
+        name = name.rstrip(b'\0').decode('ascii')
+        print(f"{index:5} {name:20} {start:10} {size:10}")
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack assets into SRL::Cd::Archive file')
+    parser.add_argument('output', help='Archive to create (or to list with --list)')
+    parser.add_argument('inputs', nargs='*', help='Files or directories to pack, assets keep the order given here')
+    parser.add_argument('--align', type=int, default=4, help='Alignment of each asset in bytes (use 2048 to start every asset on a sector)')
+    parser.add_argument('--header', help='Also write C++ header with enum of asset indices')
+    parser.add_argument('--list', action='store_true', help='Print content of an existing archive')
+    args = parser.parse_args()
+
+    if args.list:
+        list_archive(args.output)
+        return
+
+    if args.align < 1:
+        parser.error('--align must be positive')
+
+    entries = pack(args.output, args.inputs, args.align)
+    print(f"Packed {len(entries)} assets into {args.output}")
+
+    if args.header:
+        write_header(args.header, args.output, entries)
+
+if __name__ == "__main__":
+    main()
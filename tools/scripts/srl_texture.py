@@ -0,0 +1,232 @@
+import os
+import sys
+import struct
+import argparse
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import srl_lz
+
+# Must match SRL::Bitmap::SRT
+MAGIC = b'SRLT'
+VERSION = 1
+HEADER_FORMAT = '>4sHHHHHHI'
+COMPRESSED_FLAG = 0x0001
+
+# Must match SRL::CRAM::TextureColorMode
+MODES = {
+    'rgb555': 1,
+    '16': 2,
+    '64': 4,
+    '128': 5,
+    '256': 6
+}
+
+TGA_HEADER_FORMAT = '<BBBHHBHHHHBB'
+
+def convert_color(data, bits):
+    # Same conversion as SRL::Bitmap::TGA::ReadColor, result is ABGR555 with bit 15 set for opaque colors
+    if bits <= 16:
+        value = data[0] | (data[1] << 8)
+
+        if bits == 16 and (value & 0x8000) == 0:
+            return 0
+
+        return 0x8000 | ((value & 0x001f) << 10) | (value & 0x03e0) | ((value >> 10) & 0x001f)
+
+    if bits == 32 and data[3] < 128 and (data[0] | data[1] | data[2]) == 0:
+        return 0
+
+    return 0x8000 | ((data[0] & 0xf8) << 7) | ((data[1] & 0xf8) << 2) | (data[2] >> 3)
+
+def read_tga(path):
+    with open(path, 'rb') as file:
+        content = file.read()
+
+    id_length, palette_type, image_type, _, palette_length, palette_bits, _, _, width, height, bits, descriptor = struct.unpack_from(TGA_HEADER_FORMAT, content, 0)
+    offset = struct.calcsize(TGA_HEADER_FORMAT) + id_length
+
+    if image_type not in (1, 2, 9, 10):
+        raise ValueError(f"'{path}' has unsupported TGA image type {image_type}")
+
+    paletted = image_type in (1, 9)
+    pixel_bytes = (bits + 7) // 8
+    palette = None
+
+    if paletted:
+        if palette_type != 1 or bits != 8 or palette_bits not in (15, 16, 24, 32):
+            raise ValueError(f"'{path}' has unsupported TGA palette")
+
+        entry_bytes = (palette_bits + 7) // 8
+        palette = [convert_color(content[offset + index * entry_bytes:], palette_bits) for index in range(palette_length)]
+        offset += palette_length * entry_bytes
+    elif bits not in (15, 16, 24, 32):
+        raise ValueError(f"'{path}' has unsupported TGA color depth {bits}")
+    elif palette_type == 1:
+        # Palette of truecolor image is not used
+        offset += palette_length * ((palette_bits + 7) // 8)
+
+    pixels = []
+    count = width * height
+
+    if image_type in (9, 10):
+        while len(pixels) < count:
+            packet = content[offset]
+            length = (packet & 0x7f) + 1
+            offset += 1
+
+            if packet & 0x80:
+                pixels.extend([content[offset:offset + pixel_bytes]] * length)
+                offset += pixel_bytes
+            else:
+                pixels.extend(content[offset + index * pixel_bytes:offset + (index + 1) * pixel_bytes] for index in range(length))
+                offset += length * pixel_bytes
+
+        del pixels[count:]
+    else:
+        pixels = [content[offset + index * pixel_bytes:offset + (index + 1) * pixel_bytes] for index in range(count)]
+
+    if len(pixels) < count or len(pixels[-1]) < pixel_bytes:
+        raise ValueError(f"'{path}' is truncated")
+
+    if paletted:
+        pixels = [pixel[0] for pixel in pixels]
+    else:
+        pixels = [convert_color(pixel, bits) for pixel in pixels]
+
+    # Rows are stored top to bottom, left to right
+    rows = [pixels[row * width:(row + 1) * width] for row in range(height)]
+
+    if (descriptor & 0x10) != 0:
+        rows = [list(reversed(row)) for row in rows]
+
+    if (descriptor & 0x20) == 0:
+        rows.reverse()
+
+    return width, height, rows, palette
+
+def pick_mode(palette):
+    # Same choice as SRL::Bitmap::BitmapInfo
+    if palette is None:
+        return MODES['rgb555']
+    if len(palette) <= 16:
+        return MODES['16']
+    if len(palette) <= 64:
+        return MODES['64']
+    if len(palette) <= 128:
+        return MODES['128']
+    return MODES['256']
+
+def convert(path, mode_name, transparent_index, transparent_color, compress, depth):
+    width, height, rows, palette = read_tga(path)
+
+    if mode_name == 'auto':
+        mode = pick_mode(palette)
+    else:
+        mode = MODES[mode_name]
+
+    if mode != MODES['rgb555']:
+        if palette is None:
+            raise ValueError(f"'{path}' is a truecolor image, it can only be converted to rgb555")
+
+        colors = { 2: 16, 4: 64, 5: 128, 6: 256 }[mode]
+
+        if max(max(row) for row in rows) >= colors:
+            raise ValueError(f"'{path}' uses color indexes that do not fit {colors} color texture")
+
+        palette = palette[:colors]
+
+        if transparent_index is not None and transparent_index < len(palette):
+            palette[transparent_index] = 0
+
+        if transparent_color is not None:
+            palette = [0 if color == transparent_color else color for color in palette]
+    else:
+        if palette is not None:
+            rows = [[palette[index] if index != transparent_index and index < len(palette) else 0 for index in row] for row in rows]
+            palette = None
+
+        if transparent_color is not None:
+            rows = [[0 if color == transparent_color else color for color in row] for row in rows]
+
+    # VDP1 needs texture width to be multiple of 8, padding is transparent
+    stored_width = (width + 7) & ~7
+    rows = [row + [0] * (stored_width - width) for row in rows]
+
+    data = bytearray()
+
+    for row in rows:
+        if mode == MODES['rgb555']:
+            data += struct.pack(f'>{stored_width}H', *row)
+        elif mode == MODES['16']:
+            data += bytes((row[index] << 4) | row[index + 1] for index in range(0, stored_width, 2))
+        else:
+            data += bytes(row)
+
+    flags = 0
+
+    if compress:
+        packed = srl_lz.compress(bytes(data), depth)
+
+        # Never produce a file that does not decompress back to the pixels
+        if srl_lz.decompress(packed) != data:
+            raise RuntimeError('Compression verification failed')
+
+        data = packed
+        flags |= COMPRESSED_FLAG
+
+    palette = palette or []
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, stored_width, height, mode, len(palette), flags, len(data))
+
+    # Palette is in color RAM format and padded so pixel data stay aligned to 4 bytes
+    palette_data = struct.pack(f'>{len(palette)}H', *palette)
+    palette_data += bytes(-len(palette_data) % 4)
+
+    return header + palette_data + data
+
+def list_texture(path):
+    with open(path, 'rb') as file:
+        content = file.read()
+
+    magic, version, width, height, mode, palette_count, flags, data_size = struct.unpack_from(HEADER_FORMAT, content, 0)
+
+    if magic != MAGIC or version != VERSION:
+        raise ValueError(f"'{path}' is not a version {VERSION} SRL texture")
+
+    mode_name = next(name for name, value in MODES.items() if value == mode)
+    compressed = 'compressed' if flags & COMPRESSED_FLAG else 'uncompressed'
+    print(f"{width}x{height}, mode {mode_name}, {palette_count} colors, {data_size} bytes {compressed}")
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert TGA image into SRL::Bitmap::SRT native texture')
+    parser.add_argument('input', help='TGA image to convert (or texture to list with --list)')
+    parser.add_argument('output', nargs='?', help='Texture file to create')
+    parser.add_argument('--mode', choices=['auto'] + list(MODES.keys()), default='auto', help='Texture color mode, auto picks it from palette size of the image')
+    parser.add_argument('--transparent-index', type=int, help='Palette index that becomes transparent')
+    parser.add_argument('--transparent', help='Color (RRGGBB) that becomes transparent')
+    parser.add_argument('--compress', action='store_true', help='Compress pixel data with SRL::Lz')
+    parser.add_argument('--depth', type=int, default=64, help='Number of match candidates to try when compressing')
+    parser.add_argument('--list', action='store_true', help='Print header of an existing texture')
+    args = parser.parse_args()
+
+    if args.list:
+        list_texture(args.input)
+        return
+
+    if args.output is None:
+        parser.error('output is required')
+
+    transparent = None
+
+    if args.transparent is not None:
+        rgb = int(args.transparent, 16)
+        transparent = convert_color(bytes((rgb & 0xff, (rgb >> 8) & 0xff, (rgb >> 16) & 0xff)), 24)
+
+    result = convert(args.input, args.mode, args.transparent_index, transparent, args.compress, max(args.depth, 1))
+
+    with open(args.output, 'wb') as file:
+        file.write(result)
+
+    print(f"{args.input} -> {args.output}: {len(result)} bytes")
+
+if __name__ == "__main__":
+    main()